@@ -35,12 +35,16 @@
 #include <vector>
 
 // BOOST INCLUDES
+#include <boost/bind/bind.hpp>
 #include <boost/numeric/conversion/converter.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/shared_ptr.hpp>
 
 // SPARE INCLUDES
 #include <spare/BoundedParameter.hpp>
+#include <spare/Clustering/RepIndex/LinearScan.hpp>
+#include <spare/Executor.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
 #include <spare/SwitchParameter.hpp>
@@ -48,8 +52,8 @@
 namespace spare {  // Inclusion in namespace spare.
 
 // Data for switch parameter construction.
-static const std::string BSAS_SCVAL[]= {"Basic", "Modified"};
-static const size_t      BSAS_SCVAL_SZ= 2;
+static const std::string BSAS_SCVAL[]= {"Basic", "Modified", "ModifiedParallel"};
+static const size_t      BSAS_SCVAL_SZ= 3;
 
 /** @brief %Bsas clustering algorithm.
  *
@@ -64,6 +68,17 @@ static const size_t      BSAS_SCVAL_SZ= 2;
  * empty representative which can be edited by the user with the aim of customising the
  * behavior of the cluster models in some way, for example setting some dissimilarity measure
  * parameters.
+ * In the @a Modified scheme, the first pass creates the representatives and the second one
+ * assigns the remaining samples, in sample order, to their closest representative, which is
+ * updated before the next sample is considered. The @a ModifiedParallel scheme performs the
+ * closest representative search of the second pass in parallel over the samples, against the
+ * representatives frozen at the end of the first pass; the Update calls are then applied in
+ * sample order, as in the @a Modified scheme. The search runs on an Executor, which can be
+ * shared with other components through the ExecutorSetup method. The Diss method of the
+ * selected Representative class must be safe for concurrent calls when this scheme is used.
+ * The optional RepIndex template argument is a class modeling the @a RepresentativeIndex
+ * concept (see LinearScan and PivotTable), used for the closest representative search; it is
+ * kept up to date as the representatives are created and updated.
  *
  * <b>Parameter summary</b>
  *  <table class="contents">
@@ -76,7 +91,7 @@ static const size_t      BSAS_SCVAL_SZ= 2;
  *  </tr>
  *  <tr>
  *     <td class="indexvalue">Scheme</td>
- *     <td class="indexvalue">{Basic, Modified}</td>
+ *     <td class="indexvalue">{Basic, Modified, ModifiedParallel}</td>
  *     <td class="indexvalue">Choice of the algoithm variant to use.</td>
  *     <td class="indexvalue">No</td>
  *     <td class="indexvalue">Modified</td>
@@ -97,7 +112,7 @@ static const size_t      BSAS_SCVAL_SZ= 2;
  *  </tr>
  *  </table>  
  */
-template <typename Representative>
+template <typename Representative, typename RepIndex= LinearScan<Representative> >
 class Bsas
 {
 public:
@@ -174,7 +189,8 @@ public:
                                                          ModifiedClusterAnalysis(
                                                            iSampleBegin,
                                                            iSampleEnd,
-                                                           iLabelBegin);
+                                                           iLabelBegin,
+                                                           mScheme == "ModifiedParallel");
                                                       }
                                                    }
 
@@ -229,6 +245,46 @@ public:
    const Representative&
                         RepInit() const            { return mRepInit; }
 
+   /** Read/write access to the representative index.
+    *
+    * @return A reference to the instance.
+    */
+   RepIndex&            Index()                    { return mIndex; }
+
+   /** Read only access to the representative index.
+    *
+    * @return A const reference to the instance.
+    */
+   const RepIndex&      Index() const              { return mIndex; }
+
+   /** Setup of the executor used by the @a ModifiedParallel scheme.
+    *
+    * The same executor can be shared among several components, bounding the overall number
+    * of threads.
+    *
+    * @param[in] pExecutor Shared pointer to the executor.
+    */
+   void                 ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor)
+                                                   { mExecutor= pExecutor; }
+
+   /** Read access to the executor used by the @a ModifiedParallel scheme.
+    *
+    * If no executor has been set up, a private one with one thread per hardware thread is
+    * created.
+    *
+    * @return A shared pointer to the executor.
+    */
+   const boost::shared_ptr<Executor>&
+                        GetExecutor() const
+                           {
+                              if (!mExecutor)
+                              {
+                                 mExecutor.reset( new Executor );
+                              }
+
+                              return mExecutor;
+                           }
+
    /** Read access to the container holding the defined output labels.
     *
     * The container holds the valid labels defined during the last call of the Process
@@ -252,18 +308,6 @@ public:
 private:
 
    // Typedef privati.
-   typedef typename RepVector::const_iterator
-                        RepresentativeIterator;
-
-   typedef std::iterator_traits<std::vector<RealType>::iterator>::difference_type
-                        RealDiffType;
-
-   typedef std::vector<RealType>::size_type
-                        DissSizeType;
-
-   typedef std::vector<RealType>::iterator
-                        DissIterator;
-
    typedef typename LabelVector::size_type
                         LabelVectorSizeType;
 
@@ -285,6 +329,9 @@ private:
    // Lista etichette rappresentanti.
    LabelVector          mLabels;
 
+   // Indice per la ricerca del rappresentante più vicino.
+   RepIndex             mIndex;
+
    // Cluster analysis con schema di base.
    template <typename ForwardIterator1, typename ForwardIterator2>
    void                 BasicClusterAnalysis(
@@ -292,12 +339,21 @@ private:
                            ForwardIterator1  iSampleEnd,
                            ForwardIterator2  iLabelBegin);
 
-   // Cluster analysis con schema modificato.
+   // Cluster analysis con schema modificato (seconda passata eventualmente parallela).
    template <typename ForwardIterator1, typename ForwardIterator2>
    void                 ModifiedClusterAnalysis(
                            ForwardIterator1  iSampleBegin,
                            ForwardIterator1  iSampleEnd,
-                           ForwardIterator2  iLabelBegin);
+                           ForwardIterator2  iLabelBegin,
+                           bool              aParallel);
+
+   // Ricerca del rappresentante più vicino per i campioni [aFirst, aLast) in attesa.
+   template <typename ForwardIterator1>
+   void                 ClosestRange(
+                           const std::vector<ForwardIterator1>*   pPending,
+                           LabelVector*                           pClosest,
+                           Executor::SizeType                     aFirst,
+                           Executor::SizeType                     aLast) const;
 
    // Funzione ausiliaria.
    void                 AlgoInit();
@@ -316,19 +372,12 @@ private:
    // Numero max etichette (= Q).
    LabelVectorSizeType  Q__;
 
-   // Iteratore rappresentanti.
-   RepresentativeIterator
-                        RepIt;
-
-   // Iteratore dissimilarità.
-   DissIterator         MinIt;
-
    // Minima dissimilarità.
    RealType             MinDiss;
 
-   // Vettore dissimilarità.
-   std::vector<RealType>
-                        RepDiss;
+   // Executor per la seconda passata parallela.
+   mutable boost::shared_ptr<Executor>
+                        mExecutor;
 
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
@@ -352,10 +401,10 @@ private:
 
 //==================================== OPERATIONS ==========================================
 
-template <typename Representative>
+template <typename Representative, typename RepIndex>
 template <typename ForwardIterator1, typename ForwardIterator2>
 void
-Bsas<Representative>::BasicClusterAnalysis(
+Bsas<Representative, RepIndex>::BasicClusterAnalysis(
                          ForwardIterator1  iSampleBegin,
                          ForwardIterator1  iSampleEnd,
                          ForwardIterator2  iLabelBegin)
@@ -388,25 +437,12 @@ Bsas<Representative>::BasicClusterAnalysis(
    (*Ot++)= mLabels.back();
    mRepresentatives.push_back( mRepInit );
    mRepresentatives.back().Update( *It++ );
+   mIndex.Insert(mRepresentatives, mRepresentatives.size() - 1);
 
    // Ciclo principale.
    while (iSampleEnd != It)
    {
-      RepDiss.clear();
-      RepIt= mRepresentatives.begin();
-
-      while (mRepresentatives.end() != RepIt)
-      {
-         RepDiss.push_back( (*RepIt++).Diss(*It) );
-      }
-
-      MinIt= std::min_element(
-                RepDiss.begin(),
-                RepDiss.end() );
-
-      MinDiss= *MinIt;
-      ClosestRep= boost::numeric::converter<LabelType, RealDiffType>
-                  ::convert( std::distance(RepDiss.begin(), MinIt) );
+      ClosestRep= mIndex.Closest(mRepresentatives, *It, MinDiss);
 
       //new representative
       if ( (MinDiss > mTheta) && (mRepresentatives.size() < Q_) )
@@ -415,25 +451,31 @@ Bsas<Representative>::BasicClusterAnalysis(
          (*Ot++)= mLabels.back();
          mRepresentatives.push_back( mRepInit );
          mRepresentatives.back().Update( *It );
+         mIndex.Insert(mRepresentatives, mRepresentatives.size() - 1);
       }
       else
       {
          (*Ot++)= ClosestRep;
          mRepresentatives[ClosestRep].Update(*It);
+         mIndex.Refresh(mRepresentatives, ClosestRep);
       }
 
       It++;
    } // ciclo principale
 }  // BasicClusterAnalysis
 
-template <typename Representative>
+template <typename Representative, typename RepIndex>
 template <typename ForwardIterator1, typename ForwardIterator2>
 void
-Bsas<Representative>::ModifiedClusterAnalysis(
+Bsas<Representative, RepIndex>::ModifiedClusterAnalysis(
                          ForwardIterator1  iSampleBegin,
                          ForwardIterator1  iSampleEnd,
-                         ForwardIterator2  iLabelBegin)
+                         ForwardIterator2  iLabelBegin,
+                         bool              aParallel)
 {
+   using boost::placeholders::_1;
+   using boost::placeholders::_2;
+
    // Typedef locali.
    typedef typename std::iterator_traits<ForwardIterator1>::difference_type
                         SampleDiffType;
@@ -462,25 +504,12 @@ Bsas<Representative>::ModifiedClusterAnalysis(
    (*Ot++)= mLabels.back();
    mRepresentatives.push_back( mRepInit );
    mRepresentatives.back().Update( *It++ );
+   mIndex.Insert(mRepresentatives, mRepresentatives.size() - 1);
 
    // Prima passata.
    while (iSampleEnd != It)
    {
-      RepDiss.clear();
-      RepIt= mRepresentatives.begin();
-
-      while (mRepresentatives.end() != RepIt)
-      {
-         RepDiss.push_back( (*RepIt++).Diss(*It) );
-      }
-
-      MinIt= std::min_element(
-                RepDiss.begin(),
-                RepDiss.end() );
-
-      MinDiss= *MinIt;
-      ClosestRep= boost::numeric::converter<LabelType, RealDiffType>
-                  ::convert( std::distance(RepDiss.begin(), MinIt) );
+      ClosestRep= mIndex.Closest(mRepresentatives, *It, MinDiss);
 
       //new representative
       if ( (MinDiss > mTheta) && (mRepresentatives.size() < Q_) )
@@ -489,6 +518,7 @@ Bsas<Representative>::ModifiedClusterAnalysis(
          (*Ot++)= mLabels.back();
          mRepresentatives.push_back( mRepInit );
          mRepresentatives.back().Update( *It );
+         mIndex.Insert(mRepresentatives, mRepresentatives.size() - 1);
       }
       else
       {
@@ -504,29 +534,58 @@ Bsas<Representative>::ModifiedClusterAnalysis(
    It= iSampleBegin;
    Ot= iLabelBegin;
 
-   // Seconda passata.
-   while (iSampleEnd != It)
+   // Seconda passata parallela: ricerca sui rappresentanti congelati, aggiornamenti in ordine.
+   if (aParallel)
    {
-      if (*Ot == Q_) // Non ancora assegnato.
+      std::vector<ForwardIterator1>    Pending;
+      LabelVector                      Closest;
+
+      while (iSampleEnd != It)
       {
-         RepDiss.clear();
-         RepIt= mRepresentatives.begin();
+         if (*Ot++ == Q_) // Non ancora assegnato.
+         {
+            Pending.push_back(It);
+         }
+         It++;
+      }
 
-         while (mRepresentatives.end() != RepIt)
+      Closest.resize( Pending.size() );
+      GetExecutor()->ParallelFor(
+                        0,
+                        Pending.size(),
+                        0,
+                        boost::bind(&Bsas::ClosestRange<ForwardIterator1>,
+                                    this, &Pending, &Closest, _1, _2) );
+
+      It= iSampleBegin;
+      Ot= iLabelBegin;
+      typename LabelVector::const_iterator Cit= Closest.begin();
+      while (iSampleEnd != It)
+      {
+         if (*Ot == Q_)
          {
-            RepDiss.push_back( (*RepIt++).Diss(*It) );
+            (*Ot)= *Cit++;
+            mRepresentatives[*Ot].Update( *It );
+            mIndex.Refresh(mRepresentatives, *Ot);
          }
 
-         MinIt= std::min_element(
-                   RepDiss.begin(),
-                   RepDiss.end() );
+         Ot++;
+         It++;
+      }
 
-         MinDiss= *MinIt;
-         ClosestRep= boost::numeric::converter<LabelType, RealDiffType>
-                     ::convert( std::distance(RepDiss.begin(), MinIt) );
+      return;
+   }
+
+   // Seconda passata.
+   while (iSampleEnd != It)
+   {
+      if (*Ot == Q_) // Non ancora assegnato.
+      {
+         ClosestRep= mIndex.Closest(mRepresentatives, *It, MinDiss);
 
          (*Ot)= ClosestRep;
          mRepresentatives[ClosestRep].Update( *It );
+         mIndex.Refresh(mRepresentatives, ClosestRep);
       }
 
       Ot++;
@@ -536,10 +595,29 @@ Bsas<Representative>::ModifiedClusterAnalysis(
 
 ////////////////////////////////////// PRIVATE /////////////////////////////////////////////
 
+// Ricerca del rappresentante più vicino per un blocco di campioni.
+template <typename Representative, typename RepIndex>
+template <typename ForwardIterator1>
+void
+Bsas<Representative, RepIndex>::ClosestRange(
+                         const std::vector<ForwardIterator1>*   pPending,
+                         LabelVector*                           pClosest,
+                         Executor::SizeType                     aFirst,
+                         Executor::SizeType                     aLast) const
+{
+   // Variabili.
+   RealType             MinDiss_;
+
+   for (Executor::SizeType i= aFirst; i < aLast; i++)
+   {
+      (*pClosest)[i]= mIndex.Closest(mRepresentatives, *(*pPending)[i], MinDiss_);
+   }
+}  // ClosestRange
+
 // Funzione ausiliaria.
-template <typename Representative>
+template <typename Representative, typename RepIndex>
 void
-Bsas<Representative>::AlgoInit()
+Bsas<Representative, RepIndex>::AlgoInit()
 {
    // Converto il valore di mQ.
    Q_= boost::numeric::converter<LabelType, NaturalType>::convert(mQ);
@@ -554,6 +632,7 @@ Bsas<Representative>::AlgoInit()
    // Cancello vecchi rappresentanti.
    mRepresentatives.clear();
    mLabels.clear();
+   mIndex.Clear();
 
    // I vector ce la possono fare ?
    if ( ( Q_ > mRepresentatives.max_size() ) || ( Q__ > mLabels.max_size() ) )
@@ -564,7 +643,6 @@ Bsas<Representative>::AlgoInit()
    // Riservo spazio sufficiente in memoria, per non ri-allocare dinamicamente.
    mRepresentatives.reserve(Q_);
    mLabels.reserve(Q__);
-   RepDiss.reserve( boost::numeric::converter<DissSizeType, LabelType>::convert(Q_) );
 }  // AlgoInit
 
 }  // namespace spare
@@ -30,20 +30,44 @@
 #include <algorithm>
 #include <iterator>
 #include <limits>
+#include <string>
+#include <utility>
 #include <vector>
 
 // BOOST INCLUDES
+#include <boost/bind/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/mpl/int.hpp>
+#include <boost/mpl/integral_c_tag.hpp>
 #include <boost/numeric/conversion/converter.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 // SPARE INCLUDES
 #include <spare/BoundedParameter.hpp>
+#include <spare/Clustering/RepIndex/LinearScan.hpp>
+#include <spare/Dissimilarity/MetricTraits.hpp>
+#include <spare/Dissimilarity/SquaredDiss.hpp>
+#include <spare/Executor.hpp>
+#include <spare/Representative/RepresentativeTraits.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
+#include <spare/SwitchParameter.hpp>
+
+#ifdef SPARE_USE_EIGEN
+#include <spare/Dissimilarity/PairwiseDistances.hpp>
+#endif
 
 namespace spare {  // Inclusion in namespace spare.
 
+// Data for switch parameter construction.
+static const std::string KMEANS_SCVAL[]= {"Standard", "Hamerly", "Parallel", "Incremental"};
+static const size_t      KMEANS_SCVAL_SZ= 4;
+
 /** @brief K-means clustering algorithm.
  *
  * %Kmeans is a template class which models the @a Clustering concept. Its first template argument
@@ -59,6 +83,31 @@ namespace spare {  // Inclusion in namespace spare.
  * behavior of the cluster models in some way, for example setting some dissimilarity measure
  * parameters.
  * The implemented stop condition is a logical OR combining the a maximum number of iterations, and a (dynamic) check veryfing if the partition has sifficiently changed during the last iterations.
+ * The optional third template argument is a class modeling the @a RepresentativeIndex concept (see LinearScan and PivotTable), used
+ * for the closest representative search; it is rebuilt each time the representatives are recomputed.
+ * The @a Hamerly scheme keeps, for each sample, an upper bound of the dissimilarity from its representative and a lower bound
+ * of the dissimilarity from any other representative, updated with the displacements of the representatives and compared with
+ * half the dissimilarity between each representative and its closest one; a sample is examined only when the bounds do not
+ * prove that its label is unchanged. The partitions are the same of the @a Standard scheme, while the number of dissimilarity
+ * evaluations skipped is returned by GetSkippedDissCount. The scheme requires IsMetric<Representative> and a Diss method
+ * between representatives; otherwise the @a Standard scheme is performed.
+ * The @a Parallel scheme splits the samples in chunks, processed concurrently on an Executor (see ExecutorSetup): each chunk
+ * assigns its samples and accumulates them in a local copy of the representatives, and the copies are then combined in chunk
+ * order through the Merge method of the Representative class. The chunk size depends only on the number
+ * of samples, hence the result does not depend on the number of threads, while it can differ from the @a Standard scheme when
+ * merging is not exact (e.g. for floating point rounding, or for sampling based representatives). The Diss method of the
+ * representatives and the Closest method of the index must be safe for concurrent calls. The scheme requires
+ * HasMerge<Representative>; otherwise the @a Standard scheme is performed.
+ * The @a Incremental scheme rebuilds the representatives from scratch only at the first iteration and after the removal of an
+ * empty cluster; otherwise, only the samples whose label has changed are moved between representatives, through the Move method
+ * of the Representative class (see Centroid). The update cost is then proportional to the number of changed labels instead of
+ * the number of samples. The result equals the @a Standard scheme up to floating point rounding. The scheme requires
+ * HasMove<Representative>; otherwise the @a Standard scheme is performed.
+ * When the SPARE_USE_EIGEN macro is defined (the Eigen 3 library is then required), with unweighted Centroid<Euclidean>
+ * representatives, std::vector<RealType> samples, the default LinearScan index and at least 128 clusters, every scheme but
+ * @a Hamerly assigns the samples through PairwiseDistances: the samples are copied once in a matrix and each assignment is a
+ * blocked matrix product with the representatives. The labels are the same of LinearScan. The products run on the executor
+ * with the @a Parallel scheme or when an executor has been set up (see ExecutorSetup), on the calling thread otherwise.
  *
  * <b>Parameter summary</b>
  *  <table class="contents">
@@ -70,6 +119,13 @@ namespace spare {  // Inclusion in namespace spare.
  *     <td class="indexkey"><b>Default</b></td>
  *  </tr>
  *  <tr>
+ *     <td class="indexvalue">Scheme</td>
+ *     <td class="indexvalue">{Standard, Hamerly, Parallel, Incremental}</td>
+ *     <td class="indexvalue">Choice of the algorithm variant to use.</td>
+ *     <td class="indexvalue">No</td>
+ *     <td class="indexvalue">Standard</td>
+ *  </tr>
+ *  <tr>
  *     <td class="indexvalue">K</td>
  *     <td class="indexvalue">[1, inf)</td>
  *     <td class="indexvalue">Tentative number of cluster to generate (less clusters could be
@@ -93,7 +149,7 @@ namespace spare {  // Inclusion in namespace spare.
  *  </tr>
  *  </table>
  */
-template <typename Representative, typename Initialization>
+template <typename Representative, typename Initialization, typename RepIndex= LinearScan<Representative> >
 class Kmeans
 {
 public:
@@ -120,14 +176,28 @@ public:
    typedef BoundedParameter<NaturalType>
                         NaturalParam;
 
+   /** Switch parameter.
+    */
+   typedef SwitchParameter<std::string>
+                        StringParam;
+
+   /** Counter of dissimilarity evaluations.
+    */
+   typedef boost::uint64_t
+                        CountType;
+
 // LIFECYCLE
 
    /** Default constructor
     */
    Kmeans()
-      : mK( 1, std::numeric_limits<NaturalType>::max() ),
+      : mScheme(KMEANS_SCVAL, KMEANS_SCVAL + KMEANS_SCVAL_SZ),
+        mK( 1, std::numeric_limits<NaturalType>::max() ),
         mMaxIter( 1, std::numeric_limits<NaturalType>::max() )
                            {
+                              mScheme= "Standard";
+                              mSkippedDissCount= 0;
+                              mExecutorSet= false;
                               mK= 2;
                               mMaxIter= 100;
                               mNumPerformedIterations=0;
@@ -152,6 +222,18 @@ public:
 
 // ACCESS
 
+   /** Read/write access to the Scheme parameter.
+    *
+    * @return A reference to the Scheme parameter.
+    */
+   StringParam&         Scheme()                   { return mScheme; }
+
+   /** Read only access to the Scheme parameter.
+    *
+    * @return A const reference to the Scheme parameter.
+    */
+   const StringParam&   Scheme() const             { return mScheme; }
+
    /** Read/write access to the K parameter.
     *
     * @return A reference to the K parameter.
@@ -183,6 +265,46 @@ public:
     */
    const NaturalType& NumPerformedIterations() const { return mNumPerformedIterations; }
 
+   /**
+    * Read-only access to the number of sample/representative dissimilarity evaluations skipped during the last call of
+    * the Process method, with respect to the @a Standard scheme. The evaluations between representatives needed by the
+    * bounds are deducted.
+    *
+    * @return A const reference to the number of skipped evaluations.
+    */
+   const CountType& GetSkippedDissCount() const { return mSkippedDissCount; }
+
+   /** Setup of the executor used by the @a Parallel scheme and by the PairwiseDistances assignment.
+    *
+    * The same executor can be shared among several components, bounding the overall number
+    * of threads.
+    *
+    * @param[in] pExecutor Shared pointer to the executor.
+    */
+   void                 ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor)
+                           {
+                              mExecutor= pExecutor;
+                              mExecutorSet= true;
+                           }
+
+   /** Read access to the executor used by the @a Parallel scheme and by the PairwiseDistances assignment.
+    *
+    * If no executor has been set up, a private one with one thread per hardware thread is
+    * created.
+    *
+    * @return A shared pointer to the executor.
+    */
+   const boost::shared_ptr<Executor>&
+                        GetExecutor() const
+                           {
+                              if (!mExecutor)
+                              {
+                                 mExecutor.reset( new Executor );
+                              }
+
+                              return mExecutor;
+                           }
+
    /** Read/write access to the initialization algorithm for the first K representatives.
     *
     * @return A reference to the instance.
@@ -208,6 +330,18 @@ public:
    const Representative&
                         RepInit() const            { return mRepInit; }
 
+   /** Read/write access to the representative index.
+    *
+    * @return A reference to the instance.
+    */
+   RepIndex&            Index()                    { return mIndex; }
+
+   /** Read only access to the representative index.
+    *
+    * @return A const reference to the instance.
+    */
+   const RepIndex&      Index() const              { return mIndex; }
+
    /** Read access to the container holding the defined output labels (labels pertaining the clustering).
     *
     * The container holds the valid labels defined during the last call of the Process
@@ -265,6 +399,9 @@ public:
 
 private:
 
+   // Schema algoritmico (standard o con limiti di Hamerly).
+   StringParam mScheme;
+
    // Numero di cluster.
    NaturalParam mK;
 
@@ -293,8 +430,8 @@ private:
    // Lista etichette rappresentanti.
    LabelVector mLabels;
 
-   // Vettore dissimilarita'.
-   std::vector<RealType> mRepDiss;
+   // Indice per la ricerca del rappresentante più vicino.
+   RepIndex mIndex;
    
    // Contiene il minimo valore dello scostamento medio globale - may 2013 DNA
    RealType	mMinChange;
@@ -305,6 +442,81 @@ private:
    // Variabile che indica se eseguire il calcolo della soglia dinamica - june 2013 - DNA
    bool mDynThreshold;
 
+   // Valutazioni di dissimilarità evitate dallo schema Hamerly.
+   CountType mSkippedDissCount;
+
+   // Rappresentante più vicino e secondo minimo, con conteggio delle valutazioni.
+   template <typename SampleType>
+   LabelType ClosestTwo(const SampleType& rSample, RealType& rFirst, RealType& rSecond, CountType& rEvals) const;
+
+   // Meta' della dissimilarita' di ciascun rappresentante dal rappresentante piu' vicino.
+   void HalfSeparation(std::vector<RealType>& rHalf, CountType& rEvals) const;
+
+   // Executor per lo schema parallelo.
+   mutable boost::shared_ptr<Executor> mExecutor;
+
+   // Executor impostato dall'utente (non creato da GetExecutor).
+   bool mExecutorSet;
+
+   // Assegnazione dei campioni [aFirst, aLast) al rappresentante più vicino.
+   template <typename ForwardIterator1>
+   void AssignRange(const std::vector<ForwardIterator1>* pSamples, LabelVector* pLabels,
+                    Executor::SizeType aFirst, Executor::SizeType aLast) const;
+
+   // Accumulo dei campioni [aFirst, aLast) in copie locali dei rappresentanti.
+   template <typename ForwardIterator1>
+   RepVector UpdateRange(const std::vector<ForwardIterator1>* pSamples, const LabelVector* pLabels,
+                         Executor::SizeType aFirst, Executor::SizeType aLast) const;
+
+   // Fusione delle copie locali dei rappresentanti.
+   static RepVector MergeReps(RepVector aAcc, const RepVector& rPartial);
+
+   // Fusione di un rappresentante, se previsto da HasMerge.
+   static void MergeRep(Representative& rAcc, const Representative& rPartial, boost::true_type)
+                                                   { rAcc.Merge(rPartial); }
+
+   static void MergeRep(Representative&, const Representative&, boost::false_type)
+                           {
+                              throw SpareLogicError("Kmeans, 3, Merge not available.");
+                           }
+
+   // Spostamento di un campione tra due rappresentanti, se previsto da HasMove.
+   template <typename SampleType>
+   static void MoveSample(const SampleType& rSample, Representative& rFrom, Representative& rTo,
+                          boost::true_type)
+                                                   { rFrom.Move(rSample, rTo); }
+
+   template <typename SampleType>
+   static void MoveSample(const SampleType&, Representative&, Representative&, boost::false_type)
+                           {
+                              throw SpareLogicError("Kmeans, 4, Move not available.");
+                           }
+
+#ifdef SPARE_USE_EIGEN
+   // Campioni in forma matriciale e motore per l'assegnazione con PairwiseDistances.
+   struct DenseAssignment
+   {
+      PairwiseDistances::Matrix Samples;
+      PairwiseDistances Engine;
+   };
+
+   // Preparazione dell'assegnazione con PairwiseDistances (falso se la distanza è pesata).
+   template <typename ForwardIterator1>
+   bool PrepareDense(ForwardIterator1 iBegin, ForwardIterator1 iEnd, DenseAssignment& rDense,
+                     boost::true_type) const;
+
+   // Assegnazione dei campioni al rappresentante più vicino con PairwiseDistances.
+   void AssignDense(const DenseAssignment& rDense, LabelVector& rLabels, boost::true_type) const;
+#else
+   struct DenseAssignment { };
+#endif
+
+   template <typename ForwardIterator1>
+   bool PrepareDense(ForwardIterator1, ForwardIterator1, DenseAssignment&, boost::false_type) const
+                                                   { return false; }
+
+   void AssignDense(const DenseAssignment&, LabelVector&, boost::false_type) const { }
+
 
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
@@ -323,6 +535,12 @@ private:
 	  ar & mMinChange; // ** may-2013 - DNA
 	  ar & vSMG; // ** june-2013 - DNA
 	  ar & mDynThreshold; // ** june-2013 - DNA
+
+      // Dalla versione 1.
+      if (version > 0)
+      {
+         ar & mScheme;
+      }
    } // BOOST SERIALIZATION
 
 }; // class Kmeans
@@ -333,27 +551,21 @@ private:
 
 //==================================== OPERATIONS ==========================================
 
-template <typename Representative, typename Initialization>
+template <typename Representative, typename Initialization, typename RepIndex>
 template <typename ForwardIterator1, typename ForwardIterator2>
 void
-Kmeans<Representative, Initialization>::Process(
+Kmeans<Representative, Initialization, RepIndex>::Process(
                             ForwardIterator1  iSampleBegin,
                             ForwardIterator1  iSampleEnd,
                             ForwardIterator2  iLabelBegin)
 {
+   using boost::placeholders::_1;
+   using boost::placeholders::_2;
+
    // Typedef locali.
    typedef typename RepVector::iterator
                         RepVectorIterator;
 
-   typedef std::iterator_traits<std::vector<RealType>::iterator>::difference_type
-                        RealDiffType;
-
-   typedef std::vector<RealType>::size_type
-                        DissSizeType;
-
-   typedef std::vector<RealType>::iterator
-                        DissIterator;
-
    typedef typename LabelVector::iterator
                         LabelVectorIterator;
 
@@ -363,11 +575,23 @@ Kmeans<Representative, Initialization>::Process(
    typedef typename std::iterator_traits<ForwardIterator1>::difference_type
                         SampleDiffType;
 
+#ifdef SPARE_USE_EIGEN
+   typedef typename std::iterator_traits<ForwardIterator1>::value_type
+                        SampleType;
+
+   typedef boost::integral_constant<bool,
+                                    HasPairwiseDistances<Representative, SampleType>::value &&
+                                    boost::is_same< RepIndex, LinearScan<Representative> >::value>
+                        DenseTag;
+#else
+   typedef boost::false_type
+                        DenseTag;
+#endif
+
    // Variabili.
    ForwardIterator1        It;           // Iteratore principale dati.
    ForwardIterator2        Ot;           // Iteratore principale etichette.
-   DissIterator            Dit;          // Iteratore distanze campione-cluster.
-   DissIterator            MinIt;        // Iteratore distanze campione-cluster.
+   RealType                MinDiss;      // Minima dissimilarità campione-cluster.
    LabelVectorSizeType     i;            // Contatore.
    LabelType               j;            // Contatore.
    NaturalType             Iter;         // Contatore iterazioni.
@@ -380,6 +604,24 @@ Kmeans<Representative, Initialization>::Process(
    LabelVectorSizeType     K__;          // Valore K.
    LabelVectorSizeType     S;            // Numero di campioni.
    RealType				   Change;		 // Valore dello scostamento medio temporaneo.
+   bool                    Bounded;      // Flag schema Hamerly.
+   std::vector<RealType>   Upper;        // Limiti superiori campione-rappresentante (Hamerly).
+   std::vector<RealType>   Lower;        // Limiti inferiori campione-altri rappresentanti (Hamerly).
+   std::vector<RealType>   Half;         // Meta' separazione rappresentanti (Hamerly).
+   std::vector<RealType>   Drift;        // Spostamenti rappresentanti (Hamerly).
+   RepVector               PrevRep;      // Rappresentanti dell'iterazione precedente (Hamerly).
+   CountType               Evals;        // Valutazioni di dissimilarità eseguite (Hamerly).
+   bool                    Parallel;     // Flag schema parallelo.
+   std::vector<ForwardIterator1>
+                           SampleIts;    // Accesso casuale ai campioni (parallelo).
+   LabelVector             Next;         // Etichette calcolate in parallelo.
+   Executor::SizeType      Grain;        // Dimensione dei blocchi (parallelo).
+   bool                    Incremental;  // Flag schema incrementale.
+   bool                    FullUpdate;   // Flag ricostruzione completa dei rappresentanti (incrementale).
+   std::vector<std::pair<ForwardIterator1, std::pair<LabelType, LabelType> > >
+                           Moves;        // Campioni con etichetta cambiata (incrementale).
+   bool                    Dense;        // Flag assegnazione con PairwiseDistances.
+   DenseAssignment         DenseData;    // Campioni e motore per PairwiseDistances.
 
    // ** may-2013 - DNA
    if (!vSMG.empty()) // ** se il vettore degli scostamenti medi globali non è vuoto lo svuoto. - june 2013 DNA
@@ -403,6 +645,7 @@ Kmeans<Representative, Initialization>::Process(
    // Svuoto contenitori temporanei.
    mRepresentatives.clear();
    mLabels.clear();
+   mIndex.Clear();
 
    // I contenitori ce la possono fare ?
    if ( ( K_ > mRepresentatives.max_size() ) || ( K__ > mLabels.max_size() ) )
@@ -412,31 +655,77 @@ Kmeans<Representative, Initialization>::Process(
 
    // Alloco la memoria e inizializzo le etichette.
    mRepresentatives.resize(K_, mRepInit);
-   mRepDiss.resize( boost::numeric::converter<DissSizeType, LabelType>::convert(K_) );
 
    // Initialization of the K representatives
    It=iSampleBegin;
    mInit.Initialize(K_, It, iSampleEnd, mRepresentatives);
+   mIndex.Rebuild(mRepresentatives);
+
+   // Schema con limiti di Hamerly solo per rappresentanti metrici.
+   Bounded= (mScheme == "Hamerly") && IsMetric<Representative>::value;
+   mSkippedDissCount= 0;
+   if (Bounded)
+   {
+      Upper.resize(S);
+      Lower.resize(S);
+   }
+
+   // Vettori densi: assegnazione con i prodotti matriciali, se i rappresentanti sono abbastanza.
+   Dense= !Bounded && (K__ >= 128) && PrepareDense(iSampleBegin, iSampleEnd, DenseData, DenseTag());
+   if (Dense)
+   {
+      AssignDense(DenseData, Next, DenseTag());
+   }
+
+   // Schema parallelo, solo per rappresentanti fondibili: blocchi dipendenti solo dal numero di campioni.
+   Parallel= (mScheme == "Parallel") && HasMerge<Representative>::value;
+   Grain= 0;
+   if (Parallel)
+   {
+      SampleIts.reserve(S);
+      for (It= iSampleBegin; iSampleEnd != It; It++)
+      {
+         SampleIts.push_back(It);
+      }
+
+      Next.resize(S);
+      Grain= std::max<Executor::SizeType>(S / 256, 64);
+      if (!Dense)
+      {
+         GetExecutor()->ParallelFor(
+                           0,
+                           S,
+                           Grain,
+                           boost::bind(&Kmeans::AssignRange<ForwardIterator1>,
+                                       this, &SampleIts, &Next, _1, _2) );
+      }
+   }
+
+   // Schema incrementale, solo per rappresentanti con Move: la prima ricostruzione è completa.
+   Incremental= (mScheme == "Incremental") && HasMove<Representative>::value;
+   FullUpdate= true;
 
    // Eseguo l'iterazione zero.
    It= iSampleBegin;
    Ot= iLabelBegin;
+   i= 0;
+   Evals= 0;
    while (iSampleEnd != It)
    {
-      Dit= mRepDiss.begin();
-      RepIt= mRepresentatives.begin();
-      while (mRepDiss.end() != Dit)
+      if (Bounded)
       {
-         (*Dit++)= (*RepIt++).Diss(*It);
+         (*Ot++)= ClosestTwo(*It, Upper[i], Lower[i], Evals);
+      }
+      else if (Parallel || Dense)
+      {
+         (*Ot++)= Next[i];
+      }
+      else
+      {
+         (*Ot++)= mIndex.Closest(mRepresentatives, *It, MinDiss);
       }
-
-      MinIt= std::min_element(
-                          mRepDiss.begin(),
-                          mRepDiss.end() );
-
-      (*Ot++)= boost::numeric::converter<LabelType, RealDiffType>
-               ::convert( std::distance(mRepDiss.begin(), MinIt) );
       It++;
+      i++;
    }
 
    Iter= 0;
@@ -456,18 +745,54 @@ Kmeans<Representative, Initialization>::Process(
             oldRep[j]=mRepresentatives[j];
 	  }
 
-	  // Calcolo nuovi centroidi.
-      for(j= 0; j < K_; j++)
+      // Conservo i rappresentanti per calcolarne lo spostamento.
+      if (Bounded)
       {
-         mRepresentatives[j]=mRepInit;
+         PrevRep= mRepresentatives;
       }
 
-      It= iSampleBegin;
-      Ot= iLabelBegin;
-	  while (iSampleEnd != It)
+	  // Calcolo nuovi centroidi.
+      if (Parallel)
+      {
+         // Next contiene le etichette correnti.
+         mRepresentatives= GetExecutor()->ParallelReduce(
+                                             0,
+                                             S,
+                                             Grain,
+                                             RepVector(K_, mRepInit),
+                                             boost::bind(&Kmeans::UpdateRange<ForwardIterator1>,
+                                                         this, &SampleIts, &Next, _1, _2),
+                                             &Kmeans::MergeReps);
+      }
+      else if (Incremental && !FullUpdate)
       {
-         mRepresentatives[*Ot++].Update(*It++);
+         // Sposto solo i campioni con etichetta cambiata.
+         for (i= 0; i < Moves.size(); i++)
+         {
+            MoveSample(*Moves[i].first,
+                       mRepresentatives[Moves[i].second.first],
+                       mRepresentatives[Moves[i].second.second],
+                       boost::integral_constant<bool, HasMove<Representative>::value>());
+         }
       }
+      else
+      {
+         for(j= 0; j < K_; j++)
+         {
+            mRepresentatives[j]=mRepInit;
+         }
+
+         It= iSampleBegin;
+         Ot= iLabelBegin;
+         while (iSampleEnd != It)
+         {
+            mRepresentatives[*Ot++].Update(*It++);
+         }
+
+         FullUpdate= false;
+      }
+
+      Moves.clear();
 
       // ** Si verifica se siamo in un caso di controllo con soglia statica o dinamica e quindi
 	  // ** controllo di quanto si sono spostati i rappresentanti dall'ultima iterazione 
@@ -513,25 +838,37 @@ Kmeans<Representative, Initialization>::Process(
       // Elimino eventuali cluster vuoti.
       Del= false;
       RepIt= mRepresentatives.begin();
-      Dit= mRepDiss.begin();
       while (mRepresentatives.end() != RepIt)
       {
          if (RepIt->GetCount() == 0)
          {
             Del= true;
             RepIt= mRepresentatives.erase(RepIt);
-            Dit= mRepDiss.erase(Dit);
          }
          else
          {
             RepIt++;
-            Dit++;
          }
       }
 
+      // Spostamento dei rappresentanti (senza cancellazioni gli indici sono invariati).
+      Evals= 0;
+      if (Bounded && !Del)
+      {
+         Drift.resize(K_);
+         for(j= 0; j < K_; j++)
+         {
+            Drift[j]= PrevRep[j].Diss(mRepresentatives[j]);
+         }
+         Evals+= K_;
+      }
+
 
       K_= mRepresentatives.size();
 
+      // Dopo una cancellazione gli indici sono cambiati.
+      FullUpdate= FullUpdate || Del;
+
       if (!Del)
       {
          Iter++;
@@ -543,26 +880,106 @@ Kmeans<Representative, Initialization>::Process(
          It= iSampleBegin;
          Ot= iLabelBegin;
          Stop= !Del;
-         while (iSampleEnd != It)
+         mIndex.Rebuild(mRepresentatives);
+
+         // Schema Hamerly: aggiorno i limiti ed esamino solo i campioni dubbi.
+         if (Bounded)
          {
-            Dit= mRepDiss.begin();
-            RepIt= mRepresentatives.begin();
-            while (mRepDiss.end() != Dit)
+            RealType    MaxDrift= 0;          // Massimo spostamento.
+            RealType    SecondDrift= 0;       // Secondo massimo spostamento.
+            LabelType   MaxDriftRep= K_;      // Rappresentante con massimo spostamento.
+            RealType    Bound;                // Limite di separazione.
+
+            if (!Del)
             {
-               (*Dit++)= (*RepIt++).Diss(*It);
+               for(j= 0; j < K_; j++)
+               {
+                  if (Drift[j] > MaxDrift)
+                  {
+                     SecondDrift= MaxDrift;
+                     MaxDrift= Drift[j];
+                     MaxDriftRep= j;
+                  }
+                  else if (Drift[j] > SecondDrift)
+                  {
+                     SecondDrift= Drift[j];
+                  }
+               }
+
+               HalfSeparation(Half, Evals);
             }
 
-            MinIt= std::min_element(
-                                mRepDiss.begin(),
-                                mRepDiss.end() );
+            i= 0;
+            while (iSampleEnd != It)
+            {
+               // Dopo una cancellazione gli indici sono cambiati: ricalcolo tutto.
+               if (Del)
+               {
+                  ClosestRep= ClosestTwo(*It, Upper[i], Lower[i], Evals);
+               }
+               else
+               {
+                  ClosestRep= *Ot;
+                  Upper[i]+= Drift[ClosestRep];
+                  Lower[i]-= (ClosestRep == MaxDriftRep) ? SecondDrift : MaxDrift;
+                  Bound= std::max(Half[ClosestRep], Lower[i]);
+
+                  // Disuguaglianze strette: con limiti uguali potrebbe vincere un indice minore.
+                  if (Upper[i] >= Bound)
+                  {
+                     Upper[i]= mRepresentatives[ClosestRep].Diss(*It);
+                     Evals++;
+                     if (Upper[i] >= Bound)
+                     {
+                        ClosestRep= ClosestTwo(*It, Upper[i], Lower[i], Evals);
+                     }
+                  }
+               }
+
+               if (*Ot != ClosestRep)
+               {
+                  Stop= false;
+               }
+
+               (*Ot++)= ClosestRep;
+               It++;
+               i++;
+            }
 
-            ClosestRep= boost::numeric::converter<LabelType, RealDiffType>
-                        ::convert( std::distance(mRepDiss.begin(), MinIt) );
+            if (static_cast<CountType>(S) * K_ > Evals)
+            {
+               mSkippedDissCount+= static_cast<CountType>(S) * K_ - Evals;
+            }
+         }
+
+         if (Dense)
+         {
+            AssignDense(DenseData, Next, DenseTag());
+         }
+         else if (Parallel)
+         {
+            GetExecutor()->ParallelFor(
+                              0,
+                              S,
+                              Grain,
+                              boost::bind(&Kmeans::AssignRange<ForwardIterator1>,
+                                          this, &SampleIts, &Next, _1, _2) );
+         }
+
+         i= 0;
+         while (iSampleEnd != It)
+         {
+            ClosestRep= (Parallel || Dense) ? Next[i++] : mIndex.Closest(mRepresentatives, *It, MinDiss);
 
             //controlla se le etichette sono rimaste invariate dall'ultima assegnazione
             if (*Ot != ClosestRep)
             {
                Stop= false;
+
+               if (Incremental && !FullUpdate)
+               {
+                  Moves.push_back( std::make_pair(It, std::make_pair(*Ot, ClosestRep)) );
+               }
             }
 
             (*Ot++)= ClosestRep;
@@ -593,7 +1010,198 @@ Kmeans<Representative, Initialization>::Process(
 
 }  // End Process()
 
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+template <typename Representative, typename Initialization, typename RepIndex>
+template <typename SampleType>
+typename Kmeans<Representative, Initialization, RepIndex>::LabelType
+Kmeans<Representative, Initialization, RepIndex>::ClosestTwo(
+                            const SampleType& rSample,
+                            RealType&         rFirst,
+                            RealType&         rSecond,
+                            CountType&        rEvals) const
+{
+   const RealType Max= std::numeric_limits<RealType>::max();
+   LabelType   Closest= 0;
+   RealType    Diss;
+
+   // Confronto sulle dissimilarità comparabili (al quadrato, se disponibili).
+   rFirst= Max;
+   rSecond= Max;
+   for (LabelType j= 0; j < mRepresentatives.size(); j++)
+   {
+      Diss= ComparableDiss(mRepresentatives[j], rSample, Max);
+      if (Diss < rFirst)
+      {
+         rSecond= rFirst;
+         rFirst= Diss;
+         Closest= j;
+      }
+      else if (Diss < rSecond)
+      {
+         rSecond= Diss;
+      }
+   }
+
+   rFirst= ComparableToDiss<Representative>(rFirst);
+   if (rSecond < Max)
+   {
+      rSecond= ComparableToDiss<Representative>(rSecond);
+   }
+
+   rEvals+= mRepresentatives.size();
+
+   return Closest;
+}  // ClosestTwo
+
+template <typename Representative, typename Initialization, typename RepIndex>
+void
+Kmeans<Representative, Initialization, RepIndex>::HalfSeparation(
+                            std::vector<RealType>& rHalf,
+                            CountType&             rEvals) const
+{
+   RealType    Diss;
+
+   rHalf.assign( mRepresentatives.size(), std::numeric_limits<RealType>::max() );
+   for (LabelType j= 0; j < mRepresentatives.size(); j++)
+   {
+      for (LabelType h= j + 1; h < mRepresentatives.size(); h++)
+      {
+         Diss= mRepresentatives[j].Diss(mRepresentatives[h]) / 2;
+         rHalf[j]= std::min(rHalf[j], Diss);
+         rHalf[h]= std::min(rHalf[h], Diss);
+      }
+   }
+
+   rEvals+= mRepresentatives.size() * (mRepresentatives.size() - 1) / 2;
+}  // HalfSeparation
+
+template <typename Representative, typename Initialization, typename RepIndex>
+template <typename ForwardIterator1>
+void
+Kmeans<Representative, Initialization, RepIndex>::AssignRange(
+                            const std::vector<ForwardIterator1>*  pSamples,
+                            LabelVector*                          pLabels,
+                            Executor::SizeType                    aFirst,
+                            Executor::SizeType                    aLast) const
+{
+   RealType    MinDiss;
+
+   for (Executor::SizeType i= aFirst; i < aLast; i++)
+   {
+      (*pLabels)[i]= mIndex.Closest(mRepresentatives, *(*pSamples)[i], MinDiss);
+   }
+}  // AssignRange
+
+template <typename Representative, typename Initialization, typename RepIndex>
+template <typename ForwardIterator1>
+typename Kmeans<Representative, Initialization, RepIndex>::RepVector
+Kmeans<Representative, Initialization, RepIndex>::UpdateRange(
+                            const std::vector<ForwardIterator1>*  pSamples,
+                            const LabelVector*                    pLabels,
+                            Executor::SizeType                    aFirst,
+                            Executor::SizeType                    aLast) const
+{
+   RepVector   Local(mRepresentatives.size(), mRepInit);
+
+   for (Executor::SizeType i= aFirst; i < aLast; i++)
+   {
+      Local[(*pLabels)[i]].Update( *(*pSamples)[i] );
+   }
+
+   return Local;
+}  // UpdateRange
+
+template <typename Representative, typename Initialization, typename RepIndex>
+typename Kmeans<Representative, Initialization, RepIndex>::RepVector
+Kmeans<Representative, Initialization, RepIndex>::MergeReps(
+                            RepVector         aAcc,
+                            const RepVector&  rPartial)
+{
+   for (typename RepVector::size_type j= 0; j < aAcc.size(); j++)
+   {
+      MergeRep(aAcc[j], rPartial[j],
+               boost::integral_constant<bool, HasMerge<Representative>::value>());
+   }
+
+   return aAcc;
+}  // MergeReps
+
+#ifdef SPARE_USE_EIGEN
+
+template <typename Representative, typename Initialization, typename RepIndex>
+template <typename ForwardIterator1>
+bool
+Kmeans<Representative, Initialization, RepIndex>::PrepareDense(
+                            ForwardIterator1  iBegin,
+                            ForwardIterator1  iEnd,
+                            DenseAssignment&  rDense,
+                            boost::true_type) const
+{
+   if ( mRepInit.DissAgent().IsWeighted() )
+   {
+      return false;
+   }
+
+   PairwiseDistances::Pack(iBegin, iEnd, rDense.Samples);
+
+   // I prodotti sono paralleli solo con lo schema parallelo o con un executor impostato.
+   if ( (mScheme == "Parallel") || mExecutorSet )
+   {
+      rDense.Engine.ExecutorSetup( GetExecutor() );
+   }
+   else
+   {
+      rDense.Engine.ExecutorSetup( boost::shared_ptr<Executor>(new Executor(1)) );
+   }
+
+   return true;
+}  // PrepareDense
+
+template <typename Representative, typename Initialization, typename RepIndex>
+void
+Kmeans<Representative, Initialization, RepIndex>::AssignDense(
+                            const DenseAssignment&  rDense,
+                            LabelVector&            rLabels,
+                            boost::true_type) const
+{
+   const PairwiseDistances::Matrix&
+                              rSamples= rDense.Samples;
+   PairwiseDistances::Matrix  Reps(mRepresentatives.size(), rSamples.cols());
+
+   for (LabelType j= 0; j < mRepresentatives.size(); j++)
+   {
+      const typename Representative::CentroidVector&
+                              rCentroid= mRepresentatives[j].getRepresentativeSample();
+
+      if (static_cast<PairwiseDistances::Matrix::Index>( rCentroid.size() ) != rSamples.cols())
+      {
+         throw SpareLogicError("Kmeans, 2, Different lenghts.");
+      }
+
+      std::copy(rCentroid.begin(), rCentroid.end(), Reps.data() + j*rSamples.cols());
+   }
+
+   rDense.Engine.Closest(rSamples, Reps, rLabels);
+}  // AssignDense
+
+#endif  // SPARE_USE_EIGEN
+
 }  // namespace spare
 
+namespace boost { namespace serialization {
+
+// Versione dell'archivio di Kmeans (BOOST_CLASS_VERSION non si applica ai template):
+// la versione 1 aggiunge lo schema.
+template <typename Representative, typename Initialization, typename RepIndex>
+struct version< spare::Kmeans<Representative, Initialization, RepIndex> >
+{
+   typedef mpl::int_<1>          type;
+   typedef mpl::integral_c_tag   tag;
+   BOOST_STATIC_CONSTANT(int, value= version::type::value);
+};
+
+} }  // namespace boost::serialization
+
 #endif  // _Kmeans_h_
 
@@ -0,0 +1,313 @@
+//  KmeansParallel class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File KmeansParallel.hpp
+ *
+ * The file contains the k-means|| (scalable k-means++) kmeans initialization, which oversamples a set of candidate representatives
+ * in a few rounds and then selects K of them by a weighted k-means++ seeding.
+ * The details can be retrieved from the paper "Scalable K-Means++. Bahmani et al., 2012".
+ *
+ * @file KmeansParallel.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef KMEANSPARALLEL_HPP_
+#define KMEANSPARALLEL_HPP_
+
+//STD
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+//BOOST
+#include <boost/bind/bind.hpp>
+#include <boost/random.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/shared_ptr.hpp>
+
+//SPARE
+#include <spare/Executor.hpp>
+#include <spare/SpareExceptions.hpp>
+#include <spare/SpareTypes.hpp>
+
+
+namespace spare {
+
+/** @brief k-means|| initialization algorithm for kmeans clustering algorithm.
+ *
+ * A first candidate is selected with uniform probability. Then, for a given number of rounds, each sample x is independently
+ * selected as candidate with probability min(1, l*D(x)^2/phi), where D(x) is the dissimilarity of x from the closest candidate,
+ * phi is the sum of D(x)^2 over the samples and l = Oversampling*K. Each candidate is weighted by the number of samples closer to
+ * it than to the other candidates, and K representatives are finally selected among the candidates by a weighted k-means++
+ * seeding (if less than K candidates have been found, the missing ones are selected by k-means++ over the samples).
+ * The dissimilarities are evaluated through the Diss method of the representatives, hence the initialization can be used with any
+ * Representative; the update of D(x) after each round, which takes N*l evaluations, is performed in parallel on an Executor (see
+ * ExecutorSetup), while the random choices are sequential, so the result does not depend on the number of threads. The Diss method
+ * of the representatives must be safe for concurrent calls.
+ */
+class KmeansParallel
+{
+public:
+
+    /**
+     * Default constructor
+     */
+    KmeansParallel()
+    {
+        mSeed=1;
+        mRounds=5;
+        mOversampling=2;
+    }
+
+    /**
+     * Read-write access to the seed
+     * @return The reference to the seed
+     */
+    NaturalType& Seed() { return mSeed; }
+
+    /**
+     * Read-only access to the seed
+     * @return The const reference to the seed
+     */
+    const NaturalType& Seed() const { return mSeed; }
+
+    /**
+     * Read-write access to the number of oversampling rounds
+     * @return The reference to the number of rounds
+     */
+    NaturalType& Rounds() { return mRounds; }
+
+    /**
+     * Read-only access to the number of oversampling rounds
+     * @return The const reference to the number of rounds
+     */
+    const NaturalType& Rounds() const { return mRounds; }
+
+    /**
+     * Read-write access to the oversampling factor, i.e. the expected number of candidates per round divided by K
+     * @return The reference to the oversampling factor
+     */
+    RealType& Oversampling() { return mOversampling; }
+
+    /**
+     * Read-only access to the oversampling factor
+     * @return The const reference to the oversampling factor
+     */
+    const RealType& Oversampling() const { return mOversampling; }
+
+    /**
+     * Setup of the executor used for the dissimilarity updates
+     * @param[in] pExecutor Shared pointer to the executor
+     */
+    void ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor) { mExecutor=pExecutor; }
+
+    /**
+     * Read access to the executor; if no executor has been set up, a private one with one thread per hardware thread is created
+     * @return A shared pointer to the executor
+     */
+    const boost::shared_ptr<Executor>& GetExecutor() const
+    {
+        if(!mExecutor)
+            mExecutor.reset(new Executor);
+
+        return mExecutor;
+    }
+
+    /**
+     * Main representatives initialization method.
+     * @param[in] K The K parameter of the kmeans algorithm
+     * @param[in] itS Iterator pointing at the beginning of the samples container
+     * @param[in] itE Iterator pointing at the end of the samples container
+     * @param[out] representativeVector Reference to the vector of the kmeans representatives. Note that this container must be assumed to be already resized to contain the K representatives
+     */
+    template <typename SamplesITType, typename RepVectorType>
+    void Initialize(const NaturalType& K, const SamplesITType& itS, const SamplesITType& itE, RepVectorType& representativeVector) const
+    {
+        typedef boost::minstd_rand BaseGeneratorType;
+        typedef boost::variate_generator<BaseGeneratorType&, boost::uniform_real<> > UniformGeneratorType;
+        typedef typename RepVectorType::value_type RepType;
+        typedef Executor::SizeType SizeType;
+
+        BaseGeneratorType random(mSeed);
+        boost::uniform_real<> uni_dist(0, 1);
+        UniformGeneratorType uni(random, uni_dist);
+
+        std::vector<SamplesITType> samples;
+        for(SamplesITType it=itS; it!=itE; it++)
+            samples.push_back(it);
+
+        if(samples.empty())
+            throw SpareLogicError("KmeansParallel, 0, Empty sample range.");
+
+        //candidates, as sample positions and as representatives
+        const RepType prototype=representativeVector[0];
+        std::vector<SizeType> candidates;
+        std::vector<RepType> candidateReps;
+
+        //squared dissimilarity from the closest candidate, and the closest candidate itself
+        std::vector<RealType> minDiss2(samples.size(), std::numeric_limits<RealType>::max());
+        std::vector<SizeType> nearest(samples.size(), 0);
+
+        SizeType pos=std::min<SizeType>(static_cast<SizeType>(uni()*samples.size()), samples.size()-1);
+        AddCandidate(pos, samples, prototype, candidates, candidateReps);
+        RealType phi=UpdateDiss(samples, candidateReps, 0, minDiss2, nearest);
+
+        //oversampling rounds
+        RealType l=mOversampling*K;
+        for(NaturalType r=0; r<mRounds && phi>0; r++)
+        {
+            SizeType first=candidates.size();
+            for(SizeType i=0; i<samples.size(); i++)
+            {
+                if(minDiss2[i]>0 && uni()<l*minDiss2[i]/phi)
+                    AddCandidate(i, samples, prototype, candidates, candidateReps);
+            }
+
+            if(first==candidates.size())
+                continue;
+
+            phi=UpdateDiss(samples, candidateReps, first, minDiss2, nearest);
+        }
+
+        //not enough candidates: k-means++ over the samples
+        while(candidates.size()<K)
+        {
+            pos=(phi>0) ? WeightedChoice(minDiss2, uni()*phi) : std::min<SizeType>(static_cast<SizeType>(uni()*samples.size()), samples.size()-1);
+            AddCandidate(pos, samples, prototype, candidates, candidateReps);
+            phi=UpdateDiss(samples, candidateReps, candidates.size()-1, minDiss2, nearest);
+        }
+
+        //candidate weights
+        std::vector<RealType> weights(candidates.size(), 0);
+        for(SizeType i=0; i<samples.size(); i++)
+            weights[nearest[i]]++;
+
+        //weighted k-means++ among the candidates
+        std::vector<RealType> candDiss2(candidates.size(), std::numeric_limits<RealType>::max());
+        std::vector<RealType> candWeights(weights);
+        RealType total=samples.size();
+        for(NaturalType k=0; k<K; k++)
+        {
+            pos=(total>0) ? WeightedChoice(candWeights, uni()*total) : k;
+            representativeVector[k].Update(*samples[candidates[pos]]);
+
+            total=0;
+            for(SizeType c=0; c<candidates.size(); c++)
+            {
+                RealType d=candidateReps[pos].Diss(*samples[candidates[c]]);
+                candDiss2[c]=std::min(candDiss2[c], d*d);
+                candWeights[c]=weights[c]*candDiss2[c];
+                total+=candWeights[c];
+            }
+        }
+    }
+
+
+private:
+
+    /**
+     * Seed for boost uniform random number generator
+     */
+    NaturalType mSeed;
+
+    /**
+     * Number of oversampling rounds
+     */
+    NaturalType mRounds;
+
+    /**
+     * Oversampling factor
+     */
+    RealType mOversampling;
+
+    /**
+     * Executor for the dissimilarity updates
+     */
+    mutable boost::shared_ptr<Executor> mExecutor;
+
+    //insertion of a candidate
+    template <typename SamplesITType, typename RepType>
+    static void AddCandidate(Executor::SizeType pos, const std::vector<SamplesITType>& samples, const RepType& prototype,
+                             std::vector<Executor::SizeType>& candidates, std::vector<RepType>& candidateReps)
+    {
+        candidates.push_back(pos);
+        candidateReps.push_back(prototype);
+        candidateReps.back().Update(*samples[pos]);
+    }
+
+    //position of the first element whose cumulative weight exceeds the threshold (elements with null weight are skipped)
+    static Executor::SizeType WeightedChoice(const std::vector<RealType>& weights, RealType threshold)
+    {
+        Executor::SizeType pos=0;
+        RealType cumulative=0;
+        for(Executor::SizeType i=0; i<weights.size(); i++)
+        {
+            if(weights[i]<=0)
+                continue;
+
+            cumulative+=weights[i];
+            pos=i;
+            if(cumulative>threshold)
+                break;
+        }
+
+        return pos;
+    }
+
+    //update of the dissimilarities with the candidates from the first new one, returns the sum of the squared dissimilarities
+    template <typename SamplesITType, typename RepType>
+    RealType UpdateDiss(const std::vector<SamplesITType>& samples, const std::vector<RepType>& candidateReps, Executor::SizeType firstNew,
+                        std::vector<RealType>& minDiss2, std::vector<Executor::SizeType>& nearest) const
+    {
+        using boost::placeholders::_1;
+        using boost::placeholders::_2;
+
+        GetExecutor()->ParallelFor(0, samples.size(), 0,
+                                   boost::bind(&KmeansParallel::UpdateRange<SamplesITType, RepType>, this,
+                                               &samples, &candidateReps, firstNew, &minDiss2, &nearest, _1, _2));
+
+        RealType phi=0;
+        for(Executor::SizeType i=0; i<minDiss2.size(); i++)
+            phi+=minDiss2[i];
+
+        return phi;
+    }
+
+    //update of the samples [first, last)
+    template <typename SamplesITType, typename RepType>
+    void UpdateRange(const std::vector<SamplesITType>* pSamples, const std::vector<RepType>* pCandidateReps, Executor::SizeType firstNew,
+                     std::vector<RealType>* pMinDiss2, std::vector<Executor::SizeType>* pNearest,
+                     Executor::SizeType first, Executor::SizeType last) const
+    {
+        for(Executor::SizeType i=first; i<last; i++)
+        {
+            for(Executor::SizeType c=firstNew; c<pCandidateReps->size(); c++)
+            {
+                RealType d=(*pCandidateReps)[c].Diss(*(*pSamples)[i]);
+                if(d*d<(*pMinDiss2)[i])
+                {
+                    (*pMinDiss2)[i]=d*d;
+                    (*pNearest)[i]=c;
+                }
+            }
+        }
+    }
+};
+
+}
+
+#endif /* KMEANSPARALLEL_HPP_ */
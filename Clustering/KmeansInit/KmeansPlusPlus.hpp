@@ -0,0 +1,158 @@
+//  KmeansPlusPlus class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File KmeansPlusPlus.hpp
+ *
+ * The file contains the k-means++ kmeans initialization, which selects the representatives with probability proportional to the
+ * squared dissimilarity from the closest representative already selected.
+ * The details can be retrieved from the paper "k-means++: The Advantages of Careful Seeding. Arthur and Vassilvitskii, 2007".
+ *
+ * @file KmeansPlusPlus.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef KMEANSPLUSPLUS_HPP_
+#define KMEANSPLUSPLUS_HPP_
+
+//STD
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+//BOOST
+#include <boost/random.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+//SPARE
+#include <spare/SpareExceptions.hpp>
+#include <spare/SpareTypes.hpp>
+
+
+namespace spare {
+
+/** @brief k-means++ initialization algorithm for kmeans clustering algorithm.
+ *
+ * The first representative is a sample selected with uniform probability; each following one is a sample selected with probability
+ * proportional to D(x)^2, where D(x) is the dissimilarity of the sample x from the closest representative already selected.
+ * The dissimilarities are evaluated through the Diss method of the representatives, updated with the selected samples, hence the
+ * initialization can be used with any Representative and requires N*K dissimilarity evaluations. Samples are never selected twice,
+ * unless there are less than K distinct ones.
+ */
+class KmeansPlusPlus
+{
+public:
+
+    /**
+     * Default constructor
+     */
+    KmeansPlusPlus()
+    {
+        mSeed=1;
+    }
+
+    /**
+     * Read-write access to the seed
+     * @return The reference to the seed
+     */
+    NaturalType& Seed() { return mSeed; }
+
+    /**
+     * Read-only access to the seed
+     * @return The const reference to the seed
+     */
+    const NaturalType& Seed() const { return mSeed; }
+
+    /**
+     * Main representatives initialization method.
+     * @param[in] K The K parameter of the kmeans algorithm
+     * @param[in] itS Iterator pointing at the beginning of the samples container
+     * @param[in] itE Iterator pointing at the end of the samples container
+     * @param[out] representativeVector Reference to the vector of the kmeans representatives. Note that this container must be assumed to be already resized to contain the K representatives
+     */
+    template <typename SamplesITType, typename RepVectorType>
+    void Initialize(const NaturalType& K, const SamplesITType& itS, const SamplesITType& itE, RepVectorType& representativeVector) const
+    {
+        typedef boost::minstd_rand BaseGeneratorType;
+        typedef boost::variate_generator<BaseGeneratorType&, boost::uniform_real<> > UniformGeneratorType;
+        typedef typename std::vector<SamplesITType>::size_type SizeType;
+
+        BaseGeneratorType random(mSeed);
+        boost::uniform_real<> uni_dist(0, 1);
+        UniformGeneratorType uni(random, uni_dist);
+
+        std::vector<SamplesITType> samples;
+        for(SamplesITType it=itS; it!=itE; it++)
+            samples.push_back(it);
+
+        if(samples.empty())
+            throw SpareLogicError("KmeansPlusPlus, 0, Empty sample range.");
+
+        //squared dissimilarity from the closest selected representative
+        std::vector<RealType> minDiss2(samples.size(), std::numeric_limits<RealType>::max());
+        SizeType pos=std::min<SizeType>(static_cast<SizeType>(uni()*samples.size()), samples.size()-1);
+
+        for(NaturalType k=0; k<K; k++)
+        {
+            representativeVector[k].Update(*samples[pos]);
+            if(k+1==K)
+                break;
+
+            //update the dissimilarities with the new representative, N evaluations
+            RealType total=0;
+            for(SizeType i=0; i<samples.size(); i++)
+            {
+                RealType d=representativeVector[k].Diss(*samples[i]);
+                minDiss2[i]=std::min(minDiss2[i], d*d);
+                total+=minDiss2[i];
+            }
+
+            //all samples already selected: uniform choice
+            if(total<=0)
+            {
+                pos=std::min<SizeType>(static_cast<SizeType>(uni()*samples.size()), samples.size()-1);
+                continue;
+            }
+
+            //D^2 weighted selection, skipping samples with null weight
+            RealType threshold=uni()*total;
+            RealType cumulative=0;
+            pos=samples.size();
+            for(SizeType i=0; i<samples.size(); i++)
+            {
+                if(minDiss2[i]<=0)
+                    continue;
+
+                cumulative+=minDiss2[i];
+                pos=i;
+                if(cumulative>threshold)
+                    break;
+            }
+        }
+    }
+
+
+private:
+
+    /**
+     * Seed for boost uniform random number generator
+     */
+    NaturalType mSeed;
+};
+
+}
+
+#endif /* KMEANSPLUSPLUS_HPP_ */
@@ -0,0 +1,392 @@
+//  KmeansRestarts class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File KmeansRestarts.hpp, containing the %KmeansRestarts template class.
+ *
+ * The file contains the %KmeansRestarts template class, which runs several independent
+ * restarts of a K-means clustering algorithm and keeps the best one.
+ *
+ * @file KmeansRestarts.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _KmeansRestarts_h_
+#define _KmeansRestarts_h_
+
+// STD INCLUDES
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+// BOOST INCLUDES
+#include <boost/bind/bind.hpp>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+// SPARE INCLUDES
+#include <spare/BoundedParameter.hpp>
+#include <spare/Executor.hpp>
+#include <spare/SpareExceptions.hpp>
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusion in namespace spare.
+
+/** @brief Multi-restart K-means clustering algorithm.
+ *
+ * %KmeansRestarts is a template class which models the @a Clustering concept. Its template
+ * argument is a K-means clustering class, such as Kmeans or MiniBatchKmeans, whose
+ * initialization policy exposes a Seed parameter (e.g. RandomK, KmeansPlusPlus,
+ * KmeansParallel, SamplingSeeding). The Process method runs Restarts copies of the clustering
+ * agent (see Agent), the r-th one with initialization seed Seed + r, concurrently on an
+ * Executor (see ExecutorSetup). Each restart is scored by its within-cluster dissimilarity,
+ * i.e. the sum of the dissimilarities between the samples and their representatives, and only
+ * the best restart is kept (ties are broken in favour of the lowest restart index, so the
+ * result does not depend on the number of threads). The memory is bounded by the best
+ * partition plus one working partition per running thread.
+ * The restart executor is set up (see HasExecutorSetup) on each copy of the agent and on its
+ * initialization policy, whenever they have an ExecutorSetup method (e.g. Kmeans and
+ * KmeansParallel), so that their parallel sections share the same bounded set of threads.
+ *
+ * <b>Parameter summary</b>
+ *  <table class="contents">
+ *  <tr>
+ *     <td class="indexkey"><b>Name</b></td>
+ *     <td class="indexkey"><b>Domain</b></td>
+ *     <td class="indexkey"><b>Description</b></td>
+ *     <td class="indexkey"><b>Const</b></td>
+ *     <td class="indexkey"><b>Default</b></td>
+ *  </tr>
+ *  <tr>
+ *     <td class="indexvalue">Restarts</td>
+ *     <td class="indexvalue">[1, inf)</td>
+ *     <td class="indexvalue">Number of restarts.</td>
+ *     <td class="indexvalue">No</td>
+ *     <td class="indexvalue">10</td>
+ *  </tr>
+ *  </table>
+ */
+template <typename Clustering>
+class KmeansRestarts
+{
+public:
+
+// PUBLIC TYPES
+
+   /** Type of container storing the generated representatives.
+    */
+   typedef typename Clustering::RepVector
+                        RepVector;
+
+   /** Type of label type assigned to the processed samples.
+    */
+   typedef typename Clustering::LabelType
+                        LabelType;
+
+   /** Container of the defined output labels.
+    */
+   typedef typename Clustering::LabelVector
+                        LabelVector;
+
+   /** Integer parameter.
+    */
+   typedef BoundedParameter<NaturalType>
+                        NaturalParam;
+
+// LIFECYCLE
+
+   /** Default constructor.
+    */
+   KmeansRestarts()
+      : mRestarts( 1, std::numeric_limits<NaturalType>::max() )
+                           {
+                              mRestarts= 10;
+                              mSeed= 1;
+                              mBestScore= std::numeric_limits<RealType>::max();
+                              mBestRestart= 0;
+                           }
+
+// OPERATIONS
+
+   /** Cluster analysis execution.
+    *
+    * @param[in] iSampleBegin Iterator pointing to the first sample.
+    * @param[in] iSampleEnd Iterator pointing to the first position after the last sample.
+    * @param[out] iLabelBegin Iterator pointing to the first label.
+    */
+   template <typename ForwardIterator1, typename ForwardIterator2>
+   void                 Process(
+                           ForwardIterator1  iSampleBegin,
+                           ForwardIterator1  iSampleEnd,
+                           ForwardIterator2  iLabelBegin);
+
+// ACCESS
+
+   /** Read/write access to the Restarts parameter.
+    *
+    * @return A reference to the Restarts parameter.
+    */
+   NaturalParam&        Restarts()                 { return mRestarts; }
+
+   /** Read only access to the Restarts parameter.
+    *
+    * @return A const reference to the Restarts parameter.
+    */
+   const NaturalParam&  Restarts() const           { return mRestarts; }
+
+   /** Read/write access to the base seed.
+    *
+    * @return A reference to the base seed.
+    */
+   NaturalType&         Seed()                     { return mSeed; }
+
+   /** Read only access to the base seed.
+    *
+    * @return A const reference to the base seed.
+    */
+   const NaturalType&   Seed() const               { return mSeed; }
+
+   /** Read/write access to the clustering agent, used as prototype of the restarts.
+    *
+    * @return A reference to the clustering agent.
+    */
+   Clustering&          Agent()                    { return mAgent; }
+
+   /** Read only access to the clustering agent.
+    *
+    * @return A const reference to the clustering agent.
+    */
+   const Clustering&    Agent() const              { return mAgent; }
+
+   /** Setup of the executor running the restarts.
+    *
+    * @param[in] pExecutor Shared pointer to the executor.
+    */
+   void                 ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor)
+                                                   { mExecutor= pExecutor; }
+
+   /** Read access to the executor running the restarts.
+    *
+    * If no executor has been set up, a private one with one thread per hardware thread is
+    * created.
+    *
+    * @return A shared pointer to the executor.
+    */
+   const boost::shared_ptr<Executor>&
+                        GetExecutor() const
+                           {
+                              if (!mExecutor)
+                              {
+                                 mExecutor.reset( new Executor );
+                              }
+
+                              return mExecutor;
+                           }
+
+   /** Read access to the container holding the defined output labels of the best restart.
+    *
+    * @return A const reference to the container of the defined labels.
+    */
+   const LabelVector&   GetLabels() const          { return mBest.GetLabels(); }
+
+   /** Read access to the container holding the representatives of the best restart.
+    *
+    * @return A const reference to the container of the generated representatives.
+    */
+   const RepVector&     GetRepresentatives() const { return mBest.GetRepresentatives(); }
+
+   /** Read access to the clustering agent of the best restart.
+    *
+    * @return A const reference to the clustering agent.
+    */
+   const Clustering&    GetBest() const            { return mBest; }
+
+   /** Read access to the within-cluster dissimilarity of the best restart.
+    *
+    * @return The score of the best restart.
+    */
+   RealType             GetBestScore() const       { return mBestScore; }
+
+   /** Read access to the index of the best restart.
+    *
+    * @return The index of the best restart.
+    */
+   NaturalType          GetBestRestart() const     { return mBestRestart; }
+
+private:
+
+   // Numero di ripartenze.
+   NaturalParam         mRestarts;
+
+   // Seme di base.
+   NaturalType          mSeed;
+
+   // Prototipo dell'algoritmo di clustering.
+   Clustering           mAgent;
+
+   // Migliore ripartenza.
+   Clustering           mBest;
+
+   // Etichette dei campioni della migliore ripartenza.
+   LabelVector          mBestSampleLabels;
+
+   // Punteggio della migliore ripartenza.
+   RealType             mBestScore;
+
+   // Indice della migliore ripartenza.
+   NaturalType          mBestRestart;
+
+   // Executor per le ripartenze.
+   mutable boost::shared_ptr<Executor>
+                        mExecutor;
+
+   // Condivisione dell'executor con un componente, se lo prevede.
+   template <typename Component>
+   void                 ShareExecutor(Component& rComponent) const
+                           {
+                              ShareExecutor(rComponent,
+                                            boost::integral_constant<bool,
+                                               HasExecutorSetup<Component>::value>() );
+                           }
+
+   template <typename Component>
+   void                 ShareExecutor(Component& rComponent, boost::true_type) const
+                                                   { rComponent.ExecutorSetup(mExecutor); }
+
+   template <typename Component>
+   void                 ShareExecutor(Component&, boost::false_type) const
+                                                   { }
+
+   // Esecuzione delle ripartenze [aFirst, aLast).
+   template <typename ForwardIterator1>
+   void                 RunRange(
+                           ForwardIterator1     iSampleBegin,
+                           ForwardIterator1     iSampleEnd,
+                           boost::mutex*        pBestMutex,
+                           Executor::SizeType   aFirst,
+                           Executor::SizeType   aLast);
+
+   // BOOST SERIALIZATION
+   friend class boost::serialization::access;
+
+   template<class Archive>
+   void serialize(Archive & ar, const unsigned int version)
+   {
+      ar & mRestarts;
+      ar & mSeed;
+      ar & mAgent;
+      ar & mBest;
+      ar & mBestScore;
+      ar & mBestRestart;
+   } // BOOST SERIALIZATION
+
+}; // class KmeansRestarts
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+////////////////////////////////////// PUBLIC //////////////////////////////////////////////
+
+//==================================== OPERATIONS ==========================================
+
+template <typename Clustering>
+template <typename ForwardIterator1, typename ForwardIterator2>
+void
+KmeansRestarts<Clustering>::Process(
+                              ForwardIterator1  iSampleBegin,
+                              ForwardIterator1  iSampleEnd,
+                              ForwardIterator2  iLabelBegin)
+{
+   using boost::placeholders::_1;
+   using boost::placeholders::_2;
+
+   // Mutex per l'aggiornamento della migliore ripartenza.
+   boost::mutex         BestMutex;
+
+   mBestScore= std::numeric_limits<RealType>::max();
+   mBestRestart= mRestarts;
+   mBestSampleLabels.clear();
+
+   GetExecutor()->ParallelFor(
+                     0,
+                     mRestarts,
+                     1,
+                     boost::bind(&KmeansRestarts::RunRange<ForwardIterator1>,
+                                 this, iSampleBegin, iSampleEnd, &BestMutex, _1, _2) );
+
+   if (mBestRestart == mRestarts)
+   {
+      throw SpareLogicError("KmeansRestarts, 0, No restart completed.");
+   }
+
+   std::copy(mBestSampleLabels.begin(), mBestSampleLabels.end(), iLabelBegin);
+
+   // Le etichette dei campioni servono solo in uscita.
+   LabelVector().swap(mBestSampleLabels);
+}  // Process
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+template <typename Clustering>
+template <typename ForwardIterator1>
+void
+KmeansRestarts<Clustering>::RunRange(
+                              ForwardIterator1     iSampleBegin,
+                              ForwardIterator1     iSampleEnd,
+                              boost::mutex*        pBestMutex,
+                              Executor::SizeType   aFirst,
+                              Executor::SizeType   aLast)
+{
+   // Variabili.
+   ForwardIterator1     It;
+   RealType             Score;
+
+   for (Executor::SizeType r= aFirst; r < aLast; r++)
+   {
+      Clustering        Agent(mAgent);
+      LabelVector       Labels( std::distance(iSampleBegin, iSampleEnd) );
+
+      ShareExecutor(Agent);
+      ShareExecutor(Agent.Init());
+      Agent.Init().Seed()= mSeed + static_cast<NaturalType>(r);
+      Agent.Process(iSampleBegin, iSampleEnd, Labels.begin());
+
+      // Dissimilarità intra-cluster.
+      Score= 0;
+      It= iSampleBegin;
+      for (typename LabelVector::size_type i= 0; i < Labels.size(); i++)
+      {
+         Score+= Agent.GetRepresentatives()[ Labels[i] ].Diss(*It++);
+      }
+
+      // A parità di punteggio vince l'indice minore.
+      boost::mutex::scoped_lock Lock(*pBestMutex);
+      if ( (Score < mBestScore) ||
+           ( (Score == mBestScore) && (static_cast<NaturalType>(r) < mBestRestart) ) )
+      {
+         mBestScore= Score;
+         mBestRestart= static_cast<NaturalType>(r);
+         mBest= Agent;
+         mBestSampleLabels.swap(Labels);
+      }
+   }
+}  // RunRange
+
+}  // namespace spare
+
+#endif  // _KmeansRestarts_h_
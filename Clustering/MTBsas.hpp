@@ -38,11 +38,12 @@
 #include <boost/numeric/conversion/converter.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/vector.hpp>
-#include <boost/thread/thread.hpp>
-#include <boost/thread/mutex.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/shared_ptr.hpp>
 
 // SPARE INCLUDES
 #include <spare/BoundedParameter.hpp>
+#include <spare/Executor.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
 #include <spare/SwitchParameter.hpp>
@@ -50,8 +51,8 @@
 namespace spare {  // Inclusion in namespace spare.
 
 // Data for switch parameter construction.
-static const std::string BSAS_SCVAL[]= {"Basic", "Modified"};
-static const size_t      BSAS_SCVAL_SZ= 2;
+static const std::string MTBSAS_SCVAL[]= {"Basic", "Modified"};
+static const size_t      MTBSAS_SCVAL_SZ= 2;
 
 /** @brief %Bsas clustering algorithm.
  *
@@ -59,6 +60,14 @@ static const size_t      BSAS_SCVAL_SZ= 2;
  * is a class modeling the @a Representative concept. It is a multithreaded implementation that
  * computes the representatives/test sample dissimilarity in parallel, using a used-defined
  * number of threads.
+ * The dissimilarities are computed on an Executor, which can be shared with other components
+ * through the ExecutorSetup method; if none is provided, a private executor with NThreads
+ * threads (0 means the number of hardware threads) is created on first use and kept for the
+ * following Process calls. For each sample, the representatives are split in contiguous chunks,
+ * one per thread, and each dissimilarity is written in the slot indexed by its representative,
+ * so that the generated labels are identical to the ones of the sequential %Bsas. The Diss
+ * method of the selected Representative class must be safe for concurrent calls on distinct
+ * instances.
  * The selected Representative class is in
  * charge to build the abstract representations of the clusters during their aggregation. The
  * main method is Process, which performs the clustering procedure. The sample type (i.e. the
@@ -102,7 +111,7 @@ static const size_t      BSAS_SCVAL_SZ= 2;
  *  </tr>
  *  </table>  
  */
-template <typename Representative, NaturalType NThreads>
+template <typename Representative, NaturalType NThreads= 0>
 class MTBsas
 {
 public:
@@ -144,7 +153,7 @@ public:
    /** Default constructor.
     */
    MTBsas()
-      : mScheme(BSAS_SCVAL, BSAS_SCVAL + BSAS_SCVAL_SZ),
+      : mScheme(MTBSAS_SCVAL, MTBSAS_SCVAL + MTBSAS_SCVAL_SZ),
         mTheta( 0, std::numeric_limits<RealType>::max() ),
         mQ( 1, std::numeric_limits<NaturalType>::max() )
                            {
@@ -234,6 +243,33 @@ public:
    const Representative&
                         RepInit() const            { return mRepInit; }
 
+   /** Setup of the executor used for the parallel computations.
+    *
+    * The same executor can be shared among several components, bounding the overall number
+    * of threads.
+    *
+    * @param[in] pExecutor Shared pointer to the executor.
+    */
+   void                 ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor)
+                                                   { mExecutor= pExecutor; }
+
+   /** Read access to the executor used for the parallel computations.
+    *
+    * If no executor has been set up, a private one with NThreads threads is created.
+    *
+    * @return A shared pointer to the executor.
+    */
+   const boost::shared_ptr<Executor>&
+                        GetExecutor() const
+                           {
+                              if (!mExecutor)
+                              {
+                                 mExecutor.reset( new Executor(NThreads) );
+                              }
+
+                              return mExecutor;
+                           }
+
    /** Read access to the container holding the defined output labels.
     *
     * The container holds the valid labels defined during the last call of the Process
@@ -257,9 +293,6 @@ public:
 private:
 
    // Typedef privati.
-   typedef typename RepVector::const_iterator
-                        RepresentativeIterator;
-
    typedef std::iterator_traits<std::vector<RealType>::iterator>::difference_type
                         RealDiffType;
 
@@ -304,12 +337,16 @@ private:
                            ForwardIterator1  iSampleEnd,
                            ForwardIterator2  iLabelBegin);
 
-   /**
-    * Threads function
-    */
+   // Calcolo parallelo delle dissimilarità rappresentanti/campione corrente.
    template <typename ForwardIterator1>
-   void ThreadFunction(RepresentativeIterator* RepIt, ForwardIterator1* SampleIt);
+   void                 ComputeRepDiss(ForwardIterator1* pSampleIt);
 
+   // Dissimilarità del campione corrente dai rappresentanti [aFirst, aLast).
+   template <typename ForwardIterator1>
+   void                 ComputeRange(
+                           ForwardIterator1* pSampleIt,
+                           DissSizeType      aFirst,
+                           DissSizeType      aLast);
 
    // Funzione ausiliaria.
    void                 AlgoInit();
@@ -328,10 +365,6 @@ private:
    // Numero max etichette (= Q).
    LabelVectorSizeType  Q__;
 
-   // Iteratore rappresentanti.
-   RepresentativeIterator
-                        RepIt;
-
    // Iteratore dissimilarità.
    DissIterator         MinIt;
 
@@ -342,10 +375,9 @@ private:
    std::vector<RealType>
                         RepDiss;
 
-   //mutex
-   boost::mutex mMutex;
-   boost::mutex mAddMutex;
-
+   // Executor per il calcolo parallelo.
+   mutable boost::shared_ptr<Executor>
+                        mExecutor;
 
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
@@ -409,17 +441,7 @@ MTBsas<Representative, NThreads>::BasicClusterAnalysis(
    // Ciclo principale.
    while (iSampleEnd != It)
    {
-      boost::thread_group threadGroup;
-      RepDiss.clear();
-      RepIt= mRepresentatives.begin();
-
-
-      for(NaturalType i=0;i<NThreads;i++)
-          threadGroup.add_thread(new boost::thread(
-                  boost::bind(&MTBsas::ThreadFunction<ForwardIterator1>, this, &RepIt, &It)) );
-
-      threadGroup.join_all();
-
+      ComputeRepDiss(&It);
 
       MinIt= std::min_element(
                 RepDiss.begin(),
@@ -445,7 +467,6 @@ MTBsas<Representative, NThreads>::BasicClusterAnalysis(
 
       It++;
    } // ciclo principale
-
 }  // BasicClusterAnalysis
 
 template <typename Representative, NaturalType NThreads>
@@ -484,28 +505,16 @@ MTBsas<Representative, NThreads>::ModifiedClusterAnalysis(
    mRepresentatives.push_back( mRepInit );
    mRepresentatives.back().Update( *It++ );
 
-
    // Prima passata.
    while (iSampleEnd != It)
    {
-      boost::thread_group threadGroup;
-      RepDiss.clear();
-      RepIt= mRepresentatives.begin();
-
-      //threads
-      for(NaturalType i=0;i<NThreads;i++)
-          threadGroup.add_thread(new boost::thread(
-                          boost::bind(&MTBsas::ThreadFunction<ForwardIterator1>, this, &RepIt, &It)) );
-
-      threadGroup.join_all();
+      ComputeRepDiss(&It);
 
       MinIt= std::min_element(
                 RepDiss.begin(),
                 RepDiss.end() );
 
       MinDiss= *MinIt;
-      ClosestRep= boost::numeric::converter<LabelType, RealDiffType>
-                  ::convert( std::distance(RepDiss.begin(), MinIt) );
 
       //new representative
       if ( (MinDiss > mTheta) && (mRepresentatives.size() < Q_) )
@@ -532,17 +541,9 @@ MTBsas<Representative, NThreads>::ModifiedClusterAnalysis(
    // Seconda passata.
    while (iSampleEnd != It)
    {
-      boost::thread_group threadGroup;
       if (*Ot == Q_) // Non ancora assegnato.
       {
-         RepDiss.clear();
-         RepIt= mRepresentatives.begin();
-
-         for(NaturalType i=0;i<NThreads;i++)
-             threadGroup.add_thread(new boost::thread(
-                     boost::bind(&MTBsas::ThreadFunction<ForwardIterator1>, this, &RepIt, &It)) );
-
-         threadGroup.join_all();
+         ComputeRepDiss(&It);
 
          MinIt= std::min_element(
                    RepDiss.begin(),
@@ -559,44 +560,49 @@ MTBsas<Representative, NThreads>::ModifiedClusterAnalysis(
       Ot++;
       It++;
    } // seconda passata
-
 }  // ModifiedClusterAnalysis
 
 
-template <class Representative, NaturalType NThreads>
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+// Calcolo delle dissimilarità del campione corrente.
+template <typename Representative, NaturalType NThreads>
 template <typename ForwardIterator1>
-void MTBsas<Representative, NThreads>::ThreadFunction(RepresentativeIterator* RepIt, ForwardIterator1* SampleIt)
+void
+MTBsas<Representative, NThreads>::ComputeRepDiss(ForwardIterator1* pSampleIt)
 {
-    Representative localRep;
-    RealType localDiss=0;
-
-    do
-    {
-        mMutex.lock();
-        if(mRepresentatives.end()==(*RepIt))
-        {
-            mMutex.unlock();
-            break;
-        }
-        else
-        {
-            localRep=*(*RepIt);
-            (*RepIt)++;
-        }
-        mMutex.unlock();
-
-        //parallel computation of the Representative<->Sample dissimilarity
-        localDiss=localRep.Diss(*(*SampleIt));
-
-        mAddMutex.lock();
-        RepDiss.push_back(localDiss);
-        mAddMutex.unlock();
-
-    }while(true);
-}
+   using boost::placeholders::_1;
+   using boost::placeholders::_2;
 
+   // Variabili.
+   Executor&            Exec= *GetExecutor();
+   DissSizeType         Size= mRepresentatives.size();
 
-////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+   // Uno slot per rappresentante: l'ordine non dipende dai thread.
+   RepDiss.resize(Size);
+
+   // Un blocco contiguo di rappresentanti per thread.
+   Exec.ParallelFor(
+           0,
+           Size,
+           (Size + Exec.GetThreadCount() - 1) / Exec.GetThreadCount(),
+           boost::bind(&MTBsas::ComputeRange<ForwardIterator1>, this, pSampleIt, _1, _2) );
+}  // ComputeRepDiss
+
+// Calcolo delle dissimilarità di un blocco di rappresentanti.
+template <typename Representative, NaturalType NThreads>
+template <typename ForwardIterator1>
+void
+MTBsas<Representative, NThreads>::ComputeRange(
+                         ForwardIterator1* pSampleIt,
+                         DissSizeType      aFirst,
+                         DissSizeType      aLast)
+{
+   for (DissSizeType r= aFirst; r < aLast; r++)
+   {
+      RepDiss[r]= mRepresentatives[r].Diss(**pSampleIt);
+   }
+}  // ComputeRange
 
 // Funzione ausiliaria.
 template <typename Representative, NaturalType NThreads>
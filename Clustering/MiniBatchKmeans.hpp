@@ -0,0 +1,537 @@
+//  MiniBatchKmeans class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File MiniBatchKmeans.hpp, containing the %MiniBatchKmeans template class.
+ *
+ * The file contains the %MiniBatchKmeans template class, implementing the mini-batch variant
+ * of the K-means clustering algorithm ("Web-Scale K-Means Clustering", D. Sculley, 2010).
+ *
+ * @file MiniBatchKmeans.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _MiniBatchKmeans_h_
+#define _MiniBatchKmeans_h_
+
+// STD INCLUDES
+#include <iterator>
+#include <limits>
+#include <vector>
+
+// BOOST INCLUDES
+#include <boost/numeric/conversion/converter.hpp>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/vector.hpp>
+
+// SPARE INCLUDES
+#include <spare/BoundedParameter.hpp>
+#include <spare/Clustering/RepIndex/LinearScan.hpp>
+#include <spare/SpareExceptions.hpp>
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusion in namespace spare.
+
+/** @brief Mini-batch K-means clustering algorithm.
+ *
+ * %MiniBatchKmeans is a template class which models the @a Clustering concept, with the same
+ * template arguments of Kmeans: a class modeling the @a Representative concept, a Kmeans
+ * initialization policy (see the Clustering/KmeansInit folder) and, optionally, a class modeling
+ * the @a RepresentativeIndex concept.
+ * The samples are consumed in batches of BatchSize samples: each batch is first assigned to the
+ * current representatives, then every sample updates its representative. With the running mean
+ * update of Centroid, the j-th representative moves towards each sample with learning rate
+ * 1/n_j, where n_j is the number of samples it received so far (i.e. its GetCount value), as in
+ * the original algorithm.
+ * The samples can be supplied in chunks of any size through the Learn method, which requires
+ * only single pass input iterators and keeps in memory a single batch. The first chunk seeds
+ * the representatives with the initialization policy: it is copied and must contain at least
+ * K samples. The Process method runs MaxIter batches over a range, wrapping around it if
+ * needed, and then labels every sample with its closest representative: the number of sample
+ * visits is bounded by MaxIter * BatchSize plus the final labelling pass.
+ *
+ * <b>Parameter summary</b>
+ *  <table class="contents">
+ *  <tr>
+ *     <td class="indexkey"><b>Name</b></td>
+ *     <td class="indexkey"><b>Domain</b></td>
+ *     <td class="indexkey"><b>Description</b></td>
+ *     <td class="indexkey"><b>Const</b></td>
+ *     <td class="indexkey"><b>Default</b></td>
+ *  </tr>
+ *  <tr>
+ *     <td class="indexvalue">K</td>
+ *     <td class="indexvalue">[1, inf)</td>
+ *     <td class="indexvalue">Number of clusters to generate.</td>
+ *     <td class="indexvalue">No</td>
+ *     <td class="indexvalue">2</td>
+ *  </tr>
+ *  <tr>
+ *     <td class="indexvalue">BatchSize</td>
+ *     <td class="indexvalue">[1, inf)</td>
+ *     <td class="indexvalue">Number of samples per batch.</td>
+ *     <td class="indexvalue">No</td>
+ *     <td class="indexvalue">100</td>
+ *  </tr>
+ *  <tr>
+ *     <td class="indexvalue">MaxIter</td>
+ *     <td class="indexvalue">[1, inf)</td>
+ *     <td class="indexvalue">Number of batches processed by the Process method.</td>
+ *     <td class="indexvalue">No</td>
+ *     <td class="indexvalue">100</td>
+ *  </tr>
+ *  </table>
+ */
+template <typename Representative, typename Initialization,
+          typename RepIndex= LinearScan<Representative> >
+class MiniBatchKmeans
+{
+public:
+
+// PUBLIC TYPES
+
+   /** Type of container storing the generated representatives.
+    */
+   typedef std::vector<Representative>
+                        RepVector;
+
+   /** Type of label type assigned to the processed samples.
+    */
+   typedef typename RepVector::size_type
+                        LabelType;
+
+   /** Container of the defined output labels.
+    */
+   typedef std::vector<LabelType>
+                        LabelVector;
+
+   /** Integer parameter.
+    */
+   typedef BoundedParameter<NaturalType>
+                        NaturalParam;
+
+// LIFECYCLE
+
+   /** Default constructor.
+    */
+   MiniBatchKmeans()
+      : mK( 1, std::numeric_limits<NaturalType>::max() ),
+        mBatchSize( 1, std::numeric_limits<NaturalType>::max() ),
+        mMaxIter( 1, std::numeric_limits<NaturalType>::max() )
+                           {
+                              mK= 2;
+                              mBatchSize= 100;
+                              mMaxIter= 100;
+                           }
+
+// OPERATIONS
+
+   /** Cluster analysis execution.
+    *
+    * The representatives are reset and seeded on the whole range, MaxIter batches are
+    * learned, then all the samples are labelled.
+    *
+    * @param[in] iSampleBegin Iterator pointing to the first sample.
+    * @param[in] iSampleEnd Iterator pointing to the first position after the last sample.
+    * @param[out] iLabelBegin Iterator pointing to the first label.
+    */
+   template <typename ForwardIterator1, typename ForwardIterator2>
+   void                 Process(
+                           ForwardIterator1  iSampleBegin,
+                           ForwardIterator1  iSampleEnd,
+                           ForwardIterator2  iLabelBegin);
+
+   /** Learning of a chunk of samples.
+    *
+    * If the representatives have not been seeded yet, the chunk is first used by the
+    * initialization policy. The chunk is then processed in batches of BatchSize samples (the
+    * last batch can be smaller).
+    *
+    * @param[in] iSampleBegin Iterator pointing to the first sample of the chunk.
+    * @param[in] iSampleEnd Iterator pointing to the first position after the last sample.
+    */
+   template <typename InputIterator>
+   void                 Learn(
+                           InputIterator     iSampleBegin,
+                           InputIterator     iSampleEnd);
+
+   /** Labelling of samples with the current representatives.
+    *
+    * @param[in] iSampleBegin Iterator pointing to the first sample.
+    * @param[in] iSampleEnd Iterator pointing to the first position after the last sample.
+    * @param[out] iLabelBegin Iterator pointing to the first label.
+    */
+   template <typename InputIterator, typename OutputIterator>
+   void                 Assign(
+                           InputIterator     iSampleBegin,
+                           InputIterator     iSampleEnd,
+                           OutputIterator    iLabelBegin) const;
+
+   /** Removal of the current representatives, so that the next chunk seeds new ones.
+    */
+   void                 Reset()                    {
+                                                      mRepresentatives.clear();
+                                                      mLabels.clear();
+                                                      mIndex.Clear();
+                                                   }
+
+// ACCESS
+
+   /** Read/write access to the K parameter.
+    *
+    * @return A reference to the K parameter.
+    */
+   NaturalParam&        K()                        { return mK; }
+
+   /** Read only access to the K parameter.
+    *
+    * @return A const reference to the K parameter.
+    */
+   const NaturalParam&  K() const                  { return mK; }
+
+   /** Read/write access to the BatchSize parameter.
+    *
+    * @return A reference to the BatchSize parameter.
+    */
+   NaturalParam&        BatchSize()                { return mBatchSize; }
+
+   /** Read only access to the BatchSize parameter.
+    *
+    * @return A const reference to the BatchSize parameter.
+    */
+   const NaturalParam&  BatchSize() const          { return mBatchSize; }
+
+   /** Read/write access to the MaxIter parameter.
+    *
+    * @return A reference to the MaxIter parameter.
+    */
+   NaturalParam&        MaxIter()                  { return mMaxIter; }
+
+   /** Read only access to the MaxIter parameter.
+    *
+    * @return A const reference to the MaxIter parameter.
+    */
+   const NaturalParam&  MaxIter() const            { return mMaxIter; }
+
+   /** Read/write access to the initialization algorithm for the first K representatives.
+    *
+    * @return A reference to the instance.
+    */
+   Initialization&      Init()                     { return mInit; }
+
+   /** Read only access to the initialization algorithm for the first K representatives.
+    *
+    * @return A const reference to the instance.
+    */
+   const Initialization&
+                        Init() const               { return mInit; }
+
+   /** Read/write access to the representative initialization object.
+    *
+    * @return A reference to the instance.
+    */
+   Representative&      RepInit()                  { return mRepInit; }
+
+   /** Read only access to the representative intialization object.
+    *
+    * @return A const reference to the instance.
+    */
+   const Representative&
+                        RepInit() const            { return mRepInit; }
+
+   /** Read/write access to the representative index.
+    *
+    * @return A reference to the instance.
+    */
+   RepIndex&            Index()                    { return mIndex; }
+
+   /** Read only access to the representative index.
+    *
+    * @return A const reference to the instance.
+    */
+   const RepIndex&      Index() const              { return mIndex; }
+
+   /** Read access to the container holding the defined output labels.
+    *
+    * @return A const reference to the container of the defined labels.
+    */
+   const LabelVector&   GetLabels() const          { return mLabels; }
+
+   /** Read access to the container holding the generated representatives.
+    *
+    * The container holds the representatives associated with the labels returned by the
+    * GetLabels method, in the same order.
+    *
+    * @return A const reference to the container of the generated representatives.
+    */
+   const RepVector&     GetRepresentatives() const { return mRepresentatives; }
+
+private:
+
+   // Numero di cluster.
+   NaturalParam         mK;
+
+   // Dimensione dei batch.
+   NaturalParam         mBatchSize;
+
+   // Numero di batch elaborati da Process.
+   NaturalParam         mMaxIter;
+
+   // Inizializzatore cluster.
+   Representative       mRepInit;
+
+   // Inizializzazione dei rappresentanti.
+   Initialization       mInit;
+
+   // Rappresentanti memorizzati internamente.
+   RepVector            mRepresentatives;
+
+   // Lista etichette rappresentanti.
+   LabelVector          mLabels;
+
+   // Indice per la ricerca del rappresentante più vicino.
+   RepIndex             mIndex;
+
+   // Etichette del batch corrente.
+   LabelVector          mBatchLabels;
+
+   // Inizializzazione dei rappresentanti sul primo blocco di campioni.
+   template <typename ForwardIterator>
+   void                 Seed(
+                           ForwardIterator   iSampleBegin,
+                           ForwardIterator   iSampleEnd);
+
+   // Elaborazione a batch di un blocco di campioni.
+   template <typename InputIterator>
+   void                 LearnBatches(
+                           InputIterator     iSampleBegin,
+                           InputIterator     iSampleEnd);
+
+   // Elaborazione di un batch già etichettato.
+   template <typename ForwardIterator>
+   void                 UpdateBatch(ForwardIterator iSampleBegin);
+
+   // BOOST SERIALIZATION
+   friend class boost::serialization::access;
+
+   template<class Archive>
+   void serialize(Archive & ar, const unsigned int version)
+   {
+      ar & mK;
+      ar & mBatchSize;
+      ar & mMaxIter;
+      ar & mRepInit;
+      ar & mRepresentatives;
+      ar & mLabels;
+
+      if (Archive::is_loading::value)
+      {
+         mIndex.Clear();
+         mIndex.Rebuild(mRepresentatives);
+      }
+   } // BOOST SERIALIZATION
+
+}; // class MiniBatchKmeans
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+////////////////////////////////////// PUBLIC //////////////////////////////////////////////
+
+//==================================== OPERATIONS ==========================================
+
+template <typename Representative, typename Initialization, typename RepIndex>
+template <typename ForwardIterator1, typename ForwardIterator2>
+void
+MiniBatchKmeans<Representative, Initialization, RepIndex>::Process(
+                            ForwardIterator1  iSampleBegin,
+                            ForwardIterator1  iSampleEnd,
+                            ForwardIterator2  iLabelBegin)
+{
+   // Variabili.
+   ForwardIterator1     It;           // Iteratore principale dati.
+   ForwardIterator1     BatchIt;      // Primo campione del batch.
+   RealType             MinDiss;      // Minima dissimilarità campione-cluster.
+   NaturalType          Iter;         // Contatore batch.
+   NaturalType          n;            // Contatore campioni del batch.
+
+   if (iSampleBegin == iSampleEnd)
+   {
+      throw SpareLogicError("MiniBatchKmeans, 0, Invalid sample range.");
+   }
+
+   Reset();
+   Seed(iSampleBegin, iSampleEnd);
+
+   // Batch consecutivi, ricominciando dal primo campione a fine intervallo.
+   It= iSampleBegin;
+   for (Iter= 0; Iter < mMaxIter; Iter++)
+   {
+      BatchIt= It;
+      mBatchLabels.clear();
+      for (n= 0; n < mBatchSize; n++)
+      {
+         if (iSampleEnd == It)
+         {
+            // Il batch non attraversa la fine dell'intervallo.
+            break;
+         }
+
+         mBatchLabels.push_back( mIndex.Closest(mRepresentatives, *It++, MinDiss) );
+      }
+
+      UpdateBatch(BatchIt);
+
+      if (iSampleEnd == It)
+      {
+         It= iSampleBegin;
+      }
+   }
+
+   Assign(iSampleBegin, iSampleEnd, iLabelBegin);
+}  // Process
+
+template <typename Representative, typename Initialization, typename RepIndex>
+template <typename InputIterator>
+void
+MiniBatchKmeans<Representative, Initialization, RepIndex>::Learn(
+                            InputIterator     iSampleBegin,
+                            InputIterator     iSampleEnd)
+{
+   // Typedef locali.
+   typedef typename std::iterator_traits<InputIterator>::value_type
+                        SampleType;
+
+   // Il primo blocco è copiato: serve all'inizializzazione e poi all'apprendimento.
+   if ( mRepresentatives.empty() )
+   {
+      std::vector<SampleType> Chunk(iSampleBegin, iSampleEnd);
+
+      Seed( Chunk.begin(), Chunk.end() );
+      LearnBatches( Chunk.begin(), Chunk.end() );
+   }
+   else
+   {
+      LearnBatches(iSampleBegin, iSampleEnd);
+   }
+}  // Learn
+
+template <typename Representative, typename Initialization, typename RepIndex>
+template <typename InputIterator, typename OutputIterator>
+void
+MiniBatchKmeans<Representative, Initialization, RepIndex>::Assign(
+                            InputIterator     iSampleBegin,
+                            InputIterator     iSampleEnd,
+                            OutputIterator    iLabelBegin) const
+{
+   RealType             MinDiss;
+
+   if ( mRepresentatives.empty() )
+   {
+      throw SpareLogicError("MiniBatchKmeans, 1, Uninitialized object.");
+   }
+
+   while (iSampleEnd != iSampleBegin)
+   {
+      (*iLabelBegin++)= mIndex.Closest(mRepresentatives, *iSampleBegin++, MinDiss);
+   }
+}  // Assign
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+template <typename Representative, typename Initialization, typename RepIndex>
+template <typename InputIterator>
+void
+MiniBatchKmeans<Representative, Initialization, RepIndex>::LearnBatches(
+                            InputIterator     iSampleBegin,
+                            InputIterator     iSampleEnd)
+{
+   // Typedef locali.
+   typedef typename std::iterator_traits<InputIterator>::value_type
+                        SampleType;
+
+   // Variabili.
+   std::vector<SampleType>
+                        Batch;        // Copia del batch corrente.
+   RealType             MinDiss;      // Minima dissimilarità campione-cluster.
+
+   // I campioni sono copiati, così da richiedere una sola passata sul blocco.
+   Batch.reserve(mBatchSize);
+   while (iSampleEnd != iSampleBegin)
+   {
+      Batch.clear();
+      mBatchLabels.clear();
+      while ( (iSampleEnd != iSampleBegin) && (Batch.size() < mBatchSize) )
+      {
+         Batch.push_back(*iSampleBegin++);
+         mBatchLabels.push_back( mIndex.Closest(mRepresentatives, Batch.back(), MinDiss) );
+      }
+
+      UpdateBatch( Batch.begin() );
+   }
+}  // LearnBatches
+
+template <typename Representative, typename Initialization, typename RepIndex>
+template <typename ForwardIterator>
+void
+MiniBatchKmeans<Representative, Initialization, RepIndex>::Seed(
+                            ForwardIterator   iSampleBegin,
+                            ForwardIterator   iSampleEnd)
+{
+   // Typedef locali.
+   typedef typename std::iterator_traits<ForwardIterator>::difference_type
+                        SampleDiffType;
+
+   // Variabili.
+   LabelType            K_;           // Valore K.
+
+   K_= boost::numeric::converter<LabelType, NaturalType>::convert(mK);
+
+   // Controllo se ho almeno K campioni.
+   if ( std::distance(iSampleBegin, iSampleEnd) < static_cast<SampleDiffType>(mK) )
+   {
+      throw SpareLogicError("MiniBatchKmeans, 2, Less than K samples for seeding.");
+   }
+
+   mRepresentatives.assign(K_, mRepInit);
+   mInit.Initialize(K_, iSampleBegin, iSampleEnd, mRepresentatives);
+
+   mLabels.resize(K_);
+   for (LabelType j= 0; j < K_; j++)
+   {
+      mLabels[j]= j;
+   }
+
+   mIndex.Clear();
+   mIndex.Rebuild(mRepresentatives);
+}  // Seed
+
+template <typename Representative, typename Initialization, typename RepIndex>
+template <typename ForwardIterator>
+void
+MiniBatchKmeans<Representative, Initialization, RepIndex>::UpdateBatch(
+                            ForwardIterator   iSampleBegin)
+{
+   // Aggiornamento con le assegnazioni calcolate sui rappresentanti del batch precedente.
+   for (typename LabelVector::size_type i= 0; i < mBatchLabels.size(); i++)
+   {
+      mRepresentatives[ mBatchLabels[i] ].Update(*iSampleBegin++);
+   }
+
+   mIndex.Rebuild(mRepresentatives);
+}  // UpdateBatch
+
+}  // namespace spare
+
+#endif  // _MiniBatchKmeans_h_
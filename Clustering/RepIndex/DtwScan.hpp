@@ -0,0 +1,210 @@
+//  DtwScan class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File DtwScan.hpp, containing the DtwScan template class.
+ *
+ * The file contains the DtwScan template class, a representative index for MinSod
+ * representatives of sequences under the Dtw dissimilarity.
+ *
+ * @file DtwScan.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _DtwScan_h_
+#define _DtwScan_h_
+
+// BOOST INCLUDES
+#include <boost/serialization/access.hpp>
+
+// SPARE INCLUDES
+#include <spare/Dissimilarity/BoundedDiss.hpp>
+#include <spare/Dissimilarity/DtwCascade.hpp>
+#include <spare/SpareExceptions.hpp>
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusione in namespace spare.
+
+template <typename Representative>
+class DtwScan;
+
+/** @brief Lower bounded closest representative search for Dtw.
+ *
+ * %DtwScan models the @a RepresentativeIndex concept (see LinearScan) for MinSod
+ * representatives whose dissimilarity is a Dtw. The index keeps a DtwCascade on the MinSod
+ * samples of the representatives: the search scans the representatives as LinearScan does,
+ * but skips those whose lower bounds (LB_Kim, LB_Keogh) exceed the best dissimilarity found so
+ * far, and evaluates the others with the bounded Dtw. The result is the same of LinearScan.
+ * The envelopes are computed on Insert, Refresh and Rebuild, with the window set at that time.
+ */
+template <typename SampleType, typename Dissimilarity>
+class DtwScan< MinSod<SampleType, Dissimilarity> >
+{
+public:
+
+// OPERATIONS
+
+   /** Removal of every indexed representative.
+    */
+   void                 Clear()                    { mCascade.Clear(); }
+
+   /** Notification of a new representative.
+    *
+    * @param[in] rReps Container of the representatives.
+    * @param[in] aIndex Position of the new representative.
+    */
+   template <typename RepVector>
+   void                 Insert(
+                           const RepVector&                 rReps,
+                           typename RepVector::size_type    aIndex)
+                           {
+                              if (aIndex == mCascade.Size())
+                              {
+                                 mCascade.Insert(
+                                    rReps[aIndex].DissAgent(),
+                                    rReps[aIndex].GetMinSodSample() );
+                              }
+                              else
+                              {
+                                 Rebuild(rReps);
+                              }
+                           }
+
+   /** Notification of an updated representative.
+    *
+    * @param[in] rReps Container of the representatives.
+    * @param[in] aIndex Position of the updated representative.
+    */
+   template <typename RepVector>
+   void                 Refresh(
+                           const RepVector&                 rReps,
+                           typename RepVector::size_type    aIndex)
+                           {
+                              if (aIndex < mCascade.Size())
+                              {
+                                 mCascade.Update(
+                                    aIndex,
+                                    rReps[aIndex].DissAgent(),
+                                    rReps[aIndex].GetMinSodSample() );
+                              }
+                              else
+                              {
+                                 Rebuild(rReps);
+                              }
+                           }
+
+   /** Notification of a change of the whole container of representatives.
+    *
+    * @param[in] rReps Container of the representatives.
+    */
+   template <typename RepVector>
+   void                 Rebuild(const RepVector& rReps);
+
+   /** Closest representative search.
+    *
+    * @param[in] rReps Container of the representatives (not empty).
+    * @param[in] rSample The sample.
+    * @param[out] rMinDiss Dissimilarity between the sample and the closest representative.
+    * @return The position of the closest representative.
+    */
+   template <typename RepVector>
+   typename RepVector::size_type
+                        Closest(
+                           const RepVector&  rReps,
+                           const SampleType& rSample,
+                           RealType&         rMinDiss) const;
+
+private:
+
+   // Typedef privati.
+   typedef DtwCascade<Dissimilarity>
+                        Cascade;
+
+   // Limiti inferiori sui campioni MinSod dei rappresentanti.
+   Cascade              mCascade;
+
+   // BOOST SERIALIZATION
+   friend class boost::serialization::access;
+
+   template<class Archive>
+   void serialize(Archive &, const unsigned int)
+   {
+   } // BOOST SERIALIZATION
+
+}; // class DtwScan
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+////////////////////////////////////// PUBLIC //////////////////////////////////////////////
+
+//==================================== OPERATIONS ==========================================
+
+template <typename SampleType, typename Dissimilarity>
+template <typename RepVector>
+void
+DtwScan< MinSod<SampleType, Dissimilarity> >::Rebuild(const RepVector& rReps)
+{
+   mCascade.Clear();
+
+   for (typename RepVector::size_type r= 0; r < rReps.size(); r++)
+   {
+      mCascade.Insert(rReps[r].DissAgent(), rReps[r].GetMinSodSample());
+   }
+}  // Rebuild
+
+template <typename SampleType, typename Dissimilarity>
+template <typename RepVector>
+typename RepVector::size_type
+DtwScan< MinSod<SampleType, Dissimilarity> >::Closest(
+                                                const RepVector&  rReps,
+                                                const SampleType& rSample,
+                                                RealType&         rMinDiss) const
+{
+   // Variabili.
+   typename RepVector::size_type    Closest_= 0;
+   typename Cascade::Envelope       Query;
+   RealType                         Diss;
+
+   if ( rReps.empty() )
+   {
+      throw SpareLogicError("DtwScan, 0, No representatives.");
+   }
+
+   mCascade.Prepare(rReps[0].DissAgent(), rSample, Query);
+
+   rMinDiss= rReps[0].Diss(rSample);
+   for (typename RepVector::size_type r= 1; r < rReps.size(); r++)
+   {
+      // Rappresentanti scartati dai limiti inferiori.
+      if ( (r < mCascade.Size()) &&
+           mCascade.Prune(rReps[r].DissAgent(), Query, r, rMinDiss) )
+      {
+         continue;
+      }
+
+      Diss= BoundedDiss(rReps[r], rSample, rMinDiss);
+      if (Diss < rMinDiss)
+      {
+         rMinDiss= Diss;
+         Closest_= r;
+      }
+   }
+
+   return Closest_;
+}  // Closest
+
+}  // namespace spare
+
+#endif  // _DtwScan_h_
@@ -0,0 +1,166 @@
+//  LinearScan class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File LinearScan.hpp, containing the LinearScan template class.
+ *
+ * The file contains the LinearScan template class, the default representative index used by
+ * the clustering algorithms for the closest representative search.
+ *
+ * @file LinearScan.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _LinearScan_h_
+#define _LinearScan_h_
+
+// STD INCLUDES
+#include <limits>
+
+// BOOST INCLUDES
+#include <boost/serialization/access.hpp>
+
+// SPARE INCLUDES
+#include <spare/Dissimilarity/BoundedDiss.hpp>
+#include <spare/Dissimilarity/SquaredDiss.hpp>
+#include <spare/SpareExceptions.hpp>
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusione in namespace spare.
+
+/** @brief Exhaustive closest representative search.
+ *
+ * This class models the @a RepresentativeIndex concept, which is used by the clustering
+ * algorithms to find the representative closest to a sample. The index is notified when a
+ * representative is inserted (Insert), when a representative has been updated (Refresh) and
+ * when the whole container has changed (Rebuild). The Closest method returns the index of the
+ * first representative with minimum dissimilarity, as std::min_element would do. The Closest
+ * method must be safe for concurrent calls.
+ * %LinearScan evaluates the dissimilarity of the sample from every representative and keeps
+ * no internal state. Representatives providing a bounded dissimilarity (see HasBoundedDiss)
+ * are evaluated with the best value found so far as bound; representatives providing a squared
+ * dissimilarity (see HasSquaredDiss) are compared on the squared values, and the square root
+ * is taken only for the closest one.
+ */
+template <typename Representative>
+class LinearScan
+{
+public:
+
+// OPERATIONS
+
+   /** Removal of every indexed representative.
+    */
+   void                 Clear()                    { }
+
+   /** Notification of a new representative.
+    *
+    * @param[in] rReps Container of the representatives.
+    * @param[in] aIndex Position of the new representative.
+    */
+   template <typename RepVector>
+   void                 Insert(
+                           const RepVector&,
+                           typename RepVector::size_type)
+                                                   { }
+
+   /** Notification of an updated representative.
+    *
+    * @param[in] rReps Container of the representatives.
+    * @param[in] aIndex Position of the updated representative.
+    */
+   template <typename RepVector>
+   void                 Refresh(
+                           const RepVector&,
+                           typename RepVector::size_type)
+                                                   { }
+
+   /** Notification of a change of the whole container of representatives.
+    *
+    * @param[in] rReps Container of the representatives.
+    */
+   template <typename RepVector>
+   void                 Rebuild(const RepVector&)
+                                                   { }
+
+   /** Closest representative search.
+    *
+    * @param[in] rReps Container of the representatives (not empty).
+    * @param[in] rSample The sample.
+    * @param[out] rMinDiss Dissimilarity between the sample and the closest representative.
+    * @return The position of the closest representative.
+    */
+   template <typename RepVector, typename SampleType>
+   typename RepVector::size_type
+                        Closest(
+                           const RepVector&  rReps,
+                           const SampleType& rSample,
+                           RealType&         rMinDiss) const;
+
+private:
+
+   // BOOST SERIALIZATION
+   friend class boost::serialization::access;
+
+   template<class Archive>
+   void serialize(Archive &, const unsigned int)
+   {
+   } // BOOST SERIALIZATION
+
+}; // class LinearScan
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+////////////////////////////////////// PUBLIC //////////////////////////////////////////////
+
+//==================================== OPERATIONS ==========================================
+
+template <typename Representative>
+template <typename RepVector, typename SampleType>
+typename RepVector::size_type
+LinearScan<Representative>::Closest(
+                              const RepVector&  rReps,
+                              const SampleType& rSample,
+                              RealType&         rMinDiss) const
+{
+   // Variabili.
+   typename RepVector::size_type    Closest_= 0;
+   RealType                         Diss;
+
+   if ( rReps.empty() )
+   {
+      throw SpareLogicError("LinearScan, 0, No representatives.");
+   }
+
+   // Confronto sulle dissimilarità comparabili (al quadrato, se disponibili).
+   rMinDiss= ComparableDiss(rReps[0], rSample, std::numeric_limits<RealType>::max());
+   for (typename RepVector::size_type r= 1; r < rReps.size(); r++)
+   {
+      Diss= ComparableDiss(rReps[r], rSample, rMinDiss);
+      if (Diss < rMinDiss)
+      {
+         rMinDiss= Diss;
+         Closest_= r;
+      }
+   }
+
+   rMinDiss= ComparableToDiss<Representative>(rMinDiss);
+
+   return Closest_;
+}  // Closest
+
+}  // namespace spare
+
+#endif  // _LinearScan_h_
@@ -0,0 +1,383 @@
+//  PivotTable class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File PivotTable.hpp, containing the PivotTable template class.
+ *
+ * The file contains the PivotTable template class, a representative index pruning the
+ * closest representative search by means of the triangle inequality.
+ *
+ * @file PivotTable.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _PivotTable_h_
+#define _PivotTable_h_
+
+// STD INCLUDES
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// BOOST INCLUDES
+#include <boost/serialization/access.hpp>
+
+// SPARE INCLUDES
+#include <spare/BoundedParameter.hpp>
+#include <spare/Dissimilarity/BoundedDiss.hpp>
+#include <spare/Dissimilarity/MetricTraits.hpp>
+#include <spare/Dissimilarity/SquaredDiss.hpp>
+#include <spare/SpareExceptions.hpp>
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusione in namespace spare.
+
+/** @brief Pivot based closest representative search.
+ *
+ * %PivotTable models the @a RepresentativeIndex concept (see LinearScan). The index stores a
+ * copy of the first NumPivots inserted representatives, called @a pivots, and, for every
+ * representative, its dissimilarities from the pivots. When searching for the representative
+ * closest to a sample x, the dissimilarities d(x, p) from the pivots are evaluated first; then,
+ * for a metric dissimilarity, |d(x, p) - d(r, p)| is a lower bound of d(x, r) and the
+ * representatives whose bound exceeds the best dissimilarity found so far are skipped. The
+ * result is the same of an exhaustive search, including the first-minimum tie breaking.
+ * The pivots are frozen copies, so that the update of a representative only requires the
+ * evaluation of its own row of the table (Refresh). The Representative class must provide a
+ * Diss method accepting another representative, and the pruning is enabled only if
+ * IsMetric<Representative> holds; otherwise, or when the representatives are not more than
+ * the pivots, the search is exhaustive and compares the dissimilarities as LinearScan does.
+ *
+ * <b>Parameter summary</b>
+ *  <table class="contents">
+ *  <tr>
+ *     <td class="indexkey"><b>Name</b></td>
+ *     <td class="indexkey"><b>Domain</b></td>
+ *     <td class="indexkey"><b>Description</b></td>
+ *     <td class="indexkey"><b>Const</b></td>
+ *     <td class="indexkey"><b>Default</b></td>
+ *  </tr>
+ *  <tr>
+ *     <td class="indexvalue">NumPivots</td>
+ *     <td class="indexvalue">[1, inf)</td>
+ *     <td class="indexvalue">Maximum number of pivots.</td>
+ *     <td class="indexvalue">No</td>
+ *     <td class="indexvalue">8</td>
+ *  </tr>
+ *  </table>
+ */
+template <typename Representative>
+class PivotTable
+{
+public:
+
+// PUBLIC TYPES
+
+   /** Integer parameter.
+    */
+   typedef BoundedParameter<NaturalType>
+                        NaturalParam;
+
+// LIFECYCLE
+
+   /** Default constructor.
+    */
+   PivotTable()
+      : mNumPivots( 1, std::numeric_limits<NaturalType>::max() )
+                                                   { mNumPivots= 8; }
+
+// OPERATIONS
+
+   /** Removal of every indexed representative and pivot.
+    */
+   void                 Clear()                    {
+                                                      mPivots.clear();
+                                                      mTable.clear();
+                                                   }
+
+   /** Notification of a new representative.
+    *
+    * @param[in] rReps Container of the representatives.
+    * @param[in] aIndex Position of the new representative.
+    */
+   template <typename RepVector>
+   void                 Insert(
+                           const RepVector&                 rReps,
+                           typename RepVector::size_type    aIndex);
+
+   /** Notification of an updated representative.
+    *
+    * @param[in] rReps Container of the representatives.
+    * @param[in] aIndex Position of the updated representative.
+    */
+   template <typename RepVector>
+   void                 Refresh(
+                           const RepVector&                 rReps,
+                           typename RepVector::size_type    aIndex)
+                                                   {
+                                                      if ( !mPivots.empty() )
+                                                      {
+                                                         ComputeRow(rReps, aIndex);
+                                                      }
+                                                   }
+
+   /** Notification of a change of the whole container of representatives.
+    *
+    * The current pivots are kept; if there are none, the first NumPivots representatives
+    * are selected.
+    *
+    * @param[in] rReps Container of the representatives.
+    */
+   template <typename RepVector>
+   void                 Rebuild(const RepVector& rReps);
+
+   /** Closest representative search.
+    *
+    * @param[in] rReps Container of the representatives (not empty).
+    * @param[in] rSample The sample.
+    * @param[out] rMinDiss Dissimilarity between the sample and the closest representative.
+    * @return The position of the closest representative.
+    */
+   template <typename RepVector, typename SampleType>
+   typename RepVector::size_type
+                        Closest(
+                           const RepVector&  rReps,
+                           const SampleType& rSample,
+                           RealType&         rMinDiss) const;
+
+// ACCESS
+
+   /** Read/write access to the NumPivots parameter.
+    *
+    * @return A reference to the NumPivots parameter.
+    */
+   NaturalParam&        NumPivots()                { return mNumPivots; }
+
+   /** Read only access to the NumPivots parameter.
+    *
+    * @return A const reference to the NumPivots parameter.
+    */
+   const NaturalParam&  NumPivots() const          { return mNumPivots; }
+
+private:
+
+   // Typedef privati.
+   typedef std::vector<RealType>
+                        DissRow;
+
+   typedef std::vector<DissRow>::size_type
+                        RowSizeType;
+
+   // Massimo numero di pivot.
+   NaturalParam         mNumPivots;
+
+   // Copie congelate dei pivot.
+   std::vector<Representative>
+                        mPivots;
+
+   // Dissimilarità rappresentanti/pivot, una riga per rappresentante.
+   std::vector<DissRow> mTable;
+
+   // Calcolo della riga di un rappresentante.
+   template <typename RepVector>
+   void                 ComputeRow(
+                           const RepVector&                 rReps,
+                           typename RepVector::size_type    aIndex);
+
+   // BOOST SERIALIZATION
+   friend class boost::serialization::access;
+
+   template<class Archive>
+   void serialize(Archive & ar, const unsigned int version)
+   {
+      ar & mNumPivots;
+   } // BOOST SERIALIZATION
+
+}; // class PivotTable
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+////////////////////////////////////// PUBLIC //////////////////////////////////////////////
+
+//==================================== OPERATIONS ==========================================
+
+template <typename Representative>
+template <typename RepVector>
+void
+PivotTable<Representative>::Insert(
+                              const RepVector&                 rReps,
+                              typename RepVector::size_type    aIndex)
+{
+   // Indice inutile per dissimilarità non metriche.
+   if (!IsMetric<Representative>::value)
+   {
+      return;
+   }
+
+   // Nuovo pivot: estendo le righe esistenti.
+   if (mPivots.size() < mNumPivots)
+   {
+      mPivots.push_back( rReps[aIndex] );
+      for (RowSizeType r= 0; r < mTable.size(); r++)
+      {
+         mTable[r].push_back( rReps[r].Diss( mPivots.back() ) );
+      }
+   }
+
+   ComputeRow(rReps, aIndex);
+}  // Insert
+
+template <typename Representative>
+template <typename RepVector>
+void
+PivotTable<Representative>::Rebuild(const RepVector& rReps)
+{
+   if (!IsMetric<Representative>::value)
+   {
+      return;
+   }
+
+   // Scelgo i pivot se non ancora presenti.
+   if ( mPivots.empty() )
+   {
+      for (typename RepVector::size_type r= 0;
+           (r < rReps.size()) && (mPivots.size() < mNumPivots); r++)
+      {
+         mPivots.push_back( rReps[r] );
+      }
+   }
+
+   mTable.clear();
+   for (typename RepVector::size_type r= 0; r < rReps.size(); r++)
+   {
+      ComputeRow(rReps, r);
+   }
+}  // Rebuild
+
+template <typename Representative>
+template <typename RepVector, typename SampleType>
+typename RepVector::size_type
+PivotTable<Representative>::Closest(
+                              const RepVector&  rReps,
+                              const SampleType& rSample,
+                              RealType&         rMinDiss) const
+{
+   // Typedef locali.
+   typedef typename RepVector::size_type
+                        RepSizeType;
+
+   // Variabili.
+   RepSizeType          Closest_= 0;
+   RepSizeType          R= rReps.size();
+   RealType             Diss;
+
+   if ( rReps.empty() )
+   {
+      throw SpareLogicError("PivotTable, 0, No representatives.");
+   }
+
+   // Ricerca esaustiva se non conviene (o non è lecito) potare, come LinearScan.
+   if ( (!IsMetric<Representative>::value) || (R <= mPivots.size()) || (mTable.size() != R) )
+   {
+      rMinDiss= ComparableDiss(rReps[0], rSample, std::numeric_limits<RealType>::max());
+      for (RepSizeType r= 1; r < R; r++)
+      {
+         Diss= ComparableDiss(rReps[r], rSample, rMinDiss);
+         if (Diss < rMinDiss)
+         {
+            rMinDiss= Diss;
+            Closest_= r;
+         }
+      }
+
+      rMinDiss= ComparableToDiss<Representative>(rMinDiss);
+
+      return Closest_;
+   }
+
+   // Dissimilarità campione/pivot.
+   DissRow              PivotDiss( mPivots.size() );
+   for (RowSizeType p= 0; p < mPivots.size(); p++)
+   {
+      PivotDiss[p]= mPivots[p].Diss(rSample);
+   }
+
+   // Limiti inferiori.
+   DissRow              Bound(R, 0);
+   for (RepSizeType r= 0; r < R; r++)
+   {
+      for (RowSizeType p= 0; p < mPivots.size(); p++)
+      {
+         Diss= std::fabs(PivotDiss[p] - mTable[r][p]);
+         if (Diss > Bound[r])
+         {
+            Bound[r]= Diss;
+         }
+      }
+
+      if (Bound[r] < Bound[Closest_])
+      {
+         Closest_= r;
+      }
+   }
+
+   // Parto dal rappresentante più promettente.
+   rMinDiss= rReps[Closest_].Diss(rSample);
+   for (RepSizeType r= 0; r < R; r++)
+   {
+      if ( (r == Closest_) || (Bound[r] > rMinDiss) )
+      {
+         continue;
+      }
+
+      Diss= BoundedDiss(rReps[r], rSample, rMinDiss);
+      if ( (Diss < rMinDiss) || ( (Diss == rMinDiss) && (r < Closest_) ) )
+      {
+         rMinDiss= Diss;
+         Closest_= r;
+      }
+   }
+
+   return Closest_;
+}  // Closest
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+template <typename Representative>
+template <typename RepVector>
+void
+PivotTable<Representative>::ComputeRow(
+                              const RepVector&                 rReps,
+                              typename RepVector::size_type    aIndex)
+{
+   if (!IsMetric<Representative>::value)
+   {
+      return;
+   }
+
+   if (mTable.size() <= aIndex)
+   {
+      mTable.resize(aIndex + 1);
+   }
+
+   mTable[aIndex].resize( mPivots.size() );
+   for (RowSizeType p= 0; p < mPivots.size(); p++)
+   {
+      mTable[aIndex][p]= rReps[aIndex].Diss( mPivots[p] );
+   }
+}  // ComputeRow
+
+}  // namespace spare
+
+#endif  // _PivotTable_h_
@@ -0,0 +1,154 @@
+//  BoundedDiss traits, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File BoundedDiss.hpp, containing the bounded dissimilarity trait and helpers.
+ *
+ * The file contains the HasBoundedDiss trait, declaring which dissimilarity measures (and
+ * representatives) provide a bounded Diss overload, and the BoundedDiss helpers, which call
+ * the bounded overload when available and the plain one otherwise.
+ *
+ * @file BoundedDiss.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _BoundedDiss_h_
+#define _BoundedDiss_h_
+
+// BOOST INCLUDES
+#include <boost/type_traits/integral_constant.hpp>
+
+// SPARE INCLUDES
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusione in namespace spare.
+
+// Forward declarations.
+class Levenshtein;
+
+template <typename Dissimilarity>
+class Dtw;
+
+template <typename SampleType, typename Dissimilarity>
+class MinSod;
+
+/** @brief Bounded dissimilarity declaration trait.
+ *
+ * HasBoundedDiss<T>::value is true if T provides, besides the usual Diss methods, the
+ * bounded overloads Diss(a, b, aBound) (dissimilarity measures) or Diss(sample, aBound)
+ * (representatives). A bounded overload returns the exact dissimilarity when it does not
+ * exceed aBound, and otherwise any value greater than aBound, possibly abandoning the
+ * computation early. Algorithms which only compare the dissimilarity with a threshold, or
+ * with the best value found so far, can then skip most of the work.
+ */
+template <typename T>
+struct HasBoundedDiss : boost::false_type { };
+
+template <>
+struct HasBoundedDiss<Levenshtein> : boost::true_type { };
+
+template <typename Dissimilarity>
+struct HasBoundedDiss< Dtw<Dissimilarity> > : boost::true_type { };
+
+template <typename SampleType, typename Dissimilarity>
+struct HasBoundedDiss< MinSod<SampleType, Dissimilarity> > : HasBoundedDiss<Dissimilarity> { };
+
+// Chiamate con e senza limite.
+template <typename DissType, typename TypeA, typename TypeB>
+inline RealType
+BoundedDissCall(
+   const DissType&   rAgent,
+   const TypeA&      rA,
+   const TypeB&      rB,
+   RealType          aBound,
+   boost::true_type)
+{
+   return rAgent.Diss(rA, rB, aBound);
+}  // BoundedDissCall
+
+template <typename DissType, typename TypeA, typename TypeB>
+inline RealType
+BoundedDissCall(
+   const DissType&   rAgent,
+   const TypeA&      rA,
+   const TypeB&      rB,
+   RealType,
+   boost::false_type)
+{
+   return rAgent.Diss(rA, rB);
+}  // BoundedDissCall
+
+template <typename RepType, typename SampleType>
+inline RealType
+BoundedDissCall(
+   const RepType&    rRep,
+   const SampleType& rSample,
+   RealType          aBound,
+   boost::true_type)
+{
+   return rRep.Diss(rSample, aBound);
+}  // BoundedDissCall
+
+template <typename RepType, typename SampleType>
+inline RealType
+BoundedDissCall(
+   const RepType&    rRep,
+   const SampleType& rSample,
+   RealType,
+   boost::false_type)
+{
+   return rRep.Diss(rSample);
+}  // BoundedDissCall
+
+/** Dissimilarity between two objects, bounded when the measure allows it.
+ *
+ * @param[in] rAgent The dissimilarity measure.
+ * @param[in] rA The first object.
+ * @param[in] rB The second object.
+ * @param[in] aBound The bound.
+ * @return The dissimilarity, or a value greater than aBound if the dissimilarity exceeds it.
+ */
+template <typename DissType, typename TypeA, typename TypeB>
+inline RealType
+BoundedDiss(
+   const DissType&   rAgent,
+   const TypeA&      rA,
+   const TypeB&      rB,
+   RealType          aBound)
+{
+   return BoundedDissCall(rAgent, rA, rB, aBound, HasBoundedDiss<DissType>());
+}  // BoundedDiss
+
+/** Dissimilarity between a representative and a sample, bounded when the representative
+ * allows it.
+ *
+ * @param[in] rRep The representative.
+ * @param[in] rSample The sample.
+ * @param[in] aBound The bound.
+ * @return The dissimilarity, or a value greater than aBound if the dissimilarity exceeds it.
+ */
+template <typename RepType, typename SampleType>
+inline RealType
+BoundedDiss(
+   const RepType&    rRep,
+   const SampleType& rSample,
+   RealType          aBound)
+{
+   return BoundedDissCall(rRep, rSample, aBound, HasBoundedDiss<RepType>());
+}  // BoundedDiss
+
+}  // namespace spare
+
+#endif  // _BoundedDiss_h_
@@ -40,6 +40,7 @@
 
 // SPARE INCLUDES
 #include <spare/BoundedParameter.hpp>
+#include <spare/Dissimilarity/DtwNodeTraits.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
 #include <spare/SwitchParameter.hpp>
@@ -60,6 +61,17 @@ static const size_t      LVSTH_NSVAL_SZ= 2;
  * measure, it can compute the DTW dissimilarity between two sequences of objects, which must 
  * meet the requirement of being acceptable arguments for the Diss methods of the chosen 
  * dissimilariy agent.
+ * The bounded Diss overloads return the exact dissimilarity when it does not exceed a given
+ * bound, and a value greater than the bound otherwise: since the node dissimilarities are
+ * non-negative, the computation is abandoned as soon as a whole row of the dynamic
+ * programming matrix exceeds the bound.
+ * Only the cells inside the Sakoe-Chiba band |i - j| <= W are evaluated (all the cells when
+ * W = 0), keeping two rows of the matrix along the shorter sequence: time is O(W max(M, N))
+ * and memory O(min(M, N)).
+ * When the node dissimilarity is supported by DtwNodeTraits (ModuleDistance on scalar nodes,
+ * unweighted Euclidean on short std::vector<RealType> nodes), the sequences are copied once into flat arrays and
+ * the matrix is evaluated by anti-diagonals, whose cells are independent, with the SIMD kernels
+ * of VectorKernels; the result is the same of the node-by-node evaluation.
  *
  * <b>Parameter summary</b>
  *  <table class="contents">
@@ -154,6 +166,38 @@ public:
                                         std::make_pair( rB.begin(), rB.end() ) );
                            }
 
+   /** Bounded dissimilarity evaluation with iterator interface.
+    *
+    * @param[in] aA A pair of iterators delimiting the first sequence.
+    * @param[in] aB A pair of iterators delimiting the second sequence.
+    * @param[in] aBound The bound, normalized as the dissimilarity.
+    * @return The dissimilarity value if not greater than aBound, a greater value otherwise.
+    */
+   template <typename ForwardIterator1, typename ForwardIterator2>
+   RealType             Diss(
+                           std::pair<ForwardIterator1, ForwardIterator1> aA,
+                           std::pair<ForwardIterator2, ForwardIterator2> aB,
+                           RealType                                      aBound) const;
+
+   /** Bounded dissimilarity evaluation with container interface.
+    *
+    * @param[in] rA A reference to the first sequence container.
+    * @param[in] rB A reference to the second sequence container.
+    * @param[in] aBound The bound, normalized as the dissimilarity.
+    * @return The dissimilarity value if not greater than aBound, a greater value otherwise.
+    */
+   template <typename SequenceContainer1, typename SequenceContainer2>
+   RealType             Diss(
+                           const SequenceContainer1& rA,
+                           const SequenceContainer2& rB,
+                           RealType                  aBound) const
+                           {
+                              return Diss(
+                                        std::make_pair( rA.begin(), rA.end() ),
+                                        std::make_pair( rB.begin(), rB.end() ),
+                                        aBound);
+                           }
+
 // ACCESS
 
    /** Read/Write access to the value of W, the locality constraint window.
@@ -227,9 +271,47 @@ private:
    // Istanza classe misuratrice di dissimilarità.
    Dissimilarity        mDissAgent;
 
-   // Matrice per calcolo interno.
-   mutable std::vector<std::vector<RealType> >
-                        mMat;
+   // Dissimilarità non normalizzata, abbandonando quando una riga supera aRaw. Le righe
+   // scorrono la sequenza aOuter, le colonne la sequenza aInner; se aSwap le sequenze sono
+   // scambiate rispetto all'ordine degli argomenti di Diss.
+   template <typename ForwardIterator1, typename ForwardIterator2>
+   RealType             Evaluate(
+                           std::pair<ForwardIterator1, ForwardIterator1> aOuter,
+                           std::pair<ForwardIterator2, ForwardIterator2> aInner,
+                           ColIndexType                                  N,
+                           bool                                          aSwap,
+                           RealType                                      aRaw) const;
+
+   // Copia dei nodi in rOut per componente (rOut[d*aLength + j]), eventualmente in ordine
+   // inverso; falso se il tipo dei nodi non è supportato o se non hanno tutti la stessa
+   // dimensione.
+   template <typename ForwardIterator>
+   bool                 Flatten(
+                           std::pair<ForwardIterator, ForwardIterator>  aSeq,
+                           std::vector<RealType>::size_type             aLength,
+                           bool                                         aReverse,
+                           std::vector<RealType>&                       rOut,
+                           std::vector<RealType>::size_type&            rDim) const;
+
+   // Calcolo per anti-diagonali sulle sequenze piatte; rA è in ordine inverso.
+   RealType             Wavefront(
+                           const std::vector<RealType>&     rA,
+                           RowIndexType                     M,
+                           const std::vector<RealType>&     rB,
+                           ColIndexType                     N,
+                           std::vector<RealType>::size_type aDim,
+                           RealType                         aRaw) const;
+
+   // Dissimilarità tra nodi nell'ordine degli argomenti di Diss.
+   template <typename NodeType1, typename NodeType2>
+   RealType             NodeDiss(
+                           const NodeType1&  rOuter,
+                           const NodeType2&  rInner,
+                           bool              aSwap) const
+                           {
+                              return aSwap ? mDissAgent.Diss(rInner, rOuter)
+                                           : mDissAgent.Diss(rOuter, rInner);
+                           }
 
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
@@ -255,18 +337,25 @@ RealType
 Dtw<Dissimilarity>::Diss(
                      std::pair<ForwardIterator1, ForwardIterator1> aA,
                      std::pair<ForwardIterator2, ForwardIterator2> aB) const
+{
+   return Diss(aA, aB, std::numeric_limits<RealType>::max());
+}  // Diss
+
+template <typename Dissimilarity>
+template <typename ForwardIterator1, typename ForwardIterator2>
+RealType
+Dtw<Dissimilarity>::Diss(
+                     std::pair<ForwardIterator1, ForwardIterator1> aA,
+                     std::pair<ForwardIterator2, ForwardIterator2> aB,
+                     RealType                                      aBound) const
 {
    // Variabili.
-   ForwardIterator1  Ait;
-   ForwardIterator2  Bit;
-   RealType          Cost;
    RowIndexType      M;
    RealType          M_;
    ColIndexType      N;
    RealType          N_;
-   RowIndexType      i;
-   ColIndexType      j;
-   NaturalType       s;
+   RealType          Raw;
+   RealType          D;
 
    // Controllo.
    #if SPARE_DEBUG
@@ -304,65 +393,271 @@ Dtw<Dissimilarity>::Diss(
       return RealType(0.);
    }
 
-   // Dimensiono e inizializzo matrice.
-   mMat.resize(M+1);
+   // Limite sul valore non normalizzato.
+   if ( (mNormalization == "On") && (aBound < std::numeric_limits<RealType>::max()) )
+   {
+      // Margine per l'arrotondamento della normalizzazione.
+      Raw= aBound * mMaxDissValue * std::max(M_, N_)
+         * (1. + 4.*std::numeric_limits<RealType>::epsilon());
+   }
+   else
+   {
+      Raw= aBound;
+   }
 
-   for (i= 0; i <= M; i++)
+   // Le righe tenute in memoria scorrono la sequenza più corta.
+   if (N <= M)
    {
-      mMat[i].resize(N+1);
+      D= Evaluate(aA, aB, N, false, Raw);
+   }
+   else
+   {
+      D= Evaluate(aB, aA, M, true, Raw);
    }
 
-   for (i= 0; i <= M; i++)
+   if (mNormalization == "On")
    {
-      for (j= 0; j <= N; j++)
+      return D / (mMaxDissValue*std::max(M_, N_));
+   }
+   else
+   {
+      return D;
+   }
+}  // Diss
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+template <typename Dissimilarity>
+template <typename ForwardIterator1, typename ForwardIterator2>
+RealType
+Dtw<Dissimilarity>::Evaluate(
+                     std::pair<ForwardIterator1, ForwardIterator1> aOuter,
+                     std::pair<ForwardIterator2, ForwardIterator2> aInner,
+                     ColIndexType                                  N,
+                     bool                                          aSwap,
+                     RealType                                      aRaw) const
+{
+   // Costanti.
+   const RealType       Inf= std::numeric_limits<RealType>::max();
+   const ColIndexType   W= mW;
+
+   // Variabili.
+   ForwardIterator1     Oit;
+   ForwardIterator2     Iit;
+   std::vector<ForwardIterator2>
+                        Cols;
+   std::vector<RealType>
+                        Prev(N + 1, Inf);
+   std::vector<RealType>
+                        Cur(N + 1, Inf);
+   std::vector<RealType>
+                        FlatA;
+   std::vector<RealType>
+                        FlatB;
+   std::vector<RealType>::size_type
+                        DimA;
+   std::vector<RealType>::size_type
+                        DimB;
+   RowIndexType         M;
+   RowIndexType         i;
+   ColIndexType         j;
+   ColIndexType         Lo;
+   ColIndexType         Hi;
+   RealType             RowMin;
+
+   // Sequenze piatte, se i nodi lo consentono.
+   if ( DtwNodeTraits<Dissimilarity>::Supported(mDissAgent) && (N > 0) )
+   {
+      M= std::distance(aOuter.first, aOuter.second);
+
+      if ( Flatten(aOuter, M, true, FlatA, DimA) &&
+           DtwNodeTraits<Dissimilarity>::Wavefront(DimA) &&
+           Flatten(aInner, N, false, FlatB, DimB) && (DimA == DimB) && (DimA > 0) )
       {
-         mMat[i][j]= std::numeric_limits<RealType>::max();
+         return Wavefront(FlatA, M, FlatB, N, DimA, aRaw);
       }
    }
 
-   mMat[0][0]= 0.;
+   // Accesso diretto alle colonne.
+   Cols.reserve(N);
+   for (Iit= aInner.first; Iit != aInner.second; Iit++)
+   {
+      Cols.push_back(Iit);
+   }
+
+   Prev[0]= 0.;
 
-   // Calcolo distanza.
+   // Calcolo nella banda |i - j| <= W; le celle fuori banda valgono Inf e non vengono
+   // mai scritte, salvo la prima oltre ciascun estremo.
    i= 1;
-   for (Ait= aA.first; Ait != aA.second; Ait++)
+   for (Oit= aOuter.first; Oit != aOuter.second; Oit++)
    {
-      j= 1;
-      for (Bit= aB.first; Bit != aB.second; Bit++)
+      Lo= ( W && (i > W) ) ? i - W : 1;
+      Hi= ( W && (i < N) && (W < N - i) ) ? i + W : N;
+
+      // Banda vuota: la cella finale non è raggiungibile.
+      if (Lo > Hi)
       {
-         // FIXME: si potrebbe rendere più efficiente agendo direttamente sul ciclo
-         if (i > j)
-         {
-            s= i - j;
-         }
-         else
-         {
-            s= j - i;
-         }
+         return Inf;
+      }
 
-         if ((s <= mW) || !(mW))
-         {
-            Cost= mDissAgent.Diss(*Ait, *Bit);
-            mMat[i][j]= Cost + std::min(
-                                       mMat[i-1][j],
-                                       std::min(
-                                               mMat[i][j-1],
-                                               mMat[i-1][j-1]) );
-         }
+      Cur[Lo - 1]= Inf;
+      RowMin= Inf;
 
-         ++j;
+      for (j= Lo; j <= Hi; j++)
+      {
+         Cur[j]= NodeDiss(*Oit, *Cols[j - 1], aSwap) + std::min(
+                                                              Prev[j],
+                                                              std::min(
+                                                                      Cur[j-1],
+                                                                      Prev[j-1]) );
+         RowMin= std::min(RowMin, Cur[j]);
       }
+
+      if (Hi < N)
+      {
+         Cur[Hi + 1]= Inf;
+      }
+
+      // Tutta la riga oltre il limite: abbandono (costi dei nodi non negativi).
+      if (RowMin > aRaw)
+      {
+         return Inf;
+      }
+
+      Prev.swap(Cur);
       ++i;
    }
 
+   return Prev[N];
+}  // Evaluate
 
-   if (mNormalization == "On")
+template <typename Dissimilarity>
+template <typename ForwardIterator>
+bool
+Dtw<Dissimilarity>::Flatten(
+                     std::pair<ForwardIterator, ForwardIterator>  aSeq,
+                     std::vector<RealType>::size_type             aLength,
+                     bool                                         aReverse,
+                     std::vector<RealType>&                       rOut,
+                     std::vector<RealType>::size_type&            rDim) const
+{
+   // Variabili.
+   std::vector<RealType>            Node;
+   std::vector<RealType>::size_type j;
+   std::vector<RealType>::size_type Pos;
+
+   rDim= 0;
+   for (j= 0; aSeq.first != aSeq.second; ++aSeq.first, ++j)
+   {
+      Node.clear();
+      if ( !DtwNodeTraits<Dissimilarity>::Append(*aSeq.first, Node) )
+      {
+         return false;
+      }
+
+      if (j == 0)
+      {
+         rDim= Node.size();
+         rOut.resize(rDim*aLength);
+      }
+      else if (Node.size() != rDim)
+      {
+         return false;
+      }
+
+      Pos= aReverse ? aLength - 1 - j : j;
+      for (std::vector<RealType>::size_type d= 0; d < rDim; d++)
+      {
+         rOut[d*aLength + Pos]= Node[d];
+      }
+   }
+
+   return true;
+}  // Flatten
+
+template <typename Dissimilarity>
+RealType
+Dtw<Dissimilarity>::Wavefront(
+                     const std::vector<RealType>&     rA,
+                     RowIndexType                     M,
+                     const std::vector<RealType>&     rB,
+                     ColIndexType                     N,
+                     std::vector<RealType>::size_type aDim,
+                     RealType                         aRaw) const
+{
+   // Costanti.
+   const RealType       Inf= std::numeric_limits<RealType>::max();
+   const ColIndexType   W= mW;
+
+   // Variabili.
+   std::vector<RealType>
+                        Diag2(N + 1, Inf);    // Anti-diagonale k - 2.
+   std::vector<RealType>
+                        Diag1(N + 1, Inf);    // Anti-diagonale k - 1.
+   std::vector<RealType>
+                        Diag(N + 1, Inf);     // Anti-diagonale k.
+   std::vector<RealType>
+                        Cost(N + 1);
+   RowIndexType         k;
+   ColIndexType         Lo;
+   ColIndexType         Hi;
+   RealType             DiagMin;
+   RealType             PrevMin= Inf;
+
+   // Le celle (i, j) con i + j = k sono indicizzate per colonna j; la cella (i, j) dipende
+   // da (i - 1, j) e (i, j - 1) sull'anti-diagonale k - 1, e da (i - 1, j - 1) sulla k - 2.
+   Diag2[0]= 0.;
+
+   for (k= 2; k <= M + N; k++)
    {
-      return mMat[M][N] / (mMaxDissValue*std::max(M_, N_));
+      // Celle della banda sull'anti-diagonale: 1 <= i <= M, 1 <= j <= N, |i - j| <= W.
+      Lo= (k > M) ? k - M : 1;
+      Hi= std::min<ColIndexType>(N, k - 1);
+
+      if (W)
+      {
+         if (k > W)
+         {
+            Lo= std::max<ColIndexType>(Lo, (k - W + 1) / 2);
+         }
+         Hi= std::min<ColIndexType>(Hi, (k + W) / 2);
+      }
+
+      // Anti-diagonale vuota: la cella finale non è raggiungibile.
+      if (Lo > Hi)
+      {
+         return Inf;
+      }
+
+      // Costi delle celle (k - j, j); rA è in ordine inverso, quindi il nodo k - j si trova
+      // in posizione M - k + j.
+      DtwNodeTraits<Dissimilarity>::Costs(
+         &rA[M - k + Lo], M, &rB[Lo - 1], N, aDim, Hi - Lo + 1, &Cost[Lo]);
+
+      DiagMin= VectorKernels::MinPlus(
+                  &Cost[Lo], &Diag1[Lo], &Diag1[Lo - 1], &Diag2[Lo - 1], &Diag[Lo], Hi - Lo + 1);
+
+      // Fuori banda valgono Inf le celle adiacenti agli estremi, le sole lette in seguito.
+      Diag[Lo - 1]= Inf;
+      if (Hi < N)
+      {
+         Diag[Hi + 1]= Inf;
+      }
+
+      // Ogni cammino attraversa almeno una di due anti-diagonali consecutive.
+      if (std::min(DiagMin, PrevMin) > aRaw)
+      {
+         return Inf;
+      }
+
+      PrevMin= DiagMin;
+      Diag2.swap(Diag1);
+      Diag1.swap(Diag);
    }
-   else
-      return mMat[M][N];
 
-}  // Diss
+   return Diag1[N];
+}  // Wavefront
 
 }  // namespace spare
 
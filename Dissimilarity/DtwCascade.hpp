@@ -0,0 +1,558 @@
+//  DtwCascade class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File DtwCascade.hpp, containing the DtwCascade template class.
+ *
+ * The file contains the DtwCascade template class, a lower bound cascade for the nearest
+ * neighbour search under the Dtw dissimilarity.
+ *
+ * @file DtwCascade.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _DtwCascade_h_
+#define _DtwCascade_h_
+
+// STD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <vector>
+
+// SPARE INCLUDES
+#include <spare/Dissimilarity/DtwNodeTraits.hpp>
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusione in namespace spare.
+
+// Forward declaration (Dtw.hpp non è incluso, per non imporlo agli utilizzatori).
+template <typename Dissimilarity>
+class Dtw;
+
+/** @brief Lower bound cascade for Dtw nearest neighbour search.
+ *
+ * The class stores, for each inserted sequence, its upper and lower envelopes over the Dtw
+ * window W, and decides whether a stored sequence certainly exceeds a given dissimilarity
+ * bound from a query (Prune). The bounds are evaluated from the cheapest:
+ *  - LB_Kim, the cost of the first and of the last node pairs, which every warping path
+ *    contains;
+ *  - LB_Keogh of the query against the envelope of the stored sequence;
+ *  - LB_Keogh of the stored sequence against the envelope of the query;
+ * each one abandoned as soon as it exceeds the bound. The candidates surviving the cascade are
+ * evaluated by the caller with the bounded Dtw Diss, which abandons the computation as well
+ * (see HasBoundedDiss). The search result is the same of an exhaustive one.
+ * Sequences of different lengths are supported. The envelopes are computed with the window of
+ * the Dtw agent passed to Insert: if the window is changed afterwards, the stored envelopes are
+ * ignored until the sequences are inserted again.
+ * This generic template applies to any dissimilarity and never prunes; the specialization for
+ * Dtw evaluates the bounds when DtwNodeTraits supports its node dissimilarity.
+ */
+template <typename Dissimilarity>
+class DtwCascade
+{
+public:
+
+// PUBLIC TYPES
+
+   /** Query data, prepared once per query.
+    */
+   struct Envelope { };
+
+   /** Size type.
+    */
+   typedef std::vector<RealType>::size_type
+                        SizeType;
+
+// OPERATIONS
+
+   /** Removal of every stored sequence.
+    */
+   void                 Clear()                    { }
+
+   /** Insertion of a sequence.
+    *
+    * @param[in] rAgent The dissimilarity agent.
+    * @param[in] rSequence The sequence.
+    */
+   template <typename SequenceContainer>
+   void                 Insert(
+                           const Dissimilarity&,
+                           const SequenceContainer&)
+                                                   { }
+
+   /** Replacement of a stored sequence.
+    *
+    * @param[in] aIndex The position of the stored sequence.
+    * @param[in] rAgent The dissimilarity agent.
+    * @param[in] rSequence The new sequence.
+    */
+   template <typename SequenceContainer>
+   void                 Update(
+                           SizeType,
+                           const Dissimilarity&,
+                           const SequenceContainer&)
+                                                   { }
+
+   /** Preparation of the query data.
+    *
+    * @param[in] rAgent The dissimilarity agent.
+    * @param[in] rQuery The query sequence.
+    * @param[out] rEnv The query data.
+    */
+   template <typename SequenceContainer>
+   void                 Prepare(
+                           const Dissimilarity&,
+                           const SequenceContainer&,
+                           Envelope&) const
+                                                   { }
+
+   /** Pruning test.
+    *
+    * @param[in] rAgent The dissimilarity agent.
+    * @param[in] rEnv The query data.
+    * @param[in] aIndex The position of the stored sequence.
+    * @param[in] aBound The dissimilarity bound.
+    * @return True if the dissimilarity between query and stored sequence exceeds aBound.
+    */
+   bool                 Prune(
+                           const Dissimilarity&,
+                           const Envelope&,
+                           SizeType,
+                           RealType) const
+                                                   { return false; }
+
+// ACCESS
+
+   /** Number of stored sequences.
+    *
+    * @return Always 0, since nothing is stored.
+    */
+   SizeType             Size() const               { return 0; }
+}; // class DtwCascade
+
+/** @brief Lower bound cascade for Dtw nearest neighbour search, Dtw specialization.
+ */
+template <typename NodeDissimilarity>
+class DtwCascade< Dtw<NodeDissimilarity> >
+{
+public:
+
+// PUBLIC TYPES
+
+   /** Sequence nodes and envelopes, as row-major Length x Dimension arrays.
+    */
+   struct Envelope
+   {
+      /** Number of nodes.
+       */
+      NaturalType       Length;
+
+      /** Node dimension, 0 if the bounds are not available.
+       */
+      NaturalType       Dimension;
+
+      /** Window used for the envelopes.
+       */
+      NaturalType       W;
+
+      /** Node components.
+       */
+      std::vector<RealType>
+                        Values;
+
+      /** Upper envelope.
+       */
+      std::vector<RealType>
+                        Upper;
+
+      /** Lower envelope.
+       */
+      std::vector<RealType>
+                        Lower;
+   };
+
+   /** Size type.
+    */
+   typedef typename std::vector<Envelope>::size_type
+                        SizeType;
+
+// OPERATIONS
+
+   /** Removal of every stored sequence.
+    */
+   void                 Clear()                    { mEnvelopes.clear(); }
+
+   /** Insertion of a sequence.
+    *
+    * @param[in] rAgent The dissimilarity agent.
+    * @param[in] rSequence The sequence.
+    */
+   template <typename SequenceContainer>
+   void                 Insert(
+                           const Dtw<NodeDissimilarity>& rAgent,
+                           const SequenceContainer&      rSequence)
+                           {
+                              mEnvelopes.push_back( Envelope() );
+                              Prepare(rAgent, rSequence, mEnvelopes.back());
+                           }
+
+   /** Replacement of a stored sequence.
+    *
+    * @param[in] aIndex The position of the stored sequence.
+    * @param[in] rAgent The dissimilarity agent.
+    * @param[in] rSequence The new sequence.
+    */
+   template <typename SequenceContainer>
+   void                 Update(
+                           SizeType                      aIndex,
+                           const Dtw<NodeDissimilarity>& rAgent,
+                           const SequenceContainer&      rSequence)
+                           {
+                              Prepare(rAgent, rSequence, mEnvelopes[aIndex]);
+                           }
+
+   /** Preparation of the query data.
+    *
+    * @param[in] rAgent The dissimilarity agent.
+    * @param[in] rQuery The query sequence.
+    * @param[out] rEnv The query data.
+    */
+   template <typename SequenceContainer>
+   void                 Prepare(
+                           const Dtw<NodeDissimilarity>& rAgent,
+                           const SequenceContainer&      rQuery,
+                           Envelope&                     rEnv) const;
+
+   /** Pruning test.
+    *
+    * @param[in] rAgent The dissimilarity agent.
+    * @param[in] rEnv The query data.
+    * @param[in] aIndex The position of the stored sequence.
+    * @param[in] aBound The dissimilarity bound.
+    * @return True if the dissimilarity between query and stored sequence exceeds aBound.
+    */
+   bool                 Prune(
+                           const Dtw<NodeDissimilarity>& rAgent,
+                           const Envelope&               rEnv,
+                           SizeType                      aIndex,
+                           RealType                      aBound) const;
+
+// ACCESS
+
+   /** Number of stored sequences.
+    *
+    * @return The number of stored sequences.
+    */
+   SizeType             Size() const               { return mEnvelopes.size(); }
+
+private:
+
+   // Inviluppi delle sequenze inserite.
+   std::vector<Envelope>
+                        mEnvelopes;
+
+   // Distanza euclidea tra nodi.
+   static RealType      NodeDiss(
+                           const RealType*   pA,
+                           const RealType*   pB,
+                           NaturalType       aDim);
+
+   // LB_Keogh dei nodi di rA rispetto all'inviluppo di rB, abbandonato oltre aRaw.
+   static RealType      Keogh(
+                           const Envelope&   rA,
+                           const Envelope&   rB,
+                           RealType          aRaw);
+}; // class DtwCascade
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+////////////////////////////////////// PUBLIC //////////////////////////////////////////////
+
+//==================================== OPERATIONS ==========================================
+
+template <typename NodeDissimilarity>
+template <typename SequenceContainer>
+void
+DtwCascade< Dtw<NodeDissimilarity> >::Prepare(
+                                       const Dtw<NodeDissimilarity>& rAgent,
+                                       const SequenceContainer&      rQuery,
+                                       Envelope&                     rEnv) const
+{
+   // Variabili.
+   std::deque<NaturalType>    MaxQ;
+   std::deque<NaturalType>    MinQ;
+   std::vector<RealType>::size_type
+                              Size;
+   NaturalType                D;
+   NaturalType                L;
+   NaturalType                i;
+   NaturalType                Lo;
+   NaturalType                Hi;
+   NaturalType                Next;
+
+   rEnv.Length= 0;
+   rEnv.Dimension= 0;
+   rEnv.W= rAgent.W();
+   rEnv.Values.clear();
+   rEnv.Upper.clear();
+   rEnv.Lower.clear();
+
+   if ( !DtwNodeTraits<NodeDissimilarity>::Supported( rAgent.DissAgent() ) )
+   {
+      return;
+   }
+
+   // Componenti dei nodi, controllando che abbiano tutti la stessa dimensione.
+   for (typename SequenceContainer::const_iterator It= rQuery.begin(); It != rQuery.end(); ++It)
+   {
+      Size= rEnv.Values.size();
+      if ( !DtwNodeTraits<NodeDissimilarity>::Append(*It, rEnv.Values) )
+      {
+         rEnv.Values.clear();
+         return;
+      }
+
+      if (rEnv.Length == 0)
+      {
+         rEnv.Dimension= static_cast<NaturalType>(rEnv.Values.size());
+      }
+      else if (rEnv.Values.size() - Size != rEnv.Dimension)
+      {
+         rEnv.Dimension= 0;
+         rEnv.Values.clear();
+         return;
+      }
+
+      ++rEnv.Length;
+   }
+
+   if ( (rEnv.Length == 0) || (rEnv.Dimension == 0) )
+   {
+      rEnv.Length= 0;
+      rEnv.Dimension= 0;
+      return;
+   }
+
+   // Inviluppi su [i - W, i + W] (tutta la sequenza se W = 0), con le code monotone di Lemire.
+   D= rEnv.Dimension;
+   L= rEnv.Length;
+   rEnv.Upper.resize(rEnv.Values.size());
+   rEnv.Lower.resize(rEnv.Values.size());
+
+   for (NaturalType d= 0; d < D; d++)
+   {
+      const RealType* pX= &rEnv.Values[d];
+
+      MaxQ.clear();
+      MinQ.clear();
+      Next= 0;
+
+      for (i= 0; i < L; i++)
+      {
+         Hi= ( rEnv.W && (rEnv.W < L - 1 - i) ) ? i + rEnv.W : L - 1;
+         Lo= ( rEnv.W && (i > rEnv.W) ) ? i - rEnv.W : 0;
+
+         for (; Next <= Hi; Next++)
+         {
+            while ( !MaxQ.empty() && (pX[MaxQ.back()*D] <= pX[Next*D]) )
+            {
+               MaxQ.pop_back();
+            }
+            MaxQ.push_back(Next);
+
+            while ( !MinQ.empty() && (pX[MinQ.back()*D] >= pX[Next*D]) )
+            {
+               MinQ.pop_back();
+            }
+            MinQ.push_back(Next);
+         }
+
+         while (MaxQ.front() < Lo)
+         {
+            MaxQ.pop_front();
+         }
+
+         while (MinQ.front() < Lo)
+         {
+            MinQ.pop_front();
+         }
+
+         rEnv.Upper[i*D + d]= pX[MaxQ.front()*D];
+         rEnv.Lower[i*D + d]= pX[MinQ.front()*D];
+      }
+   }
+}  // Prepare
+
+template <typename NodeDissimilarity>
+bool
+DtwCascade< Dtw<NodeDissimilarity> >::Prune(
+                                       const Dtw<NodeDissimilarity>& rAgent,
+                                       const Envelope&               rEnv,
+                                       SizeType                      aIndex,
+                                       RealType                      aBound) const
+{
+   // Margine relativo sul limite, per gli arrotondamenti delle somme dei costi.
+   static const RealType      Slack= 1e-9;
+
+   // Variabili.
+   RealType                   Raw;
+   RealType                   Lb;
+   NaturalType                M;
+   NaturalType                N;
+   NaturalType                D;
+   NaturalType                W;
+
+   const Envelope&            rC= mEnvelopes[aIndex];
+
+   if ( (aBound >= std::numeric_limits<RealType>::max()) || (rEnv.Dimension == 0) ||
+        (rC.Dimension != rEnv.Dimension) )
+   {
+      return false;
+   }
+
+   M= rEnv.Length;
+   N= rC.Length;
+   D= rEnv.Dimension;
+   W= rAgent.W();
+
+   // Limite sul costo non normalizzato.
+   Raw= aBound;
+   if (rAgent.Normalization() == "On")
+   {
+      Raw*= rAgent.MaxDissValue() * static_cast<RealType>( std::max(M, N) );
+   }
+   Raw+= std::fabs(Raw) * Slack;
+
+   // Nessun cammino ammissibile.
+   if ( W && ( std::max(M, N) - std::min(M, N) > W ) )
+   {
+      return true;
+   }
+
+   // LB_Kim: prima e ultima coppia di nodi.
+   Lb= NodeDiss(&rEnv.Values[0], &rC.Values[0], D);
+   if ( (M > 1) || (N > 1) )
+   {
+      Lb+= NodeDiss(&rEnv.Values[(M - 1)*D], &rC.Values[(N - 1)*D], D);
+   }
+
+   if (Lb > Raw)
+   {
+      return true;
+   }
+
+   // LB_Keogh nei due versi, con inviluppi calcolati per la finestra corrente.
+   if ( (rC.W == W) && (Keogh(rEnv, rC, Raw) > Raw) )
+   {
+      return true;
+   }
+
+   if ( (rEnv.W == W) && (Keogh(rC, rEnv, Raw) > Raw) )
+   {
+      return true;
+   }
+
+   return false;
+}  // Prune
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+template <typename NodeDissimilarity>
+RealType
+DtwCascade< Dtw<NodeDissimilarity> >::NodeDiss(
+                                       const RealType*   pA,
+                                       const RealType*   pB,
+                                       NaturalType       aDim)
+{
+   RealType    S= 0.;
+
+   for (NaturalType d= 0; d < aDim; d++)
+   {
+      S+= (pA[d] - pB[d]) * (pA[d] - pB[d]);
+   }
+
+   return std::sqrt(S);
+}  // NodeDiss
+
+template <typename NodeDissimilarity>
+RealType
+DtwCascade< Dtw<NodeDissimilarity> >::Keogh(
+                                       const Envelope&   rA,
+                                       const Envelope&   rB,
+                                       RealType          aRaw)
+{
+   // Variabili.
+   const NaturalType    D= rA.Dimension;
+   const NaturalType    N= rB.Length;
+   RealType             Lb= 0.;
+   RealType             S;
+   RealType             E;
+   NaturalType          k;
+
+   for (NaturalType i= 0; i < rA.Length; i++)
+   {
+      // Oltre l'ultimo nodo di rB la finestra di i è contenuta in quella di N - 1.
+      if (i < N)
+      {
+         k= i;
+      }
+      else if ( rB.W && (i - (N - 1) > rB.W) )
+      {
+         return std::numeric_limits<RealType>::max();
+      }
+      else
+      {
+         k= N - 1;
+      }
+
+      const RealType* pX= &rA.Values[i*D];
+      const RealType* pU= &rB.Upper[k*D];
+      const RealType* pL= &rB.Lower[k*D];
+
+      S= 0.;
+      for (NaturalType d= 0; d < D; d++)
+      {
+         if (pX[d] > pU[d])
+         {
+            E= pX[d] - pU[d];
+         }
+         else if (pX[d] < pL[d])
+         {
+            E= pL[d] - pX[d];
+         }
+         else
+         {
+            E= 0.;
+         }
+
+         S+= E * E;
+      }
+
+      Lb+= std::sqrt(S);
+
+      if (Lb > aRaw)
+      {
+         return Lb;
+      }
+   }
+
+   return Lb;
+}  // Keogh
+
+}  // namespace spare
+
+#endif  // _DtwCascade_h_
@@ -0,0 +1,186 @@
+//  DtwNodeTraits class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File DtwNodeTraits.hpp, containing the DtwNodeTraits template class.
+ *
+ * The file contains the DtwNodeTraits template class, describing the node dissimilarities for
+ * which Dtw and DtwCascade can work on flat real arrays.
+ *
+ * @file DtwNodeTraits.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _DtwNodeTraits_h_
+#define _DtwNodeTraits_h_
+
+// STD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// SPARE INCLUDES
+#include <spare/Dissimilarity/Euclidean.hpp>
+#include <spare/Dissimilarity/ModuleDistance.hpp>
+#include <spare/SpareTypes.hpp>
+#include <spare/VectorKernels.hpp>
+
+namespace spare {  // Inclusione in namespace spare.
+
+/** @brief Node dissimilarity traits for Dtw.
+ *
+ * A supported node dissimilarity is the Euclidean distance between the nodes seen as real
+ * vectors: the nodes can then be stored as flat arrays of components (Append), on which Dtw
+ * evaluates many node dissimilarities at once with the SIMD kernels (Costs) and DtwCascade
+ * evaluates its lower bounds. The traits are specialized for ModuleDistance on scalar nodes and
+ * for unweighted Euclidean on std::vector<RealType> nodes, for which Euclidean::Diss uses the
+ * SIMD kernels; any other node dissimilarity or node type is not supported.
+ */
+template <typename NodeDissimilarity>
+struct DtwNodeTraits
+{
+   /** Whether the node dissimilarity is supported.
+    *
+    * @param[in] rAgent The node dissimilarity agent.
+    * @return True if the node dissimilarity is supported.
+    */
+   static bool          Supported(const NodeDissimilarity&)
+                                                   { return false; }
+
+   /** Appends the components of a node to rOut.
+    *
+    * @param[in] rNode The node.
+    * @param[in,out] rOut The component vector.
+    * @return False if the node type is not supported.
+    */
+   template <typename NodeType>
+   static bool          Append(
+                           const NodeType&,
+                           std::vector<RealType>&)
+                                                   { return false; }
+
+   /** Whether Dtw evaluates by anti-diagonals the sequences of nodes of a given dimension.
+    *
+    * Costs reads the components of consecutive nodes, hence on long nodes the node-by-node
+    * evaluation, which reads each node contiguously, is faster.
+    *
+    * @param[in] aDim Node dimension.
+    * @return True if the anti-diagonal evaluation is convenient.
+    */
+   static bool          Wavefront(std::size_t)
+                                                   { return false; }
+
+   /** Dissimilarities between the nodes of two arrays, pairwise.
+    *
+    * The nodes are stored by component, the d-th component of the j-th node of the first
+    * array being pA[d*aStrideA + j]; pOut[j] is the dissimilarity between the j-th nodes of the
+    * two arrays, with the same result of the Diss method of the node dissimilarity agent.
+    *
+    * @param[in] pA Pointer to the first component of the first node of the first array.
+    * @param[in] aStrideA Distance between the components of a node of the first array.
+    * @param[in] pB Pointer to the first component of the first node of the second array.
+    * @param[in] aStrideB Distance between the components of a node of the second array.
+    * @param[in] aDim Node dimension.
+    * @param[in] aSize Number of nodes.
+    * @param[out] pOut Pointer to the first output element.
+    */
+   static void          Costs(
+                           const RealType*,
+                           std::size_t,
+                           const RealType*,
+                           std::size_t,
+                           std::size_t,
+                           std::size_t,
+                           RealType*)
+                                                   { }
+};
+
+template <>
+struct DtwNodeTraits<ModuleDistance>
+{
+   static bool          Supported(const ModuleDistance&)
+                                                   { return true; }
+
+   template <typename NodeType>
+   static bool          Append(
+                           const NodeType&         rNode,
+                           std::vector<RealType>&  rOut)
+                           {
+                              rOut.push_back( static_cast<RealType>(rNode) );
+                              return true;
+                           }
+
+   static bool          Wavefront(std::size_t)
+                                                   { return true; }
+
+   static void          Costs(
+                           const RealType*   pA,
+                           std::size_t,
+                           const RealType*   pB,
+                           std::size_t,
+                           std::size_t,
+                           std::size_t       aSize,
+                           RealType*         pOut)
+                           {
+                              VectorKernels::AbsDifference(pA, pB, pOut, aSize);
+                           }
+};
+
+template <>
+struct DtwNodeTraits<Euclidean>
+{
+   static bool          Supported(const Euclidean& rAgent)
+                                                   { return !rAgent.IsWeighted(); }
+
+   static bool          Append(
+                           const Euclidean::DenseVector& rNode,
+                           std::vector<RealType>&        rOut)
+                           {
+                              rOut.insert(rOut.end(), rNode.begin(), rNode.end());
+                              return true;
+                           }
+
+   // Su altri tipi di nodo Euclidean::Diss somma in sequenza: resta il calcolo per nodi.
+   template <typename NodeType>
+   static bool          Append(
+                           const NodeType&,
+                           std::vector<RealType>&)
+                                                   { return false; }
+
+   static bool          Wavefront(std::size_t aDim)
+                                                   { return aDim <= 8; }
+
+   static void          Costs(
+                           const RealType*   pA,
+                           std::size_t       aStrideA,
+                           const RealType*   pB,
+                           std::size_t       aStrideB,
+                           std::size_t       aDim,
+                           std::size_t       aSize,
+                           RealType*         pOut)
+                           {
+                              VectorKernels::SquaredDistanceColumns(
+                                 pA, aStrideA, pB, aStrideB, aDim, pOut, aSize);
+
+                              for (std::size_t j= 0; j < aSize; j++)
+                              {
+                                 pOut[j]= std::sqrt(pOut[j]);
+                              }
+                           }
+};
+
+}  // namespace spare
+
+#endif  // _DtwNodeTraits_h_
@@ -39,6 +39,7 @@
 // SPARE INCLUDES
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
+#include <spare/VectorKernels.hpp>
 
 namespace spare {  // Inclusione in namespace spare.
 
@@ -47,11 +48,22 @@ namespace spare {  // Inclusione in namespace spare.
  * This class implements the @a Dissimilarity concept.
  * This class contains functions for the computation of the Euclidean distance between real vectors.
  * It's possible to weight the components of the vectors differently usign a proper weight vector.
+ * The SquaredDiss methods return the squared distance: searches which only compare distances
+ * can use them and skip the square root (see HasSquaredDiss). Vectors stored as
+ * std::vector<RealType> take a fast path working on contiguous memory, with the SIMD kernels
+ * of VectorKernels.
  */
 class Euclidean
 {
 public:
 
+// PUBLIC TYPES
+
+   /** Dense real vector.
+    */
+   typedef std::vector<RealType>
+                        DenseVector;
+
 // OPERATIONS
 
    /** Euclidean distance computation.
@@ -73,9 +85,53 @@ public:
     */
    template <typename SequenceContainer1, typename SequenceContainer2>
    RealType             Diss(
+                           const SequenceContainer1& rA,
+                           const SequenceContainer2& rB) const
+                                                   { return std::sqrt( SquaredDiss(rA, rB) ); }
+
+   /** Euclidean distance computation, contiguous fast path.
+    *
+    * @param[in] rA A reference to the first vector.
+    * @param[in] rB A reference to the second vector.
+    * @return The distance value.
+    */
+   RealType             Diss(
+                           const DenseVector&   rA,
+                           const DenseVector&   rB) const
+                                                   { return std::sqrt( SquaredDiss(rA, rB) ); }
+
+   /** Squared euclidean distance computation.
+    *
+    * @param[in] aA A pair of iterators of the first vector.
+    * @param[in] aB A pair of iterators of the second vector.
+    * @return The squared distance value.
+    */
+   template <typename ForwardIterator1, typename ForwardIterator2>
+   RealType             SquaredDiss(
+                           std::pair<ForwardIterator1, ForwardIterator1> aA,
+                           std::pair<ForwardIterator2, ForwardIterator2> aB) const;
+
+   /** Squared euclidean distance computation.
+    *
+    * @param[in] rA A reference to the container of the first vector.
+    * @param[in] rB A reference to the container of the second vector.
+    * @return The squared distance value.
+    */
+   template <typename SequenceContainer1, typename SequenceContainer2>
+   RealType             SquaredDiss(
                            const SequenceContainer1& rA,
                            const SequenceContainer2& rB) const;
 
+   /** Squared euclidean distance computation, contiguous fast path.
+    *
+    * @param[in] rA A reference to the first vector.
+    * @param[in] rB A reference to the second vector.
+    * @return The squared distance value.
+    */
+   RealType             SquaredDiss(
+                           const DenseVector&   rA,
+                           const DenseVector&   rB) const;
+
 // SETUP
 
    /** Setup of the weight vector.
@@ -92,6 +148,14 @@ public:
    template <typename SequenceContainer>
    void                 WeightSetup(const SequenceContainer& rW);
 
+// ACCESS
+
+   /** Check of the presence of a weight vector.
+    *
+    * @return True if the components are weighted.
+    */
+   bool                 IsWeighted() const         { return !mWeights.empty(); }
+
 private:
 
    // Tipo vettore pesi.
@@ -123,8 +187,18 @@ RealType
 Euclidean::Diss(
               std::pair<ForwardIterator1, ForwardIterator1> aA,
               std::pair<ForwardIterator2, ForwardIterator2> aB) const
+{
+   return std::sqrt( SquaredDiss(aA, aB) );
+}  // Diss
+
+template <typename ForwardIterator1, typename ForwardIterator2>
+RealType
+Euclidean::SquaredDiss(
+              std::pair<ForwardIterator1, ForwardIterator1> aA,
+              std::pair<ForwardIterator2, ForwardIterator2> aB) const
 {
    // Variabili.
+   RealType                         T;
    RealType                         D= 0;
    WeightVector::const_iterator     Wit;
 
@@ -164,9 +238,8 @@ Euclidean::Diss(
    {
       while (aA.first != aA.second)
       {
-         D+= std::pow(
-                static_cast<RealType>(*aA.first++) - static_cast<RealType>(*aB.first++),
-                2);
+         T= static_cast<RealType>(*aA.first++) - static_cast<RealType>(*aB.first++);
+         D+= T * T;
       }
    }
    else
@@ -174,18 +247,17 @@ Euclidean::Diss(
       Wit= mWeights.begin();
       while (aA.first != aA.second)
       {
-         D+= std::pow(
-                static_cast<RealType>(*aA.first++) - static_cast<RealType>(*aB.first++),
-                2) * (*Wit++);
+         T= static_cast<RealType>(*aA.first++) - static_cast<RealType>(*aB.first++);
+         D+= T * T * (*Wit++);
       }
    }
 
-   return std::sqrt(D);
-}  // Diss
+   return D;
+}  // SquaredDiss
 
 template <typename SequenceContainer1, typename SequenceContainer2>
 RealType
-Euclidean::Diss(
+Euclidean::SquaredDiss(
               const SequenceContainer1& rA,
               const SequenceContainer2& rB) const
 {
@@ -207,9 +279,40 @@ Euclidean::Diss(
    #endif
 
 
-   return Diss(std::make_pair(rA.begin(), rA.end()), std::make_pair(rB.begin(), rB.end()));
+   return SquaredDiss(std::make_pair(rA.begin(), rA.end()), std::make_pair(rB.begin(), rB.end()));
 
-}  // Diss
+}  // SquaredDiss
+
+inline
+RealType
+Euclidean::SquaredDiss(
+              const DenseVector&   rA,
+              const DenseVector&   rB) const
+{
+   // Controllo.
+   #if SPARE_DEBUG
+   if ( rA.size() != rB.size() )
+   {
+      throw SpareLogicError("Euclidean, 7, Different lenghts between inputs.");
+   }
+
+   if ( !mWeights.empty() )
+   {
+      if ( mWeights.size() != rA.size() )
+      {
+         throw SpareLogicError("Euclidean, 8, Different lenghts between inputs and "
+                               "weights.");
+      }
+   }
+   #endif
+
+   if ( mWeights.empty() )
+   {
+      return VectorKernels::SquaredDistance(rA.data(), rB.data(), rA.size());
+   }
+
+   return VectorKernels::WeightedSquaredDistance(rA.data(), rB.data(), mWeights.data(), rA.size());
+}  // SquaredDiss
 
 template <typename ForwardIterator>
 void
@@ -28,14 +28,20 @@
 // STD INCLUDES
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <string>
 #include <utility>
 #include <vector>
 
 // BOOST INCLUDES
+#include <boost/cstdint.hpp>
 #include <boost/numeric/conversion/converter.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_cv.hpp>
 
 // SPARE INCLUDES
 #include <spare/SpareExceptions.hpp>
@@ -55,6 +61,17 @@ static const size_t      LVSTH_NSVAL_SZ= 2;
  * generalized to a generic input space where is defined a distance between patterns.
  * The calculated distance could be normalized in [0, 1] setting the proper parameter.
  * This implementation uses a static set of edit costs.
+ * When both sequences have the same integral element type (e.g. char strings or symbolized
+ * sequences), the distance is computed by the bit-parallel algorithm of Myers, in the
+ * formulation of Hyyr&ouml;, in O(ceil(m/64) n) word operations, where m is the length of the
+ * shorter sequence and n the length of the longer one. Longer sequences are split in blocks
+ * of 64 symbols. Other element types are compared by the classic dynamic programming
+ * algorithm, keeping two rows of the matrix.
+ * The bounded Diss overloads return the exact distance when it does not exceed a given bound,
+ * and a value greater than the bound otherwise: the dynamic programming is restricted to the
+ * diagonal band of half-width equal to the bound (Ukkonen cut-off) and abandoned as soon as a
+ * whole row exceeds it, while the bit-parallel algorithm stops when the bound can no longer be
+ * met.
  *
  * <b>Parameter summary</b>
  *  <table class="contents">
@@ -126,6 +143,38 @@ public:
                                         std::make_pair( rB.begin(), rB.end() ) );
                            }
 
+   /** Bounded Levenshtein distance computation.
+    *
+    * @param[in] aA A pair of iterator of the first vector.
+    * @param[in] aB A pair of iterator of the second vector.
+    * @param[in] aBound The bound, normalized as the distance.
+    * @return The value of the distance if not greater than aBound, a greater value otherwise.
+    */
+   template <typename ForwardIterator1, typename ForwardIterator2>
+   RealType             Diss(
+                           std::pair<ForwardIterator1, ForwardIterator1> aA,
+                           std::pair<ForwardIterator2, ForwardIterator2> aB,
+                           RealType                                      aBound) const;
+
+   /** Bounded Levenshtein distance computation.
+    *
+    * @param[in] rA A reference to the first container.
+    * @param[in] rB A reference to the second container.
+    * @param[in] aBound The bound, normalized as the distance.
+    * @return The value of the distance if not greater than aBound, a greater value otherwise.
+    */
+   template <typename SequenceContainer1, typename SequenceContainer2>
+   RealType             Diss(
+                           const SequenceContainer1& rA,
+                           const SequenceContainer2& rB,
+                           RealType                  aBound) const
+                           {
+                              return Diss(
+                                        std::make_pair( rA.begin(), rA.end() ),
+                                        std::make_pair( rB.begin(), rB.end() ),
+                                        aBound);
+                           }
+
 // ACCESS
 
    /** Read/Write access to the normalization flag.
@@ -151,12 +200,49 @@ private:
       std::vector<NaturalType>::size_type
          ColIndexType;
 
+   // Parola dell'algoritmo bit-parallelo.
+   typedef boost::uint64_t
+                        WordType;
+
    // Switch normalizzazione.
    StringParam          mNormalization;
 
-   // Matrice per calcolo interno.
-   mutable std::vector<std::vector<NaturalType> >
-                        mMat;
+   // Distanza tra sequenze di lunghezza M e N non nulle e |M - N| <= K, se non supera K;
+   // altrimenti K + 1. Con K = max(M, N) il calcolo è completo.
+   template <typename ForwardIterator1, typename ForwardIterator2>
+   RealType             Evaluate(
+                           std::pair<ForwardIterator1, ForwardIterator1> aA,
+                           std::pair<ForwardIterator2, ForwardIterator2> aB,
+                           RowIndexType                                  M,
+                           ColIndexType                                  N,
+                           NaturalType                                   K) const;
+
+   // Programmazione dinamica a due righe nella banda |i - j| <= K.
+   template <typename ForwardIterator1, typename ForwardIterator2>
+   static NaturalType   Distance(
+                           std::pair<ForwardIterator1, ForwardIterator1> aA,
+                           std::pair<ForwardIterator2, ForwardIterator2> aB,
+                           RowIndexType                                  M,
+                           ColIndexType                                  N,
+                           NaturalType                                   K,
+                           boost::false_type);
+
+   // Algoritmo bit-parallelo, simboli interi.
+   template <typename ForwardIterator1, typename ForwardIterator2>
+   static NaturalType   Distance(
+                           std::pair<ForwardIterator1, ForwardIterator1> aA,
+                           std::pair<ForwardIterator2, ForwardIterator2> aB,
+                           RowIndexType                                  M,
+                           ColIndexType                                  N,
+                           NaturalType                                   K,
+                           boost::true_type);
+
+   // Algoritmo bit-parallelo: rP è il pattern (la sequenza più corta), rT il testo.
+   template <typename SymbolType>
+   static NaturalType   BitParallel(
+                           const std::vector<SymbolType>&   rP,
+                           const std::vector<SymbolType>&   rT,
+                           NaturalType                      K);
 
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
@@ -182,15 +268,10 @@ Levenshtein::Diss(
                  std::pair<ForwardIterator2, ForwardIterator2> aB) const
 {
    // Variabili.
-   ForwardIterator1  Ait;
-   ForwardIterator2  Bit;
-   NaturalType       Cost;
    RowIndexType      M;
    RealType          M_;
    ColIndexType      N;
    RealType          N_;
-   RowIndexType      i;
-   ColIndexType      j;
 
    // Controllo.
    #if SPARE_DEBUG
@@ -252,32 +333,188 @@ Levenshtein::Diss(
       }
    }
 
-   // Dimensiono e inizializzo matrice.
-   mMat.resize(M+1);
+   return Evaluate( aA, aB, M, N, boost::numeric::converter<NaturalType, RowIndexType>
+                                  ::convert( std::max<RowIndexType>(M, N) ) );
+}  // Diss
 
-   for (i= 0; i <= M; i++)
+template <typename ForwardIterator1, typename ForwardIterator2>
+RealType
+Levenshtein::Diss(
+                 std::pair<ForwardIterator1, ForwardIterator1> aA,
+                 std::pair<ForwardIterator2, ForwardIterator2> aB,
+                 RealType                                      aBound) const
+{
+   // Variabili.
+   RowIndexType      M;
+   ColIndexType      N;
+   RowIndexType      L;
+   RealType          L_;
+   RealType          Raw;
+   RowIndexType      K;
+
+   // Typedef.
+   typedef
+      typename std::iterator_traits<ForwardIterator1>::difference_type
+         DiffType1;
+
+   typedef
+      typename std::iterator_traits<ForwardIterator2>::difference_type
+         DiffType2;
+
+   M= boost::numeric::converter<RowIndexType, DiffType1>::convert(
+      std::distance(aA.first, aA.second) );
+
+   N= boost::numeric::converter<ColIndexType, DiffType2>::convert(
+      std::distance(aB.first, aB.second) );
+
+   // Con una sequenza vuota la distanza è immediata.
+   if ( (M == 0) || (N == 0) )
    {
-      mMat[i].resize(N+1);
+      return Diss(aA, aB);
    }
 
-   for (i= 0; i <= M; i++)
+   if (aBound < 0)
    {
-      mMat[i][0]= boost::numeric::converter<NaturalType, RowIndexType>::convert(i);
+      return std::numeric_limits<RealType>::max();
    }
 
+   // Limite sul numero di operazioni: il più grande K con K (normalizzato) <= aBound.
+   L= std::max<RowIndexType>(M, N);
+   L_= boost::numeric::converter<RealType, RowIndexType>::convert(L);
+   Raw= (mNormalization == "On") ? aBound * L_ : aBound;
+   if (Raw >= L_)
+   {
+      K= L;
+   }
+   else
+   {
+      K= static_cast<RowIndexType>(Raw);
+      if ( (mNormalization == "On") &&
+           ( static_cast<RealType>(K + 1) / L_ <= aBound ) )
+      {
+         ++K;
+      }
+   }
+
+   // Differenza di lunghezza oltre il limite.
+   if ( ( (M > N) ? M - N : N - M ) > K )
+   {
+      return std::numeric_limits<RealType>::max();
+   }
+
+   return Evaluate( aA, aB, M, N, boost::numeric::converter<NaturalType, RowIndexType>
+                                  ::convert(K) );
+}  // Diss
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+template <typename ForwardIterator1, typename ForwardIterator2>
+RealType
+Levenshtein::Evaluate(
+                 std::pair<ForwardIterator1, ForwardIterator1> aA,
+                 std::pair<ForwardIterator2, ForwardIterator2> aB,
+                 RowIndexType                                  M,
+                 ColIndexType                                  N,
+                 NaturalType                                   K) const
+{
+   // Typedef.
+   typedef
+      typename boost::remove_cv<
+         typename std::iterator_traits<ForwardIterator1>::value_type>::type
+            ValueType1;
+
+   typedef
+      typename boost::remove_cv<
+         typename std::iterator_traits<ForwardIterator2>::value_type>::type
+            ValueType2;
+
+   // Variabili.
+   NaturalType       Cost;
+   RealType          M_= boost::numeric::converter<RealType, RowIndexType>::convert(M);
+   RealType          N_= boost::numeric::converter<RealType, ColIndexType>::convert(N);
+
+   // Algoritmo bit-parallelo se i simboli sono interi dello stesso tipo.
+   Cost= Distance(
+            aA,
+            aB,
+            M,
+            N,
+            K,
+            boost::integral_constant<bool,
+                                     boost::is_integral<ValueType1>::value &&
+                                     boost::is_same<ValueType1, ValueType2>::value>() );
+
+   if (Cost > K)
+   {
+      return std::numeric_limits<RealType>::max();
+   }
+
+   if (mNormalization == "On")
+   {
+      return NaturalToReal::convert(Cost) / std::max(M_, N_);
+   }
+   else
+   {
+      return NaturalToReal::convert(Cost);
+   }
+}  // Evaluate
+
+template <typename ForwardIterator1, typename ForwardIterator2>
+NaturalType
+Levenshtein::Distance(
+                 std::pair<ForwardIterator1, ForwardIterator1> aA,
+                 std::pair<ForwardIterator2, ForwardIterator2> aB,
+                 RowIndexType,
+                 ColIndexType                                  N,
+                 NaturalType                                   K,
+                 boost::false_type)
+{
+   // Variabili.
+   ForwardIterator1  Ait;
+   ForwardIterator2  Bit;
+   std::vector<ForwardIterator2>
+                     Cols;
+   std::vector<NaturalType>
+                     Prev(N + 1);
+   std::vector<NaturalType>
+                     Cur(N + 1);
+   const NaturalType Inf= K + 1;
+   NaturalType       Cost;
+   NaturalType       RowMin;
+   RowIndexType      i;
+   ColIndexType      j;
+   ColIndexType      Lo;
+   ColIndexType      Hi;
+
+   // Accesso diretto alle colonne.
+   Cols.reserve(N);
+   for (Bit= aB.first; Bit != aB.second; Bit++)
+   {
+      Cols.push_back(Bit);
+   }
+
+   // Prima riga: D[0][j] = j.
    for (j= 0; j <= N; j++)
    {
-      mMat[0][j]= boost::numeric::converter<NaturalType, ColIndexType>::convert(j);
+      Prev[j]= (j <= K) ? boost::numeric::converter<NaturalType, ColIndexType>::convert(j)
+                        : Inf;
    }
 
-   // Calcolo distanza.
+   // Calcolo distanza nella banda |i - j| <= K; fuori banda i valori sono Inf.
    i= 1;
    for (Ait= aA.first; Ait != aA.second; Ait++)
    {
-      j= 1;
-      for (Bit= aB.first; Bit != aB.second; Bit++)
+      Lo= (i > K) ? i - K : 1;
+      Hi= std::min<ColIndexType>(N, i + K);
+
+      Cur[Lo - 1]= ( (Lo == 1) && (i <= K) )
+                   ? boost::numeric::converter<NaturalType, RowIndexType>::convert(i)
+                   : Inf;
+      RowMin= Cur[Lo - 1];
+
+      for (j= Lo; j <= Hi; j++)
       {
-         if (*Ait == *Bit)
+         if (*Ait == *Cols[j - 1])
          {
             Cost= 0;
          }
@@ -286,27 +523,191 @@ Levenshtein::Diss(
             Cost= 1;
          }
 
-         mMat[i][j]= std::min(
-                             mMat[i-1][j]+1,
-                             std::min(
-                                     mMat[i][j-1]+1,
-                                     mMat[i-1][j-1]+Cost) );
+         Cur[j]= std::min(
+                        Inf,
+                        std::min(
+                                Prev[j]+1,
+                                std::min(
+                                        Cur[j-1]+1,
+                                        Prev[j-1]+Cost) ) );
+
+         RowMin= std::min(RowMin, Cur[j]);
+      }
+
+      if (Hi < N)
+      {
+         Cur[Hi + 1]= Inf;
+      }
 
-         j++;
+      // Tutta la riga oltre il limite: abbandono.
+      if (RowMin > K)
+      {
+         return Inf;
       }
 
+      Prev.swap(Cur);
       i++;
    }
 
-   if (mNormalization == "On")
+   return Prev[N];
+}  // Distance
+
+template <typename ForwardIterator1, typename ForwardIterator2>
+NaturalType
+Levenshtein::Distance(
+                 std::pair<ForwardIterator1, ForwardIterator1> aA,
+                 std::pair<ForwardIterator2, ForwardIterator2> aB,
+                 RowIndexType                                  M,
+                 ColIndexType                                  N,
+                 NaturalType                                   K,
+                 boost::true_type)
+{
+   // Typedef.
+   typedef
+      typename boost::remove_cv<
+         typename std::iterator_traits<ForwardIterator1>::value_type>::type
+            SymbolType;
+
+   // Variabili.
+   std::vector<SymbolType>
+                     A(aA.first, aA.second);
+   std::vector<SymbolType>
+                     B(aB.first, aB.second);
+
+   // Il pattern è la sequenza più corta: meno blocchi per colonna.
+   if (M <= N)
    {
-      return NaturalToReal::convert( mMat[M][N] ) / std::max(M_, N_);
+      return BitParallel(A, B, K);
    }
    else
    {
-      return NaturalToReal::convert( mMat[M][N] );
+      return BitParallel(B, A, K);
    }
-}  // Diss
+}  // Distance
+
+template <typename SymbolType>
+NaturalType
+Levenshtein::BitParallel(
+                 const std::vector<SymbolType>&   rP,
+                 const std::vector<SymbolType>&   rT,
+                 NaturalType                      K)
+{
+   // Typedef.
+   typedef typename std::vector<SymbolType>::const_iterator
+                        SymbolIterator;
+
+   typedef std::vector<WordType>::size_type
+                        SizeType;
+
+   // Costanti.
+   const SizeType       W= 64;
+   const SizeType       M= rP.size();
+   const SizeType       Blocks= (M + W - 1) / W;
+   const WordType       Last= WordType(1) << ( (M - 1) % W );
+   const WordType       Top= WordType(1) << (W - 1);
+
+   // Variabili.
+   std::vector<SymbolType>
+                        Sigma(rP);
+   std::vector<SizeType>
+                        ByteIndex;
+   std::vector<WordType>
+                        Peq;
+   std::vector<WordType>
+                        Pv(Blocks, ~WordType(0));
+   std::vector<WordType>
+                        Mv(Blocks, WordType(0));
+   SymbolIterator       Tit;
+   SymbolIterator       Sit;
+   SizeType             Left= rT.size();
+   const WordType*      pEq;
+   WordType             Eq, Xv, Xh, Ph, Mh, High;
+   SizeType             b, i, s;
+   int                  Hin, Hout;
+   NaturalType          Score= boost::numeric::converter<NaturalType, SizeType>::convert(M);
+
+   // Alfabeto del pattern, ordinato.
+   std::sort(Sigma.begin(), Sigma.end());
+   Sigma.erase(std::unique(Sigma.begin(), Sigma.end()), Sigma.end());
+
+   // Per simboli di un byte la ricerca nell'alfabeto è una tabella.
+   if (sizeof(SymbolType) == 1)
+   {
+      ByteIndex.assign(256, Sigma.size());
+      for (s= 0; s < Sigma.size(); s++)
+      {
+         ByteIndex[static_cast<unsigned char>(Sigma[s])]= s;
+      }
+   }
+
+   // Maschere di uguaglianza, Blocks parole per simbolo; l'ultima riga (nulla) è per i
+   // simboli del testo assenti dal pattern.
+   Peq.assign( (Sigma.size() + 1) * Blocks, WordType(0) );
+   for (i= 0; i < M; i++)
+   {
+      s= std::lower_bound(Sigma.begin(), Sigma.end(), rP[i]) - Sigma.begin();
+      Peq[s * Blocks + i / W]|= WordType(1) << (i % W);
+   }
+
+   for (Tit= rT.begin(); Tit != rT.end(); ++Tit)
+   {
+      if ( !ByteIndex.empty() )
+      {
+         s= ByteIndex[static_cast<unsigned char>(*Tit)];
+      }
+      else
+      {
+         Sit= std::lower_bound(Sigma.begin(), Sigma.end(), *Tit);
+         s= ( (Sit != Sigma.end()) && (*Sit == *Tit) ) ? Sit - Sigma.begin() : Sigma.size();
+      }
+
+      pEq= &Peq[s * Blocks];
+
+      // La prima riga della matrice vale D[0][j] = j: differenza orizzontale +1.
+      Hin= 1;
+      for (b= 0; b < Blocks; b++)
+      {
+         Eq= pEq[b];
+         Xv= Eq | Mv[b];
+         if (Hin < 0)
+         {
+            Eq|= 1;
+         }
+         Xh= ( ( (Eq & Pv[b]) + Pv[b] ) ^ Pv[b] ) | Eq;
+         Ph= Mv[b] | ~(Xh | Pv[b]);
+         Mh= Pv[b] & Xh;
+
+         // Differenza orizzontale sull'ultima riga del blocco.
+         High= (b + 1 == Blocks) ? Last : Top;
+         Hout= (Ph & High) ? 1 : ( (Mh & High) ? -1 : 0 );
+
+         Ph<<= 1;
+         Mh<<= 1;
+         if (Hin < 0)
+         {
+            Mh|= 1;
+         }
+         else if (Hin > 0)
+         {
+            Ph|= 1;
+         }
+
+         Pv[b]= Mh | ~(Xv | Ph);
+         Mv[b]= Ph & Xv;
+         Hin= Hout;
+      }
+
+      Score+= Hin;
+
+      // Ogni colonna residua riduce il punteggio al più di uno.
+      if ( (Score > --Left) && (Score - Left > K) )
+      {
+         return K + 1;
+      }
+   }
+
+   return Score;
+}  // BitParallel
 
 }  // namespace spare
 
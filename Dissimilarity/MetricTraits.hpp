@@ -0,0 +1,84 @@
+//  MetricTraits, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File MetricTraits.hpp, containing the IsMetric trait.
+ *
+ * The file contains the IsMetric trait, declaring which dissimilarity measures (and which
+ * representatives built on them) satisfy the metric axioms, in particular the triangle
+ * inequality.
+ *
+ * @file MetricTraits.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _MetricTraits_h_
+#define _MetricTraits_h_
+
+// BOOST INCLUDES
+#include <boost/type_traits/integral_constant.hpp>
+
+namespace spare {  // Inclusione in namespace spare.
+
+// Forward declarations.
+class Delta;
+class Euclidean;
+class Hamming;
+class Minkowski;
+class ModuleDistance;
+
+template <typename Dissimilarity, typename StorageType>
+class Centroid;
+
+template <typename SampleType, typename Dissimilarity>
+class MinSod;
+
+/** @brief Metric declaration trait.
+ *
+ * IsMetric<T>::value is true if the dissimilarity measure T is a metric. Algorithms may
+ * exploit the triangle inequality only for metric types, falling back to exhaustive
+ * evaluations otherwise. A representative is metric when the dissimilarity used for both
+ * representative/sample and representative/representative comparisons is metric.
+ * The declaration of Euclidean and Minkowski assumes non-negative weights and, for the
+ * latter, an order not lower than 1. User-defined metric dissimilarities can be declared by
+ * specializing the trait.
+ */
+template <typename T>
+struct IsMetric : boost::false_type { };
+
+template <>
+struct IsMetric<Delta> : boost::true_type { };
+
+template <>
+struct IsMetric<Euclidean> : boost::true_type { };
+
+template <>
+struct IsMetric<Hamming> : boost::true_type { };
+
+template <>
+struct IsMetric<Minkowski> : boost::true_type { };
+
+template <>
+struct IsMetric<ModuleDistance> : boost::true_type { };
+
+template <typename Dissimilarity, typename StorageType>
+struct IsMetric< Centroid<Dissimilarity, StorageType> > : IsMetric<Dissimilarity> { };
+
+template <typename SampleType, typename Dissimilarity>
+struct IsMetric< MinSod<SampleType, Dissimilarity> > : IsMetric<Dissimilarity> { };
+
+}  // namespace spare
+
+#endif  // _MetricTraits_h_
@@ -41,6 +41,7 @@
 #include <spare/BoundedParameter.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
+#include <spare/VectorKernels.hpp>
 
 namespace spare {  // Inclusione in namespace spare.
 
@@ -51,11 +52,22 @@ namespace spare {  // Inclusione in namespace spare.
  * real vectors. It's possible to weight the components of the vectors differently usign a
  * proper weight vector. It uses a parameter p, that by default is set to 2, that is an
  * Euclidean distance.
+ * The powers of the component differences are computed by repeated multiplication, and the
+ * orders 1 and 2 skip the final root (2 takes a square root). Vectors stored as
+ * std::vector<RealType> take a fast path working on contiguous memory, with the SIMD kernels
+ * of VectorKernels for the unweighted order 1 and for the order 2.
  */
 class Minkowski
 {
 public:
 
+// PUBLIC TYPES
+
+   /** Dense real vector.
+    */
+   typedef std::vector<RealType>
+                        DenseVector;
+
 	/** Unsigned strictly positive integer parameter type.
 	 */
 	typedef BoundedParameter<NaturalType>
@@ -95,6 +107,16 @@ public:
                            const SequenceContainer1& rA,
                            const SequenceContainer2& rB) const;
 
+   /** Minkowski distance computation, contiguous fast path.
+    *
+    * @param[in] rA A reference to the first vector.
+    * @param[in] rB A reference to the second vector.
+    * @return The distance value.
+    */
+   RealType             Diss(
+                           const DenseVector&   rA,
+                           const DenseVector&   rB) const;
+
 // SETUP
 
    /** Setup the weight vector.
@@ -127,6 +149,12 @@ public:
 	 */
 	const NaturalParam&  P() const    		{ return mP; }
 
+   /** Check of the presence of a weight vector.
+    *
+    * @return True if the components are weighted.
+    */
+   bool                 IsWeighted() const         { return !mWeights.empty(); }
+
 private:
 
    // Distance order
@@ -139,6 +167,44 @@ private:
    // Vettore contenente i pesi.
    WeightVector         mWeights;
 
+   // Potenza intera aX^aP (aP >= 1), per quadrati successivi.
+   static RealType      Power(
+                           RealType       aX,
+                           NaturalType    aP)
+                           {
+                              RealType R= 1;
+
+                              while (true)
+                              {
+                                 if (aP & 1)
+                                 {
+                                    R*= aX;
+                                 }
+                                 aP>>= 1;
+                                 if (!aP)
+                                 {
+                                    return R;
+                                 }
+                                 aX*= aX;
+                              }
+                           }
+
+   // Radice aP-esima della somma delle potenze.
+   static RealType      Root(
+                           RealType       aD,
+                           NaturalType    aP)
+                           {
+                              switch (aP)
+                              {
+                                 case 1:
+                                    return aD;
+                                 case 2:
+                                    return std::sqrt(aD);
+                                 default:
+                                    return std::pow(aD, 1 / static_cast<RealType>(aP));
+                              }
+                           }
+
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
 
@@ -166,7 +232,7 @@ Minkowski::Diss(
    // Variabili.
    RealType                         D= 0;
    WeightVector::const_iterator     Wit;
-   RealType p=boost::numeric::converter<RealType, NaturalType>::convert(mP);
+   NaturalType                      P_= mP;
 
    // Controllo.
    #if SPARE_DEBUG
@@ -204,10 +270,10 @@ Minkowski::Diss(
    {
       while (aA.first != aA.second)
       {
-         D+= std::pow(
+         D+= Power(
                 std::abs(static_cast<RealType>(*aA.first++)
                          - static_cast<RealType>(*aB.first++)),
-                p);
+                P_);
       }
    }
    else
@@ -215,14 +281,14 @@ Minkowski::Diss(
       Wit= mWeights.begin();
       while (aA.first != aA.second)
       {
-         D+= std::pow(
+         D+= Power(
         		 std::abs(static_cast<RealType>(*aA.first++)
                       - static_cast<RealType>(*aB.first++)),
-                p) * (*Wit++);
+                P_) * (*Wit++);
       }
    }
 
-   return std::pow(D, 1/p);
+   return Root(D, P_);
 }  // Diss
 
 template <typename SequenceContainer1, typename SequenceContainer2>
@@ -252,6 +318,51 @@ Minkowski::Diss(
    return Diss(std::make_pair(rA.begin(), rA.end()), std::make_pair(rB.begin(), rB.end()));
 }  // Diss
 
+inline
+RealType
+Minkowski::Diss(
+              const DenseVector&   rA,
+              const DenseVector&   rB) const
+{
+   // Variabili.
+   NaturalType                      P_= mP;
+
+   // Controllo.
+   #if SPARE_DEBUG
+   if ( rA.size() != rB.size() )
+   {
+      throw SpareLogicError("Minkowski, 7, Different lenghts between inputs.");
+   }
+
+   if ( !mWeights.empty() )
+   {
+      if ( mWeights.size() != rA.size() )
+      {
+         throw SpareLogicError("Minkowski, 8, Different lenghts between inputs and "
+                               "weights.");
+      }
+   }
+   #endif
+
+   if (P_ == 2)
+   {
+      if ( mWeights.empty() )
+      {
+         return std::sqrt( VectorKernels::SquaredDistance(rA.data(), rB.data(), rA.size()) );
+      }
+
+      return std::sqrt( VectorKernels::WeightedSquaredDistance(
+                                          rA.data(), rB.data(), mWeights.data(), rA.size()) );
+   }
+
+   if ( (P_ == 1) && mWeights.empty() )
+   {
+      return VectorKernels::AbsDistance(rA.data(), rB.data(), rA.size());
+   }
+
+   return Diss(std::make_pair(rA.begin(), rA.end()), std::make_pair(rB.begin(), rB.end()));
+}  // Diss
+
 template <typename ForwardIterator>
 void
 Minkowski::WeightSetup(std::pair<ForwardIterator, ForwardIterator> aW)
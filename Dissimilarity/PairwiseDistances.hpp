@@ -0,0 +1,502 @@
+//  PairwiseDistances class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File PairwiseDistances.hpp, containing the PairwiseDistances class.
+ *
+ * The file contains the PairwiseDistances class, computing the euclidean distances between two
+ * sets of dense real vectors through blocked matrix products, and the HasPairwiseDistances
+ * trait. It depends on the Eigen 3 library: Kmeans and DissimilarityRepr use it only when the
+ * SPARE_USE_EIGEN macro is defined.
+ *
+ * @file PairwiseDistances.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _PairwiseDistances_h_
+#define _PairwiseDistances_h_
+
+// STD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+// EIGEN INCLUDES
+#include <Eigen/Core>
+
+// BOOST INCLUDES
+#include <boost/bind/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+// SPARE INCLUDES
+#include <spare/Executor.hpp>
+#include <spare/SpareExceptions.hpp>
+#include <spare/SpareTypes.hpp>
+#include <spare/VectorKernels.hpp>
+
+namespace spare {  // Inclusione in namespace spare.
+
+// Forward declarations.
+class Euclidean;
+
+template <typename Dissimilarity, typename StorageType>
+class Centroid;
+
+/** @brief Pairwise distances declaration trait.
+ *
+ * HasPairwiseDistances<T, SampleType>::value is true if the dissimilarities of T (a
+ * dissimilarity measure or a representative) between samples of type SampleType are the
+ * euclidean distances between dense real vectors, which PairwiseDistances can compute many at
+ * once. The weights of the measure are not taken into account: the users of the trait must
+ * check at run-time that the measure is not weighted.
+ */
+template <typename T, typename SampleType>
+struct HasPairwiseDistances : boost::false_type { };
+
+template <>
+struct HasPairwiseDistances<Euclidean, std::vector<RealType> > : boost::true_type { };
+
+template <>
+struct HasPairwiseDistances<Centroid<Euclidean, RealType>, std::vector<RealType> >
+   : boost::true_type { };
+
+/** @brief Many-to-many euclidean distances between dense real vectors.
+ *
+ * %PairwiseDistances computes the (unweighted) euclidean distances between each row of a
+ * matrix A and each row of a matrix B, using
+ * @f$\|a - b\|^2 = \|a\|^2 + \|b\|^2 - 2 a \cdot b@f$: the dot products of a block of rows of A
+ * with a block of rows of B are a single matrix product, carried out by Eigen with its
+ * cache-blocked and vectorized kernels. The rows of A are processed in blocks of 128,
+ * concurrently on an Executor (see ExecutorSetup), and each block is multiplied by the rows of B
+ * in blocks of 256, so the partial products fit in the cache.
+ * Both sets are translated by the mean of the rows of B, which does not change the distances and
+ * reduces the cancellation of the expansion. Moreover, every value whose rounding error bound
+ * exceeds 1e-8 times the value itself (e.g. between equal or very close vectors) is recomputed
+ * directly with VectorKernels::SquaredDistance: SquaredDiss then equals the SquaredDiss method
+ * of Euclidean up to a relative error of 1e-8, and is 0 between equal vectors. Closest uses the
+ * same bounds to evaluate directly only the candidates, and gives exactly the result of
+ * LinearScan on unweighted Centroid<Euclidean> representatives.
+ * The vectors are stored as the rows of a row-major Eigen matrix (see Pack); the output
+ * matrices are boost-compliant (i.e. accessed as rOut(i, j)) and must be pre-allocated.
+ */
+class PairwiseDistances
+{
+public:
+
+// PUBLIC TYPES
+
+   /** Matrix storing a set of vectors, one per row.
+    */
+   typedef Eigen::Matrix<RealType, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+                        Matrix;
+
+   /** Dense real vector.
+    */
+   typedef std::vector<RealType>
+                        DenseVector;
+
+// LIFECYCLE
+
+   /** Default constructor.
+    */
+   PairwiseDistances()
+                                                   { Eigen::initParallel(); }
+
+// OPERATIONS
+
+   /** Copy of a range of dense vectors to the rows of a matrix.
+    *
+    * @param[in] iBegin Iterator to the first vector.
+    * @param[in] iEnd Iterator to one position after the last vector.
+    * @param[out] rOut The matrix, resized to the number of vectors times their length.
+    */
+   template <typename ForwardIterator>
+   static void          Pack(
+                           ForwardIterator   iBegin,
+                           ForwardIterator   iEnd,
+                           Matrix&           rOut);
+
+   /** Euclidean distances between the rows of two matrices.
+    *
+    * @param[in] rA The first set of vectors.
+    * @param[in] rB The second set of vectors.
+    * @param[out] rOut The pre-allocated output matrix: rOut(i, j) is set to the distance
+    * between the i-th row of rA and the j-th row of rB.
+    */
+   template <typename OutMatrix>
+   void                 Diss(
+                           const Matrix&     rA,
+                           const Matrix&     rB,
+                           OutMatrix&        rOut) const
+                           {
+                              Process(rA, rB, rOut, false);
+                           }
+
+   /** Squared euclidean distances between the rows of two matrices.
+    *
+    * @param[in] rA The first set of vectors.
+    * @param[in] rB The second set of vectors.
+    * @param[out] rOut The pre-allocated output matrix: rOut(i, j) is set to the squared
+    * distance between the i-th row of rA and the j-th row of rB.
+    */
+   template <typename OutMatrix>
+   void                 SquaredDiss(
+                           const Matrix&     rA,
+                           const Matrix&     rB,
+                           OutMatrix&        rOut) const
+                           {
+                              Process(rA, rB, rOut, true);
+                           }
+
+   /** Closest row of a matrix to each row of another one.
+    *
+    * @param[in] rA The vectors to be assigned.
+    * @param[in] rB The reference vectors (at least one).
+    * @param[out] rIndex Resized to the number of rows of rA: rIndex[i] is set to the position
+    * of the row of rB closest to the i-th row of rA (the first one, on ties).
+    */
+   template <typename IndexVector>
+   void                 Closest(
+                           const Matrix&     rA,
+                           const Matrix&     rB,
+                           IndexVector&      rIndex) const;
+
+// ACCESS
+
+   /** Setup of the executor used for the parallel computations.
+    *
+    * The same executor can be shared among several components, bounding the overall number
+    * of threads.
+    *
+    * @param[in] pExecutor Shared pointer to the executor.
+    */
+   void                 ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor)
+                                                   { mExecutor= pExecutor; }
+
+   /** Read access to the executor used for the parallel computations.
+    *
+    * If no executor has been set up, a private one with one thread per hardware thread is
+    * created; the creation is safe when several threads use the same instance.
+    *
+    * @return A shared pointer to the executor.
+    */
+   const boost::shared_ptr<Executor>&
+                        GetExecutor() const
+                           {
+                              if ( !boost::atomic_load(&mExecutor) )
+                              {
+                                 boost::shared_ptr<Executor> Empty;
+                                 boost::shared_ptr<Executor> Created( new Executor );
+
+                                 // Se un altro thread ha già creato l'executor, tengo il suo.
+                                 boost::atomic_compare_exchange(&mExecutor, &Empty, Created);
+                              }
+
+                              return mExecutor;
+                           }
+
+private:
+
+   // Typedef privati.
+   typedef Matrix::Index
+                        IndexType;
+
+   typedef Eigen::Matrix<RealType, 1, Eigen::Dynamic>
+                        RowVector;
+
+   typedef Eigen::Matrix<RealType, Eigen::Dynamic, 1>
+                        ColumnVector;
+
+   // Insieme B traslato, con le norme al quadrato delle righe.
+   struct Reference
+   {
+      Matrix         Centered;
+      RowVector      Shift;
+      ColumnVector   Norms;
+      RealType       Tolerance;
+   };
+
+   // Executor per i blocchi di righe.
+   mutable boost::shared_ptr<Executor> mExecutor;
+
+   // Righe per blocco (unità di lavoro parallela).
+   static Executor::SizeType
+                        BlockRows()                { return 128; }
+
+   // Righe di B per blocco del prodotto.
+   static IndexType     BlockCols()                { return 256; }
+
+   // Traslazione di B e limite relativo dell'errore di arrotondamento.
+   static void          Prepare(const Matrix& rB, Reference& rRef);
+
+   // Distanze (o distanze al quadrato) tra le righe di A e le righe di B.
+   template <typename OutMatrix>
+   void                 Process(
+                           const Matrix&     rA,
+                           const Matrix&     rB,
+                           OutMatrix&        rOut,
+                           bool              aSquared) const;
+
+   // Distanze (o distanze al quadrato) tra le righe [aFirst, aLast) di A e le righe di B.
+   template <typename OutMatrix>
+   void                 DissRows(
+                           const Matrix*        pA,
+                           const Matrix*        pB,
+                           const Reference*     pRef,
+                           bool                 aSquared,
+                           OutMatrix*           pOut,
+                           Executor::SizeType   aFirst,
+                           Executor::SizeType   aLast) const;
+
+   // Riga di B più vicina alle righe [aFirst, aLast) di A.
+   template <typename IndexVector>
+   void                 ClosestRows(
+                           const Matrix*        pA,
+                           const Matrix*        pB,
+                           const Reference*     pRef,
+                           IndexVector*         pIndex,
+                           Executor::SizeType   aFirst,
+                           Executor::SizeType   aLast) const;
+
+}; // class PairwiseDistances
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+////////////////////////////////////// PUBLIC //////////////////////////////////////////////
+
+//==================================== OPERATIONS ==========================================
+
+template <typename ForwardIterator>
+void
+PairwiseDistances::Pack(
+                     ForwardIterator   iBegin,
+                     ForwardIterator   iEnd,
+                     Matrix&           rOut)
+{
+   IndexType   Rows= std::distance(iBegin, iEnd);
+   IndexType   Dim= (iBegin != iEnd) ? static_cast<IndexType>( iBegin->size() ) : 0;
+   IndexType   i= 0;
+
+   rOut.resize(Rows, Dim);
+   for (; iBegin != iEnd; ++iBegin)
+   {
+      if (static_cast<IndexType>( iBegin->size() ) != Dim)
+      {
+         throw SpareLogicError("PairwiseDistances, 0, Different lenghts.");
+      }
+
+      std::copy(iBegin->begin(), iBegin->end(), rOut.data() + i*Dim);
+      i++;
+   }
+}  // Pack
+
+template <typename IndexVector>
+void
+PairwiseDistances::Closest(
+                     const Matrix&     rA,
+                     const Matrix&     rB,
+                     IndexVector&      rIndex) const
+{
+   using boost::placeholders::_1;
+   using boost::placeholders::_2;
+
+   Reference   Ref;
+
+   if ( !rB.rows() )
+   {
+      throw SpareLogicError("PairwiseDistances, 1, No reference vectors.");
+   }
+
+   rIndex.resize( rA.rows() );
+   if ( !rA.rows() )
+   {
+      return;
+   }
+
+   if ( rA.cols() != rB.cols() )
+   {
+      throw SpareLogicError("PairwiseDistances, 2, Different lenghts.");
+   }
+
+   Prepare(rB, Ref);
+   GetExecutor()->ParallelFor(
+                     0,
+                     rA.rows(),
+                     BlockRows(),
+                     boost::bind(&PairwiseDistances::ClosestRows<IndexVector>,
+                                 this, &rA, &rB, &Ref, &rIndex, _1, _2) );
+}  // Closest
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+inline void
+PairwiseDistances::Prepare(const Matrix& rB, Reference& rRef)
+{
+   rRef.Shift= rB.colwise().mean();
+   rRef.Centered= rB.rowwise() - rRef.Shift;
+   rRef.Norms= rRef.Centered.rowwise().squaredNorm();
+
+   // Errore sull'espansione, sulla traslazione e sul calcolo diretto, relativo alla somma
+   // delle norme al quadrato.
+   rRef.Tolerance= 2 * (rB.cols() + 8) * std::numeric_limits<RealType>::epsilon();
+}  // Prepare
+
+template <typename OutMatrix>
+void
+PairwiseDistances::Process(
+                     const Matrix&     rA,
+                     const Matrix&     rB,
+                     OutMatrix&        rOut,
+                     bool              aSquared) const
+{
+   using boost::placeholders::_1;
+   using boost::placeholders::_2;
+
+   Reference   Ref;
+
+   if ( !rA.rows() || !rB.rows() )
+   {
+      return;
+   }
+
+   if ( rA.cols() != rB.cols() )
+   {
+      throw SpareLogicError("PairwiseDistances, 3, Different lenghts.");
+   }
+
+   Prepare(rB, Ref);
+   GetExecutor()->ParallelFor(
+                     0,
+                     rA.rows(),
+                     BlockRows(),
+                     boost::bind(&PairwiseDistances::DissRows<OutMatrix>,
+                                 this, &rA, &rB, &Ref, aSquared, &rOut, _1, _2) );
+}  // Process
+
+template <typename OutMatrix>
+void
+PairwiseDistances::DissRows(
+                     const Matrix*        pA,
+                     const Matrix*        pB,
+                     const Reference*     pRef,
+                     bool                 aSquared,
+                     OutMatrix*           pOut,
+                     Executor::SizeType   aFirst,
+                     Executor::SizeType   aLast) const
+{
+   // Accuratezza relativa richiesta al valore espanso.
+   static const RealType   Accuracy= 1e-8;
+
+   // Variabili.
+   const IndexType         Rows= aLast - aFirst;
+   const IndexType         Cols= pB->rows();
+   const IndexType         Dim= pB->cols();
+   Matrix                  Centered;
+   ColumnVector            Norms;
+   Matrix                  Tile;
+   IndexType               Count;
+   RealType                Sum;
+   RealType                Value;
+
+   Centered= pA->middleRows(aFirst, Rows).rowwise() - pRef->Shift;
+   Norms= Centered.rowwise().squaredNorm();
+
+   for (IndexType c= 0; c < Cols; c+= BlockCols())
+   {
+      Count= std::min(BlockCols(), Cols - c);
+      Tile.noalias()= Centered * pRef->Centered.middleRows(c, Count).transpose();
+
+      for (IndexType i= 0; i < Rows; i++)
+      {
+         for (IndexType j= 0; j < Count; j++)
+         {
+            Sum= Norms(i) + pRef->Norms(c + j);
+            Value= Sum - 2 * Tile(i, j);
+
+            // Cancellazione: il valore espanso non è abbastanza accurato.
+            if (pRef->Tolerance * Sum > Accuracy * Value)
+            {
+               Value= VectorKernels::SquaredDistance(
+                                       pA->data() + (aFirst + i)*Dim,
+                                       pB->data() + (c + j)*Dim,
+                                       Dim);
+            }
+
+            (*pOut)(aFirst + i, c + j)= aSquared ? Value : std::sqrt(Value);
+         }
+      }
+   }
+}  // DissRows
+
+template <typename IndexVector>
+void
+PairwiseDistances::ClosestRows(
+                     const Matrix*        pA,
+                     const Matrix*        pB,
+                     const Reference*     pRef,
+                     IndexVector*         pIndex,
+                     Executor::SizeType   aFirst,
+                     Executor::SizeType   aLast) const
+{
+   // Variabili.
+   const IndexType         Rows= aLast - aFirst;
+   const IndexType         Cols= pB->rows();
+   const IndexType         Dim= pB->cols();
+   Matrix                  Centered;
+   ColumnVector            Norms;
+   Matrix                  Tile;
+   std::vector<RealType>   Best(Rows, std::numeric_limits<RealType>::max());
+   IndexType               Count;
+   RealType                Sum;
+   RealType                Value;
+
+   Centered= pA->middleRows(aFirst, Rows).rowwise() - pRef->Shift;
+   Norms= Centered.rowwise().squaredNorm();
+
+   for (IndexType c= 0; c < Cols; c+= BlockCols())
+   {
+      Count= std::min(BlockCols(), Cols - c);
+      Tile.noalias()= Centered * pRef->Centered.middleRows(c, Count).transpose();
+
+      for (IndexType i= 0; i < Rows; i++)
+      {
+         for (IndexType j= 0; j < Count; j++)
+         {
+            Sum= Norms(i) + pRef->Norms(c + j);
+
+            // Calcolo diretto solo se il limite inferiore non esclude la riga.
+            if (Sum - 2 * Tile(i, j) - pRef->Tolerance * Sum < Best[i])
+            {
+               Value= VectorKernels::SquaredDistance(
+                                       pA->data() + (aFirst + i)*Dim,
+                                       pB->data() + (c + j)*Dim,
+                                       Dim);
+               if ( (Value < Best[i]) || (!c && !j) )
+               {
+                  Best[i]= Value;
+                  (*pIndex)[aFirst + i]= static_cast<typename IndexVector::value_type>(c + j);
+               }
+            }
+         }
+      }
+   }
+}  // ClosestRows
+
+}  // namespace spare
+
+#endif  // _PairwiseDistances_h_
@@ -0,0 +1,166 @@
+//  SquaredDiss trait, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File SquaredDiss.hpp, containing the squared dissimilarity trait and helpers.
+ *
+ * The file contains the HasSquaredDiss trait, declaring which dissimilarity measures (and
+ * representatives) provide a SquaredDiss method, and the ComparableDiss helpers, which let the
+ * nearest neighbour searches compare squared dissimilarities when available.
+ *
+ * @file SquaredDiss.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _SquaredDiss_h_
+#define _SquaredDiss_h_
+
+// STD INCLUDES
+#include <cmath>
+
+// BOOST INCLUDES
+#include <boost/type_traits/integral_constant.hpp>
+
+// SPARE INCLUDES
+#include <spare/Dissimilarity/BoundedDiss.hpp>
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusione in namespace spare.
+
+// Forward declarations.
+class Euclidean;
+
+template <typename Dissimilarity, typename StorageType>
+class Centroid;
+
+/** @brief Squared dissimilarity declaration trait.
+ *
+ * HasSquaredDiss<T>::value is true if T provides, besides the usual Diss methods, the
+ * SquaredDiss(a, b) (dissimilarity measures) or SquaredDiss(sample) (representatives) methods,
+ * returning the square of the dissimilarity, with Diss equal to the square root of SquaredDiss.
+ * Since the square root is monotone, searches which only compare dissimilarities can compare
+ * the squared values (see ComparableDiss) and take the square root of the result only.
+ */
+template <typename T>
+struct HasSquaredDiss : boost::false_type { };
+
+template <>
+struct HasSquaredDiss<Euclidean> : boost::true_type { };
+
+template <typename Dissimilarity, typename StorageType>
+struct HasSquaredDiss< Centroid<Dissimilarity, StorageType> > : HasSquaredDiss<Dissimilarity> { };
+
+// Chiamate con e senza dissimilarità al quadrato.
+template <typename DissType, typename TypeA, typename TypeB>
+inline RealType
+ComparableDissCall(
+   const DissType&   rAgent,
+   const TypeA&      rA,
+   const TypeB&      rB,
+   RealType,
+   boost::true_type)
+{
+   return rAgent.SquaredDiss(rA, rB);
+}  // ComparableDissCall
+
+template <typename DissType, typename TypeA, typename TypeB>
+inline RealType
+ComparableDissCall(
+   const DissType&   rAgent,
+   const TypeA&      rA,
+   const TypeB&      rB,
+   RealType          aBound,
+   boost::false_type)
+{
+   return BoundedDiss(rAgent, rA, rB, aBound);
+}  // ComparableDissCall
+
+template <typename RepType, typename SampleType>
+inline RealType
+ComparableDissCall(
+   const RepType&    rRep,
+   const SampleType& rSample,
+   RealType,
+   boost::true_type)
+{
+   return rRep.SquaredDiss(rSample);
+}  // ComparableDissCall
+
+template <typename RepType, typename SampleType>
+inline RealType
+ComparableDissCall(
+   const RepType&    rRep,
+   const SampleType& rSample,
+   RealType          aBound,
+   boost::false_type)
+{
+   return BoundedDiss(rRep, rSample, aBound);
+}  // ComparableDissCall
+
+/** Comparable dissimilarity between two objects.
+ *
+ * The comparable dissimilarity is the squared dissimilarity when the measure provides it (see
+ * HasSquaredDiss), the dissimilarity itself otherwise; ComparableToDiss converts it back.
+ * The bound, in comparable units, is used by the measures providing a bounded dissimilarity.
+ *
+ * @param[in] rAgent The dissimilarity measure.
+ * @param[in] rA The first object.
+ * @param[in] rB The second object.
+ * @param[in] aBound The bound.
+ * @return The comparable dissimilarity, or a value greater than aBound if it exceeds it.
+ */
+template <typename DissType, typename TypeA, typename TypeB>
+inline RealType
+ComparableDiss(
+   const DissType&   rAgent,
+   const TypeA&      rA,
+   const TypeB&      rB,
+   RealType          aBound)
+{
+   return ComparableDissCall(rAgent, rA, rB, aBound, HasSquaredDiss<DissType>());
+}  // ComparableDiss
+
+/** Comparable dissimilarity between a representative and a sample.
+ *
+ * @param[in] rRep The representative.
+ * @param[in] rSample The sample.
+ * @param[in] aBound The bound, in comparable units.
+ * @return The comparable dissimilarity, or a value greater than aBound if it exceeds it.
+ */
+template <typename RepType, typename SampleType>
+inline RealType
+ComparableDiss(
+   const RepType&    rRep,
+   const SampleType& rSample,
+   RealType          aBound)
+{
+   return ComparableDissCall(rRep, rSample, aBound, HasSquaredDiss<RepType>());
+}  // ComparableDiss
+
+/** Conversion of a comparable dissimilarity of T to the dissimilarity.
+ *
+ * @param[in] aValue The comparable dissimilarity.
+ * @return The dissimilarity.
+ */
+template <typename T>
+inline RealType
+ComparableToDiss(RealType aValue)
+{
+   return HasSquaredDiss<T>::value ? std::sqrt(aValue) : aValue;
+}  // ComparableToDiss
+
+}  // namespace spare
+
+#endif  // _SquaredDiss_h_
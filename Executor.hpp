@@ -0,0 +1,640 @@
+//  Executor class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File Executor.hpp, containing the %Executor class.
+ *
+ * The file contains the %Executor class, a work-stealing thread pool shared by the
+ * multi-threaded components of the library.
+ *
+ * @file Executor.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _Executor_h_
+#define _Executor_h_
+
+// STD INCLUDES
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <vector>
+
+// BOOST INCLUDES
+#include <boost/bind/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// SPARE INCLUDES
+#include <spare/SpareExceptions.hpp>
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusion in namespace spare.
+
+/** @brief Work-stealing thread pool.
+ *
+ * %Executor owns a fixed set of worker threads, whose number is chosen at run-time, and
+ * executes on them the chunks generated by the ParallelFor and ParallelReduce methods. Each
+ * worker has its own task queue: a worker takes its own tasks in LIFO order and steals the
+ * tasks of the other queues in FIFO order when idle. The thread calling ParallelFor takes part
+ * to the computation, hence an executor with N threads spawns N-1 workers.
+ * ParallelFor and ParallelReduce can be called from inside a task running on the same
+ * executor: the waiting thread keeps executing queued tasks instead of blocking, so nested
+ * parallel sections (e.g. a clustering run inside a parallel fitness evaluation) share the same
+ * bounded set of threads without oversubscribing the cores.
+ * The workers can be optionally bound to a user-defined list of CPUs (Linux only).
+ * Exceptions thrown by a chunk are propagated to the caller of ParallelFor/ParallelReduce
+ * after all the chunks of the call have terminated.
+ */
+class Executor : private boost::noncopyable
+{
+public:
+
+// PUBLIC TYPES
+
+   /** Index type used for the parallel ranges.
+    */
+   typedef std::size_t  SizeType;
+
+   /** Container of CPU identifiers used for thread affinity.
+    */
+   typedef std::vector<NaturalType>
+                        CpuVector;
+
+// LIFECYCLE
+
+   /** Constructor.
+    *
+    * @param[in] aThreads Number of threads, including the calling one. If 0, the number of
+    * hardware threads is used.
+    */
+   explicit             Executor(NaturalType aThreads= 0)
+                                                   { Start(aThreads, CpuVector()); }
+
+   /** Constructor with thread affinity.
+    *
+    * @param[in] aThreads Number of threads, including the calling one. If 0, the number of
+    * hardware threads is used.
+    * @param[in] rCpus CPU identifiers: the i-th worker is bound to rCpus[i % rCpus.size()].
+    */
+                        Executor(
+                           NaturalType       aThreads,
+                           const CpuVector&  rCpus)
+                                                   { Start(aThreads, rCpus); }
+
+   /** Destructor: waits for the queued tasks and joins the workers.
+    */
+                        ~Executor();
+
+// OPERATIONS
+
+   /** Parallel loop over an index range.
+    *
+    * The range [aFirst, aLast) is split in chunks of aGrain indices, and aBody(First, Last) is
+    * called once for every chunk [First, Last). Chunks may be executed in any order and
+    * concurrently, so aBody must only write disjoint data.
+    *
+    * @param[in] aFirst First index of the range.
+    * @param[in] aLast One position after the last index of the range.
+    * @param[in] aGrain Chunk size. If 0, the range is split in about four chunks per thread.
+    * @param[in] aBody Function object called as aBody(SizeType, SizeType).
+    */
+   template <typename Function>
+   void                 ParallelFor(
+                           SizeType          aFirst,
+                           SizeType          aLast,
+                           SizeType          aGrain,
+                           Function          aBody);
+
+   /** Parallel reduction over an index range.
+    *
+    * The range [aFirst, aLast) is split in chunks of aGrain indices and aBody(First, Last) is
+    * called on each of them, returning the partial result of the chunk. The partial results are
+    * then combined, in chunk order, by the calling thread as aCombine(Acc, Partial), starting
+    * from rIdentity. With an explicit grain the result does not depend on the thread count.
+    *
+    * @param[in] aFirst First index of the range.
+    * @param[in] aLast One position after the last index of the range.
+    * @param[in] aGrain Chunk size. If 0, the range is split in about four chunks per thread.
+    * @param[in] rIdentity Initial value of the reduction.
+    * @param[in] aBody Function object called as ResultType aBody(SizeType, SizeType).
+    * @param[in] aCombine Function object called as ResultType aCombine(ResultType, ResultType).
+    * @return The combined result.
+    */
+   template <typename ResultType, typename Function, typename Combiner>
+   ResultType           ParallelReduce(
+                           SizeType          aFirst,
+                           SizeType          aLast,
+                           SizeType          aGrain,
+                           const ResultType& rIdentity,
+                           Function          aBody,
+                           Combiner          aCombine);
+
+// ACCESS
+
+   /** Read access to the number of threads, including the calling one.
+    *
+    * @return The number of threads.
+    */
+   NaturalType          GetThreadCount() const     { return mThreadCount; }
+
+   /** Read access to the CPU identifiers used for thread affinity.
+    *
+    * @return A const reference to the container of CPU identifiers (empty if unbound).
+    */
+   const CpuVector&     GetCpus() const            { return mCpus; }
+
+   /** Process-wide executor, with one thread per hardware thread, created on first use.
+    *
+    * Used by default by the components which would otherwise create an executor of their own
+    * for each instance (e.g. the MinSod representatives), so that they share a single set of
+    * threads.
+    *
+    * @return A shared pointer to the shared executor.
+    */
+   static const boost::shared_ptr<Executor>&
+                        Shared()
+                           {
+                              static const boost::shared_ptr<Executor> Instance( new Executor );
+
+                              return Instance;
+                           }
+
+private:
+
+   // Typedef privati.
+   typedef boost::function<void ()>
+                        Task;
+
+   // Coda di task di un thread.
+   struct TaskQueue
+   {
+      boost::mutex      Mutex;
+      std::deque<Task>  Tasks;
+   };
+
+   // Gruppo di task generati da una singola chiamata.
+   struct TaskGroup
+   {
+      explicit TaskGroup(SizeType aPending) : Pending(aPending) { }
+
+      boost::mutex      Mutex;
+      boost::condition_variable
+                        Done;
+      SizeType          Pending;
+      std::exception_ptr
+                        Error;
+   };
+
+   // Esecuzione di un blocco di ParallelFor.
+   template <typename Function>
+   struct ChunkTask
+   {
+      Function*         pBody;
+      SizeType          First;
+      SizeType          Last;
+      TaskGroup*        pGroup;
+
+      void              operator()() const
+                           {
+                              try
+                              {
+                                 (*pBody)(First, Last);
+                              }
+                              catch (...)
+                              {
+                                 boost::mutex::scoped_lock Lock(pGroup->Mutex);
+                                 if (!pGroup->Error)
+                                 {
+                                    pGroup->Error= std::current_exception();
+                                 }
+                              }
+
+                              boost::mutex::scoped_lock Lock(pGroup->Mutex);
+                              if (0 == --pGroup->Pending)
+                              {
+                                 pGroup->Done.notify_all();
+                              }
+                           }
+   };
+
+   // Calcolo del risultato parziale di un blocco di ParallelReduce.
+   template <typename ResultType, typename Function>
+   struct ReduceChunk
+   {
+      Function*         pBody;
+      const std::vector<SizeType>*
+                        pBounds;
+      std::vector<ResultType>*
+                        pResults;
+
+      void              operator()(SizeType aFirst, SizeType aLast) const
+                           {
+                              for (SizeType c= aFirst; c < aLast; c++)
+                              {
+                                 (*pResults)[c]= (*pBody)( (*pBounds)[c], (*pBounds)[c + 1] );
+                              }
+                           }
+   };
+
+   // Numero di thread (incluso il chiamante).
+   NaturalType          mThreadCount;
+
+   // CPU per l'affinità dei thread.
+   CpuVector            mCpus;
+
+   // Thread di lavoro.
+   boost::thread_group  mWorkers;
+
+   // Code dei task: una per worker, più una condivisa dai thread esterni.
+   std::vector<TaskQueue*>
+                        mQueues;
+
+   // Indice della coda del thread corrente (non impostato per i thread esterni).
+   boost::thread_specific_ptr<SizeType>
+                        mSlot;
+
+   // Sincronizzazione dei worker inattivi.
+   boost::mutex         mWakeMutex;
+   boost::condition_variable
+                        mWake;
+
+   // Numero di task in coda (protetto da mWakeMutex).
+   SizeType             mQueued;
+
+   // Flag di terminazione.
+   bool                 mStop;
+
+   // Avvio dei worker.
+   void                 Start(NaturalType aThreads, const CpuVector& rCpus);
+
+   // Ciclo di un worker.
+   void                 WorkerLoop(SizeType aSlot);
+
+   // Indice della coda del thread corrente.
+   SizeType             LocalQueue() const
+                           {
+                              return mSlot.get() ? *mSlot : mQueues.size() - 1;
+                           }
+
+   // Accodamento di un task nella coda aQueue.
+   void                 Push(SizeType aQueue, const Task& rTask);
+
+   // Esecuzione di un task in coda, se presente (prima la coda locale, poi furto).
+   bool                 TryRunTask(SizeType aQueue);
+
+   // Attesa del completamento di un gruppo, eseguendo altri task nel frattempo.
+   void                 Wait(TaskGroup& rGroup, SizeType aQueue);
+
+   // Dimensione automatica dei blocchi.
+   SizeType             AutoGrain(SizeType aSize) const
+                           {
+                              SizeType Chunks= 4 * static_cast<SizeType>(mThreadCount);
+                              return (aSize + Chunks - 1) / Chunks;
+                           }
+
+}; // class Executor
+
+/** @brief Detection of the ExecutorSetup method.
+ *
+ * %HasExecutorSetup is a boolean trait whose value is true if the class T has a method
+ * void ExecutorSetup(const boost::shared_ptr<Executor>&), i.e. if its parallel sections can
+ * be run on a given executor.
+ */
+template <typename T>
+class HasExecutorSetup
+{
+   // Tipi di ritorno dei test.
+   typedef char         Yes;
+   typedef char         (&No)[2];
+
+   // Firma richiesta.
+   template <typename U, void (U::*)(const boost::shared_ptr<Executor>&)>
+   struct Signature { };
+
+   template <typename U>
+   static Yes           Test(Signature<U, &U::ExecutorSetup>*);
+
+   template <typename U>
+   static No            Test(...);
+
+public:
+
+   /** True if T has the ExecutorSetup method.
+    */
+   static const bool    value= sizeof(Test<T>(0)) == sizeof(Yes);
+
+}; // class HasExecutorSetup
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+////////////////////////////////////// PUBLIC //////////////////////////////////////////////
+
+//==================================== LIFECYCLE ===========================================
+
+inline
+Executor::~Executor()
+{
+   {
+      boost::mutex::scoped_lock Lock(mWakeMutex);
+      mStop= true;
+   }
+   mWake.notify_all();
+   mWorkers.join_all();
+
+   for (SizeType i= 0; i < mQueues.size(); i++)
+   {
+      delete mQueues[i];
+   }
+}  // ~Executor
+
+//==================================== OPERATIONS ==========================================
+
+template <typename Function>
+void
+Executor::ParallelFor(
+             SizeType          aFirst,
+             SizeType          aLast,
+             SizeType          aGrain,
+             Function          aBody)
+{
+   // Variabili.
+   SizeType             Size;
+   SizeType             Chunks;
+   SizeType             Queue;
+
+   if (aLast <= aFirst)
+   {
+      return;
+   }
+
+   Size= aLast - aFirst;
+   if (!aGrain)
+   {
+      aGrain= AutoGrain(Size);
+   }
+   Chunks= (Size + aGrain - 1) / aGrain;
+
+   // Esecuzione diretta se non c'è nulla da parallelizzare.
+   if ( (mThreadCount < 2) || (Chunks < 2) )
+   {
+      aBody(aFirst, aLast);
+      return;
+   }
+
+   TaskGroup            Group(Chunks);
+   ChunkTask<Function>  Chunk;
+
+   Chunk.pBody= &aBody;
+   Chunk.pGroup= &Group;
+   Queue= LocalQueue();
+
+   // Accodo tutti i blocchi tranne il primo, che eseguo subito.
+   for (SizeType c= 1; c < Chunks; c++)
+   {
+      Chunk.First= aFirst + c * aGrain;
+      Chunk.Last= (c + 1 == Chunks) ? aLast : Chunk.First + aGrain;
+      Push(Queue, Chunk);
+   }
+
+   Chunk.First= aFirst;
+   Chunk.Last= aFirst + aGrain;
+   Chunk();
+
+   Wait(Group, Queue);
+
+   if (Group.Error)
+   {
+      std::rethrow_exception(Group.Error);
+   }
+}  // ParallelFor
+
+template <typename ResultType, typename Function, typename Combiner>
+ResultType
+Executor::ParallelReduce(
+             SizeType          aFirst,
+             SizeType          aLast,
+             SizeType          aGrain,
+             const ResultType& rIdentity,
+             Function          aBody,
+             Combiner          aCombine)
+{
+   // Variabili.
+   std::vector<SizeType>      Bounds;
+   std::vector<ResultType>    Results;
+   ReduceChunk<ResultType, Function>
+                              Reduce;
+   ResultType                 Acc= rIdentity;
+
+   if (aLast <= aFirst)
+   {
+      return Acc;
+   }
+
+   if (!aGrain)
+   {
+      aGrain= AutoGrain(aLast - aFirst);
+   }
+
+   // Confini dei blocchi, indipendenti dal numero di thread.
+   for (SizeType i= aFirst; i < aLast; i+= aGrain)
+   {
+      Bounds.push_back(i);
+   }
+   Bounds.push_back(aLast);
+   Results.resize(Bounds.size() - 1, rIdentity);
+
+   Reduce.pBody= &aBody;
+   Reduce.pBounds= &Bounds;
+   Reduce.pResults= &Results;
+   ParallelFor(0, Results.size(), 1, Reduce);
+
+   for (SizeType c= 0; c < Results.size(); c++)
+   {
+      Acc= aCombine(Acc, Results[c]);
+   }
+
+   return Acc;
+}  // ParallelReduce
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+// Avvio dei worker.
+inline
+void
+Executor::Start(NaturalType aThreads, const CpuVector& rCpus)
+{
+   mThreadCount= aThreads ? aThreads : boost::thread::hardware_concurrency();
+   if (!mThreadCount)
+   {
+      mThreadCount= 1;
+   }
+
+   mCpus= rCpus;
+   mQueued= 0;
+   mStop= false;
+
+   // Una coda per worker, più quella dei thread esterni (l'ultima).
+   for (NaturalType i= 0; i < mThreadCount; i++)
+   {
+      mQueues.push_back(new TaskQueue);
+   }
+
+   for (NaturalType i= 0; i + 1 < mThreadCount; i++)
+   {
+      boost::thread* pThread= new boost::thread(
+                                    boost::bind(&Executor::WorkerLoop, this, SizeType(i)) );
+
+      #if defined(__linux__)
+      if ( !mCpus.empty() )
+      {
+         cpu_set_t CpuSet;
+         CPU_ZERO(&CpuSet);
+         CPU_SET(mCpus[i % mCpus.size()], &CpuSet);
+         pthread_setaffinity_np(pThread->native_handle(), sizeof(cpu_set_t), &CpuSet);
+      }
+      #endif
+
+      mWorkers.add_thread(pThread);
+   }
+}  // Start
+
+// Ciclo di un worker.
+inline
+void
+Executor::WorkerLoop(SizeType aSlot)
+{
+   mSlot.reset(new SizeType(aSlot));
+
+   while (true)
+   {
+      if ( TryRunTask(aSlot) )
+      {
+         continue;
+      }
+
+      boost::mutex::scoped_lock Lock(mWakeMutex);
+      while (!mStop && !mQueued)
+      {
+         mWake.wait(Lock);
+      }
+
+      if (mStop && !mQueued)
+      {
+         break;
+      }
+   }
+}  // WorkerLoop
+
+// Accodamento di un task.
+inline
+void
+Executor::Push(SizeType aQueue, const Task& rTask)
+{
+   {
+      boost::mutex::scoped_lock QueueLock(mQueues[aQueue]->Mutex);
+      mQueues[aQueue]->Tasks.push_back(rTask);
+
+      boost::mutex::scoped_lock WakeLock(mWakeMutex);
+      mQueued++;
+   }
+   mWake.notify_one();
+}  // Push
+
+// Esecuzione di un task in coda.
+inline
+bool
+Executor::TryRunTask(SizeType aQueue)
+{
+   // Variabili.
+   Task                 Job;
+   SizeType             N= mQueues.size();
+
+   for (SizeType k= 0; (k < N) && Job.empty(); k++)
+   {
+      SizeType          q= (aQueue + k) % N;
+      boost::mutex::scoped_lock QueueLock(mQueues[q]->Mutex);
+
+      if ( !mQueues[q]->Tasks.empty() )
+      {
+         // LIFO sulla propria coda, FIFO sulle altre.
+         if (!k)
+         {
+            Job.swap( mQueues[q]->Tasks.back() );
+            mQueues[q]->Tasks.pop_back();
+         }
+         else
+         {
+            Job.swap( mQueues[q]->Tasks.front() );
+            mQueues[q]->Tasks.pop_front();
+         }
+
+         boost::mutex::scoped_lock WakeLock(mWakeMutex);
+         mQueued--;
+      }
+   }
+
+   if ( Job.empty() )
+   {
+      return false;
+   }
+
+   Job();
+   return true;
+}  // TryRunTask
+
+// Attesa del completamento di un gruppo.
+inline
+void
+Executor::Wait(TaskGroup& rGroup, SizeType aQueue)
+{
+   while (true)
+   {
+      {
+         boost::mutex::scoped_lock Lock(rGroup.Mutex);
+         if (!rGroup.Pending)
+         {
+            return;
+         }
+      }
+
+      if ( TryRunTask(aQueue) )
+      {
+         continue;
+      }
+
+      // Nessun task in coda: i blocchi restanti sono in esecuzione altrove.
+      boost::mutex::scoped_lock Lock(rGroup.Mutex);
+      while (rGroup.Pending)
+      {
+         rGroup.Done.wait(Lock);
+      }
+      return;
+   }
+}  // Wait
+
+}  // namespace spare
+
+#endif  // _Executor_h_
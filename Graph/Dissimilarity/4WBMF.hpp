@@ -57,7 +57,9 @@ namespace spare {  // Inclusione in namespace spare.
  * Member function Diss() assumed the BoostGraphType graph has struct with "v_info_t" and "e_info_t" containing vertex
  * and edge properties.
  *
- * Added read-only access to edge/vertex dissimilarity. Usefull for custom normalization.
+ * The edge/vertex dissimilarity values of the best shuffle, useful for custom normalization, are returned by Diss(g1, g2, result):
+ * getVertexDissValue() and getEdgeDissValue() have been removed, since they kept per-call state in a const object
+ * (not safe when the object is shared among threads).
  */
 
 
@@ -86,10 +88,6 @@ public:
         mPEdgeInsDel=1;
         //default insertion and deletion costs
         mEdgeInsDelCost=1;
-        
-        //dissimilarity initialization
-        mVertexDissValue=0.0;
-        mEdgeDissValue=0.0;
 
         //normalization
         mNormalize=false;
@@ -99,7 +97,6 @@ public:
         isShuffle=false;
         mNShuffles=0;
         mSeed=time(NULL);
-        generator.seed(mSeed);
 
         //Fully 4-weights without sum of weights to 1
         paramsBounded=false;
@@ -126,6 +123,16 @@ public:
      */
     typedef boost::unordered_map<NaturalType, NaturalType> HashMapType;
 
+    /**
+     * Partial results of a dissimilarity evaluation: the total (not normalized) vertices
+     * and edges costs of the best shuffle. Useful for custom normalization.
+     */
+    struct DissResult
+    {
+        RealType VertexDiss;
+        RealType EdgeDiss;
+    };
+
 
     /**
      * Main graph dissimilarity method w/ optional shuffle.
@@ -135,7 +142,23 @@ public:
      * @return The dissimilarity value
      */
     template<class BoostGraphType >
-    RealType Diss(const BoostGraphType& g1, const BoostGraphType& g2) const;
+    RealType Diss(const BoostGraphType& g1, const BoostGraphType& g2) const
+    {
+        DissResult result;
+        return Diss(g1, g2, result);
+    }
+
+    /**
+     * Main graph dissimilarity method w/ optional shuffle, with the vertices and edges costs.
+     * The shuffles of each call are drawn from a generator seeded with the seed variable, so
+     * the same pair of graphs always gets the same value.
+     * @param[in] g1 The first graph
+     * @param[in] g2 The second graph
+     * @param[out] result The vertices and edges costs
+     * @return The dissimilarity value
+     */
+    template<class BoostGraphType >
+    RealType Diss(const BoostGraphType& g1, const BoostGraphType& g2, DissResult& result) const;
 
     //ACCESS
 
@@ -241,13 +264,6 @@ public:
      */
     const RealType& NormValue() const { return mNormValue; }
     
-    /**
-    * Strictly Read-Only access for dissimilarity result for external methods requests.
-    * Added by Luca Baldini
-    */
-    const RealType& getVertexDissValue() const {return mVertexDissValue;}
-    const RealType& getEdgeDissValue()  const {return mEdgeDissValue;}
-    
     /**
       * Enabler for getting a parameter from the remanings if weights sum one
       */
@@ -286,7 +302,6 @@ public:
     void setSeed(spare::RealType seed)
     {
         mSeed = seed;
-        generator.seed(mSeed);
     }
 
 
@@ -369,26 +384,17 @@ private:
      * Seed variable for RNG for repeatability. If not set, default constructor use time(null)
      */
     spare::NaturalType mSeed;
-    mutable std::mt19937 generator;
 
     /**
       * Enable variable if weights sum 1
       */
     bool paramsBounded;
 
-    /**
-    *  Vertex/Edge Dissimilarity values
-    *  In order to keep Diss() const, this variables are declared mutable letting Diss() to assign the evaluated cost
-    *  Added by Luca Baldini
-    */
-    mutable RealType mVertexDissValue;
-    mutable RealType mEdgeDissValue;
-
     /**
      * Plain GED Dissimiliarity function.
      */
     template<class BoostGraphType >
-    RealType _Diss(const BoostGraphType& g1, const BoostGraphType& g2) const;
+    RealType _Diss(const BoostGraphType& g1, const BoostGraphType& g2, std::mt19937& generator, DissResult& result) const;
 
 
 
@@ -400,20 +406,25 @@ private:
 
 template <class VerticesDiss, class EdgesDiss>
 template <class BoostGraphType >
-RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const BoostGraphType& g2) const
+RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const BoostGraphType& g2, DissResult& result) const
 {
 
 
     RealType dissMinTot=std::numeric_limits<RealType>::max();
     NaturalType shuffleCount=0;
+    std::mt19937 generator(mSeed);
+    DissResult shuffleResult;
+    result.VertexDiss=0.;
+    result.EdgeDiss=0.;
 
     do{
 
         //do-while for performing at least one time the Diss()
-        RealType Diss = _Diss<BoostGraphType>(g1,g2);
+        RealType Diss = _Diss<BoostGraphType>(g1,g2,generator,shuffleResult);
 
         if(Diss<dissMinTot){
             dissMinTot=Diss;
+            result=shuffleResult;
         }
 
         //No shuffle for graphs with less than 2 nodes TODO: let it set by user?
@@ -430,7 +441,7 @@ RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const Boos
 
 template <class VerticesDiss, class EdgesDiss>
 template <class BoostGraphType >
-RealType BMF<VerticesDiss, EdgesDiss>::_Diss(const BoostGraphType& g1, const BoostGraphType& g2) const
+RealType BMF<VerticesDiss, EdgesDiss>::_Diss(const BoostGraphType& g1, const BoostGraphType& g2, std::mt19937& generator, DissResult& result) const
 {
     //some boost types
     typedef typename boost::graph_traits<BoostGraphType>::vertex_iterator BoostVertexIter;
@@ -529,7 +540,7 @@ RealType BMF<VerticesDiss, EdgesDiss>::_Diss(const BoostGraphType& g1, const Boo
     //combine and return the total vertices costs
 //    totVDiss=(mPVertexSubstitution*totVSubsCost)+(mPVertexInsertion*totVInsertionCost)+(mPVertexDeletion*totVDeletionCost);
     totVDiss=(mPVertexSubstitution*totVSubsCost)+(mPVertexInsDel*totVInsDelCost);
-    mVertexDissValue=totVDiss;
+    result.VertexDiss=totVDiss;
 
     /////////////////////////////
     //induced edit operations on edges
@@ -618,7 +629,7 @@ RealType BMF<VerticesDiss, EdgesDiss>::_Diss(const BoostGraphType& g1, const Boo
 
     //combine and return the total edges costs
     totEDiss=(PEdgeSubstitution*totESubsCost)+(mPEdgeInsDel*totEInsDelCost);
-    mEdgeDissValue=totEDiss;
+    result.EdgeDiss=totEDiss;
     
     //Total value
     totDiss=totVDiss+totEDiss;
@@ -48,7 +48,9 @@ namespace spare {  // Inclusione in namespace spare.
  * The matching adopts six weighting parameters: three for the vertex and three for the edge operations.
  * The computational complexity is given by O(2*n^2), where n is the lower order of the input graphs.
  * 
- * Added read-only access to edge/vertex dissimilarity. Usefull for custom normalization.
+ * The edge/vertex dissimilarity values, useful for custom normalization, are returned by Diss(g1, g2, result):
+ * getVertexDissValue() and getEdgeDissValue() have been removed, since they kept per-call state in a const object
+ * (not safe when the object is shared among threads).
  */
 template <class VerticesDiss, class EdgesDiss>
 class BMF {
@@ -76,10 +78,6 @@ public:
         //default insertion and deletion costs
         mEdgeInsertionCost=1;
         mEdgeDeletionCost=1;
-        
-        //dissimilarity initialization
-        mVertexDissValue=0.0;
-        mEdgeDissValue=0.0;
 
         //normalization
         mNormalize=false;
@@ -106,6 +104,16 @@ public:
      */
     typedef boost::unordered_map<NaturalType, NaturalType> HashMapType;
 
+    /**
+     * Partial results of a dissimilarity evaluation: the total (not normalized) vertices
+     * and edges costs. Useful for custom normalization.
+     */
+    struct DissResult
+    {
+        RealType VertexDiss;
+        RealType EdgeDiss;
+    };
+
 
     /**
      * Main graph dissimilarity method
@@ -114,7 +122,21 @@ public:
      * @return The dissimilarity value
      */
     template<class BoostGraphType >
-    RealType Diss(const BoostGraphType& g1, const BoostGraphType& g2) const;
+    RealType Diss(const BoostGraphType& g1, const BoostGraphType& g2) const
+    {
+        DissResult result;
+        return Diss(g1, g2, result);
+    }
+
+    /**
+     * Main graph dissimilarity method, with the vertices and edges costs
+     * @param[in] g1 The first graph
+     * @param[in] g2 The second graph
+     * @param[out] result The vertices and edges costs
+     * @return The dissimilarity value
+     */
+    template<class BoostGraphType >
+    RealType Diss(const BoostGraphType& g1, const BoostGraphType& g2, DissResult& result) const;
 
 	/**
      * PCN dissimilarity method
@@ -274,13 +296,6 @@ public:
      */
     const RealType& NormValue() const { return mNormValue; } 
     
-    /**
-    * Strictly Read-Only access for dissimilarity result for external methods requests.
-    * Added by Luca Baldini
-    */
-    const RealType& getVertexDissValue() const {return mVertexDissValue;}
-    const RealType& getEdgeDissValue()  const {return mEdgeDissValue;}
-    
     //******
 
 private:
@@ -355,14 +370,6 @@ private:
      */
     RealType mNormValue;
     
-    /**
-    *  Vertex/Edge Dissimilarity values
-    *  In order to keep Diss() const, this variables are declared mutable letting Diss() to assign the evaluated cost
-    *  Added by Luca Baldini
-    */
-    mutable RealType mVertexDissValue;
-    mutable RealType mEdgeDissValue;
-    
 };
 
 
@@ -371,7 +378,7 @@ private:
 
 template <class VerticesDiss, class EdgesDiss>
 template <class BoostGraphType >
-RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const BoostGraphType& g2) const
+RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const BoostGraphType& g2, DissResult& result) const
 {
     //some boost types
     typedef typename boost::graph_traits<BoostGraphType>::vertex_iterator BoostVertexIter;
@@ -461,7 +468,7 @@ RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const Boos
 
     //combine and return the total vertices costs
     totVDiss=(mPVertexSubstitution*totVSubsCost)+(mPVertexInsertion*totVInsertionCost)+(mPVertexDeletion*totVDeletionCost);
-    mVertexDissValue=totVDiss;
+    result.VertexDiss=totVDiss;
 
     /////////////////////////////
     //induced edit operations on edges
@@ -536,7 +543,7 @@ RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const Boos
 
     //combine and return the total edges costs
     totEDiss=(mPEdgeSubstitution*totESubsCost)+(mPEdgeInsertion*totEInsertionCost)+(mPEdgeDeletion*totEDeletionCost);
-    mEdgeDissValue=totEDiss;
+    result.EdgeDiss=totEDiss;
     
     //Total value
     totDiss=totVDiss+totEDiss;
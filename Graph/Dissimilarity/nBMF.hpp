@@ -94,11 +94,12 @@ RealType nBMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const Boo
     //upper bound
     NaturalType o1=boost::num_vertices(g1), o2=boost::num_vertices(g2);
     
-    mBMFDiss.Diss(g1, g2);
+    typename BMF<VerticesDiss, EdgesDiss>::DissResult bmfResult;
+    mBMFDiss.Diss(g1, g2, bmfResult);
 
     RealType result= 0.0;
-    RealType  d1 = mBMFDiss.getVertexDissValue();
-    RealType d2 = mBMFDiss.getEdgeDissValue();
+    RealType  d1 = bmfResult.VertexDiss;
+    RealType d2 = bmfResult.EdgeDiss;
     NaturalType min=std::min(o1, o2);
     RealType u=(min*(min-1)/2);
 
@@ -61,7 +61,9 @@ ptrdiff_t sBMFRandom(ptrdiff_t i)
  * The computational complexity is given by O(k*2*n^2), where n is the lower order of the input graphs, and k is the user-defined number of shuffles ***(default 1)***.
  * 
  * Class is now sBMF -> BMF since it is only a BMF shuffled and a code need no change in typedef, just #include the proper file.(Luca Baldini)
- * Added read-only access to edge/vertex dissimilarity. Usefull for custom normalization.(Luca Baldini)
+ * The edge/vertex dissimilarity values of the best shuffle, useful for custom normalization, are returned by Diss(g1, g2, result):
+ * getVertexDissValue() and getEdgeDissValue() have been removed, since they kept per-call state in a const object
+ * (not safe when the object is shared among threads).
  */
 template <class VerticesDiss, class EdgesDiss>
 class BMF {
@@ -89,10 +91,6 @@ public:
         //default insertion and deletion costs
         mEdgeInsertionCost=1;
         mEdgeDeletionCost=1;
-        
-        //dissimilarity initialization
-        vertexDissValue=0.0;  
-        edgeDissValue=0.0;
 
         
         //normalization
@@ -125,6 +123,16 @@ public:
      */
     typedef boost::unordered_map<NaturalType, NaturalType> HashMapType;
 
+    /**
+     * Partial results of a dissimilarity evaluation: the total (not normalized) vertices
+     * and edges costs of the best shuffle. Useful for custom normalization.
+     */
+    struct DissResult
+    {
+        RealType VertexDiss;
+        RealType EdgeDiss;
+    };
+
 
     /**
      * Main graph dissimilarity method
@@ -133,7 +141,21 @@ public:
      * @return The dissimilarity value
      */
     template<class BoostGraphType >
-    RealType Diss(const BoostGraphType& g1, const BoostGraphType& g2) const;
+    RealType Diss(const BoostGraphType& g1, const BoostGraphType& g2) const
+    {
+        DissResult result;
+        return Diss(g1, g2, result);
+    }
+
+    /**
+     * Main graph dissimilarity method, with the vertices and edges costs
+     * @param[in] g1 The first graph
+     * @param[in] g2 The second graph
+     * @param[out] result The vertices and edges costs
+     * @return The dissimilarity value
+     */
+    template<class BoostGraphType >
+    RealType Diss(const BoostGraphType& g1, const BoostGraphType& g2, DissResult& result) const;
 
 
 //ACCESS
@@ -293,16 +315,7 @@ public:
      * Read-only access to the number of shuffles
      */
     const NaturalType& NShuffles() const { return mNShuffles; }
-    
-    //****ADDING ACCESS TO VERTEX DISSIMILARITY AND EDGE DISSIMILATIRY FOR CUSTOM NORMALIZATION*****// //Luca Baldini 
-    
-    // Strictly Read-Only ACCESS
-    
-    const RealType& getVertexDissValue()  const {return vertexDissValue;}
-    
-    const RealType& getEdgeDissValue()  const { return edgeDissValue;}
-    
-    //******
+
 
 private:
 
@@ -380,11 +393,6 @@ private:
      * User-define value used for normalization
      */
     RealType mNormValue;
-    
-    //**** Vertex/Edge Dissimilarity values
-    
-    mutable RealType vertexDissValue;
-    mutable RealType edgeDissValue;
 };
 
 
@@ -393,7 +401,7 @@ private:
 
 template <class VerticesDiss, class EdgesDiss>
 template <class BoostGraphType >
-RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const BoostGraphType& g2) const
+RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const BoostGraphType& g2, DissResult& result) const
 {
     //some boost types
     typedef typename boost::graph_traits<BoostGraphType>::vertex_iterator BoostVertexIter;
@@ -403,6 +411,8 @@ RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const Boos
 
     NaturalType orderG1=boost::num_vertices(g1), orderG2=boost::num_vertices(g2), sizeG1=boost::num_edges(g1), sizeG2=boost::num_edges(g2);
     RealType absOrderDiff, dissMinTot=std::numeric_limits<RealType>::max();
+    result.VertexDiss=0.;
+    result.EdgeDiss=0.;
 
     //vertices and iterators/descriptors for graphs
     BoostVertexIter itG1=boost::vertices(g1).first;
@@ -510,7 +520,6 @@ RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const Boos
 
 		//combine and return the total vertices costs
 		totVDiss=(mPVertexSubstitution*totVSubsCost)+(mPVertexInsertion*totVInsertionCost)+(mPVertexDeletion*totVDeletionCost);
-        vertexDissValue=totVDiss;
 
 		/////////////////////////////
 		//induced edit operations on edges
@@ -581,12 +590,14 @@ RealType BMF<VerticesDiss, EdgesDiss>::Diss(const BoostGraphType& g1, const Boos
 
 		//combine and return the total edges costs
 		totEDiss=(mPEdgeSubstitution*totESubsCost)+(mPEdgeInsertion*totEInsertionCost)+(mPEdgeDeletion*totEDeletionCost);
-        edgeDissValue= totEDiss;
-        
 		totDiss=totVDiss+totEDiss;
 
 		if(totDiss<dissMinTot)
+		{
 			dissMinTot=totDiss;
+			result.VertexDiss=totVDiss;
+			result.EdgeDiss=totEDiss;
+		}
     }
 
     //normalized or plain dissimilarity value?
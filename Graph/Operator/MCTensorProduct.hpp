@@ -17,7 +17,7 @@
 /** @brief File MCTensorProduct.hpp, that contains the tensor product class.
  *
  * Contains the declaration of the Multicore TensorProduct class.
- * It is a multi-threaded version of the standard tensor product computation, using a user-defined number of threads.
+ * It is a multi-threaded version of the standard tensor product computation, running on a (possibly shared) Executor.
  *
  * @file MCTensorProduct.hpp
  * @author Lorenzo Livi
@@ -28,14 +28,16 @@
 
 
 //STD INCLUDES
+#include <functional>
 #include <vector>
 
 //BOOST INCLUDES
+#include <boost/bind/bind.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
-#include <boost/thread/thread.hpp>
-#include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
 
 //SPARE INCLUDES
+#include <spare/Executor.hpp>
 #include <spare/SpareTypes.hpp>
 
 
@@ -46,9 +48,12 @@ namespace spare {  // Inclusione in namespace spare.
  *
  * This class implements the @a Operator concept of the graphs domain (i.e., an operator between graphs).
  * It contains two main types of interfaces: the first one uses object references, the second one uses pointers (mainly for multi-threading).
- * The number of threads is configurable by the user in the third template argument.
+ * The rows of the first graph matrix are processed in parallel on an Executor, which can be shared with other components
+ * through ExecutorSetup; if none is provided, a private executor with NThreads threads (the third template argument,
+ * 0 means the number of hardware threads) is created on first use.
+ * The partial weights are summed in row order, so the result does not depend on the number of threads.
  */
-template <class KernelType, class MatrixRepresentation, NaturalType NThreads>
+template <class KernelType, class MatrixRepresentation, NaturalType NThreads= 0>
 class MCTensorProduct {
 public:
 
@@ -98,26 +103,45 @@ public:
     /**
      * Read-only access to the number of threads
      */
-    const NaturalType& ThreadsAgent() const { return NThreads; }
+    NaturalType ThreadsAgent() const { return GetExecutor()->GetThreadCount(); }
+
+    /**
+     * Setup of the executor used for the parallel computation (it can be shared with other components)
+     *
+     * @param[in] pExecutor A shared pointer to the executor
+     */
+    void ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor) { mExecutor=pExecutor; }
+
+    /**
+     * Read-only access to the executor (a private one with NThreads threads is created if none has been set up)
+     */
+    const boost::shared_ptr<Executor>& GetExecutor() const
+    {
+        if(!mExecutor)
+            mExecutor.reset(new Executor(NThreads));
+
+        return mExecutor;
+    }
 
 private:
 
     /**
-     * Thread function for block-matrix weight computation
+     * Weight computation for a block of rows of the first matrix
      * @param[in] g1 A pointer to the first graph
      * @param[in] g2 A pointer to the second graph
      * @param[in] m1 A pointer to the first adjacency matrix
      * @param[in] m2 A pointer to the second adjacency matrix
-     * @param[in] pos
-     * @param[in] g2Order
-     * @param[out] weight
+     * @param[in] g2Order The order of the second graph
+     * @param[in] rStart The first row of the block
+     * @param[in] rEnd One position after the last row of the block
+     * @return The part of the weight of the tensor product graph due to the block
      */
     template <class GraphType>
-    void threadProduct(const GraphType* g1, const GraphType* g2,
+    RealType rowsProduct(const GraphType* g1, const GraphType* g2,
             const boost::numeric::ublas::matrix<RealType>* m1,
             const boost::numeric::ublas::matrix<RealType>* m2,
-            const NaturalType* pos, const NaturalType g2Order,
-            RealType* weight) const;
+            const NaturalType g2Order,
+            Executor::SizeType rStart, Executor::SizeType rEnd) const;
 
     /**
      * Main composite kernel function
@@ -129,8 +153,10 @@ private:
      */
     MatrixRepresentation mr;
 
-    //mutex
-    mutable boost::mutex boostMutex;
+    /**
+     * Executor for the parallel computation
+     */
+    mutable boost::shared_ptr<Executor> mExecutor;
 };
 
 
@@ -151,150 +177,41 @@ template <class GraphType>
 RealType MCTensorProduct<KernelType, MatrixRepresentation, NThreads>::product(const GraphType& g1,
         const GraphType& g2) const
 {
+    using boost::placeholders::_1;
+    using boost::placeholders::_2;
+
     NaturalType o1=boost::num_vertices(g1);
     NaturalType o2=boost::num_vertices(g2);
-    std::vector<NaturalType*> t;
-    NaturalType rStart, rEnd, cStart, cEnd, block, tot, totThreads;
-    //the weight of the tensor product graph
-    RealType weight=0.;
 
     //matrix representations of the two input graphs
     boost::numeric::ublas::matrix<RealType> m1(o1, o1), m2(o2, o2);
-    //threads
-    boost::thread_group threadGroup;
-
-    if(NThreads>o1)
-        totThreads=o1;
-    else
-        totThreads=NThreads;
 
     //matrix representations of the graphs
     mr.getMatrix(g1, m1);
     mr.getMatrix(g2, m2);
 
-    //compute tasks subdivision
-    tot=o1*o1;
-    block=tot/totThreads;
-    RealType v=(RealType)block/(RealType)o1;
-    NaturalType flooredRows=floor(v);
-    NaturalType ceiledRows=ceil(v);
-    //oldCEnd is equal to the next cStart
-    NaturalType oldCEnd=0, rowsShift=0;
-
-//    std::cout<<std::endl<<"Threads: "<<NThreads<<std::endl;
-//    std::cout<<"Tot: "<<tot<<std::endl;
-//    std::cout<<"BLock: "<<block<<std::endl;
-
-    //threads dispatching
-    for(NaturalType i=0;i<totThreads;i++)
-    {
-//        std::cout<<std::endl<<"T: "<<i<<std::endl;
-//        std::cout<<"FLOORED blocks/o1: "<<flooredRows<<std::endl;
-//        std::cout<<"CEILED  blocks/o1: "<<ceiledRows<<std::endl;
-//        std::cout<<"ROWS SHIFT: "<<rowsShift<<std::endl;
-//        std::cout<<"Old cEnd: "<<oldCEnd<<std::endl;
-
-        //TODO: il bug sembra essere risolto, ma e' sempre meglio fare ulteriori verifiche...
-
-        rStart=i*flooredRows+rowsShift;
-        rEnd=rStart+ceiledRows;
-
-        cStart=oldCEnd;
-        cEnd=block-(((rEnd-rStart)-1)*o1)+oldCEnd;
-
-        //bounds check
-        if(rEnd>o1)
-            rEnd=o1;
-
-        if(cEnd>o1)
-            cEnd=o1;
-
-        //next column start
-        if(cEnd>=o1)
-            oldCEnd=0;
-        else
-            oldCEnd=cEnd;
-
-        //the next start row is incremented by 1
-        if(cStart!=0&&cEnd==o1)
-            rowsShift++;
-
-        if(i==totThreads-1)
-        {
-            rEnd=o1;
-            cEnd=o1;
-        }
-
-//        std::cout<<"Row Start: "<<rStart<<std::endl;
-//        std::cout<<"Row End (excluded): "<<rEnd<<std::endl;
-//        std::cout<<"Col Start: "<<cStart<<std::endl;
-//        std::cout<<"Col End (excluded): "<<cEnd<<std::endl;
-//        std::cout<<"Old cEnd (next cStart): "<<oldCEnd<<std::endl<<std::endl;
-
-        //dynamic positions buffer
-        NaturalType* pos=new NaturalType[5];
-        pos[0]=rStart;
-        pos[1]=rEnd;
-        pos[2]=cStart;
-        pos[3]=cEnd;
-        pos[4]=o1;
-        t.push_back(pos);
-
-        //new thread
-        threadGroup.add_thread(new boost::thread(
-                boost::bind(&MCTensorProduct::threadProduct<GraphType>,
-                            this, &g1, &g2, &m1, &m2, pos, o2, &weight)));
-    }
-
-    threadGroup.join_all();
-
-    //free dynamic positions buffer
-    for(NaturalType i=0;i<totThreads;i++)
-        delete t[i];
-
-    return weight;
+    //one row of m1 per chunk: the partial weights are summed in row order
+    return GetExecutor()->ParallelReduce(0, o1, 1, RealType(0.),
+            boost::bind(&MCTensorProduct::rowsProduct<GraphType>, this, &g1, &g2, &m1, &m2, o2, _1, _2),
+            std::plus<RealType>());
 }
 
 template <class KernelType, class MatrixRepresentation, NaturalType NThreads>
 template <class GraphType>
-void MCTensorProduct<KernelType, MatrixRepresentation, NThreads>::threadProduct(
+RealType MCTensorProduct<KernelType, MatrixRepresentation, NThreads>::rowsProduct(
         const GraphType* g1, const GraphType* g2,
         const boost::numeric::ublas::matrix<RealType>* m1, const boost::numeric::ublas::matrix<RealType>* m2,
-        const NaturalType* pos, const NaturalType g2Order,
-        RealType* weight) const
+        const NaturalType g2Order,
+        Executor::SizeType rStart, Executor::SizeType rEnd) const
 {
-    //part of the weight computed by this thread
+    //part of the weight computed for this block
     RealType localWeight=0.;
+    NaturalType o1=(*m1).size2();
 
-    bool isFirst=true;
-    NaturalType startColM1, endColM1=0;
-
-    //fetch the assigne block of positions
-    for(NaturalType rM1=pos[0]; rM1<pos[1]; rM1++)
+    for(NaturalType rM1=rStart; rM1<rEnd; rM1++)
     {
-//        std::cout<<"RM1: "<<rM1<<std::endl;
-
-        //g1 columns determination based on the current row rM1
-        if(isFirst)
+        for(NaturalType cM1=0; cM1<o1; cM1++)
         {
-            isFirst=false;
-            startColM1=pos[2];
-        }
-        else
-            startColM1=0;
-
-        if(rM1==pos[1]-1)
-            endColM1=pos[3];
-        else
-            endColM1=pos[4];
-
-//        std::cout<<"START COL: "<<startColM1<<std::endl;
-//        std::cout<<"END COL: "<<endColM1<<std::endl;
-
-        for(NaturalType cM1=startColM1; cM1<endColM1; cM1++)
-        {
-//            std::cout<<"CM1: "<<cM1<<std::endl;
-
             if((*m1)(rM1, cM1))
             {
                 //data of g2
@@ -319,10 +236,7 @@ void MCTensorProduct<KernelType, MatrixRepresentation, NThreads>::threadProduct(
         }
     }
 
-    //synchronized access to the weight
-    boostMutex.lock();
-    *weight+=localWeight;
-    boostMutex.unlock();
+    return localWeight;
 }
 
 }
@@ -31,19 +31,22 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 // BOOST INCLUDES
+#include <boost/bind/bind.hpp>
 #include <boost/numeric/conversion/converter.hpp>
 #include <boost/random.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/utility.hpp>
-#include <boost/thread/thread.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/thread/mutex.hpp>
 
 // SPARE INCLUDES
 #include <spare/BoundedParameter.hpp>
+#include <spare/Executor.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
 #include <spare/SwitchParameter.hpp>
@@ -60,7 +63,10 @@ static const NaturalType GENETIC_SDF= 100;
 /** @brief %PGenetic algorithm.
  *
  * The PGenetic class models the @a Optimizer concept. It is a parallel genetic algorithm with optional
- * registry function. The number of threads are selected by the user at compile-time through the suited template parameter.
+ * registry function. The fitness values of each new population are evaluated in parallel on an Executor, which can be
+ * shared with other components (e.g. a clustering algorithm used inside the fitness function) through the
+ * ExecutorSetup method; if none is provided, a private executor with NThreads threads (0 means the number of hardware
+ * threads) is created on first use.
  * The registry is a container holding every generated solution code along
  * with its fitness value. The solution code manipulation functions such as Breed, Crossover,
  * Mutation and Fitness evaluation are demanded from an environment agent of the type
@@ -129,7 +135,7 @@ static const NaturalType GENETIC_SDF= 100;
  *  </tr>
  *  </table>
  */
-template <typename Environment, int NThreads>
+template <typename Environment, int NThreads= 0>
 class PGenetic
 {
 public:
@@ -400,6 +406,35 @@ public:
                               mRealDist.base().seed(aSeed);
                            }
 
+   /** Setup of the executor used for the parallel fitness evaluation.
+    *
+    * The same executor can be shared among several components, bounding the overall number
+    * of threads.
+    *
+    * @param[in] pExecutor Shared pointer to the executor.
+    */
+   void                 ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor)
+                           {
+                              mExecutor= pExecutor;
+                           }
+
+   /** Read access to the executor used for the parallel fitness evaluation.
+    *
+    * If no executor has been set up, a private one with NThreads threads is created.
+    *
+    * @return A shared pointer to the executor.
+    */
+   const boost::shared_ptr<Executor>&
+                        GetExecutor() const
+                           {
+                              if (!mExecutor)
+                              {
+                                 mExecutor.reset( new Executor(NThreads) );
+                              }
+
+                              return mExecutor;
+                           }
+
 private:
 
    // Typedef privati.
@@ -456,12 +491,13 @@ private:
    // Numero di evoluzioni in cui la fitness non cambia dopo il quale fermare l'algoritmo.
    NaturalType			mStallEvolutions;
 
-   //mutex for individuals iterator
-   mutable boost::mutex itMutex;
-
    //mutex for registry
    mutable boost::mutex regMutex;
 
+   // Executor per la valutazione parallela della fitness.
+   mutable boost::shared_ptr<Executor>
+                        mExecutor;
+
    // BOOST RANDOM
    // Distribuzione [0, 1).
    mutable boost::uniform_01<boost::mt19937, RealType>
@@ -479,8 +515,14 @@ private:
    // Calcolo fitness.
    RealType GetFitness(const CodeType& rCode);
 
-   // wrapper fitness function for threads
-   void GetFitness(Population* population, Population* np, PopulationIterator* it);
+   // Valutazione parallela della fitness di tutti gli individui di una popolazione.
+   void                 EvaluatePopulation(Population& rPop);
+
+   // Valutazione della fitness degli individui [aFirst, aLast).
+   void                 EvaluateRange(
+                           std::vector<Individual>*   pIndividuals,
+                           Executor::SizeType         aFirst,
+                           Executor::SizeType         aLast);
 
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
@@ -514,8 +556,6 @@ PGenetic<Environment, NThreads>::Initialize()
    PopulationSizeType      PopSize_;
    Individual              IndBuff;
    NaturalType             TrialCounter;
-   //threads
-   boost::thread_group threadGroup;
 
    PopSize_= boost::numeric::converter<PopulationSizeType, NaturalType>::convert(mPopSize);
 
@@ -540,17 +580,7 @@ PGenetic<Environment, NThreads>::Initialize()
    }
 
    //multi-threaded evaluation of new population fitness...
-   Population np;
-   PopulationIterator it=mPopBuffA.begin();
-
-   for(NaturalType i=0;i<NThreads;i++)
-       threadGroup.add_thread(new boost::thread(
-               boost::bind(&PGenetic::GetFitness, this, &mPopBuffA, &np, &it)));
-
-   threadGroup.join_all();
-
-   mPopBuffA.clear();
-   mPopBuffA.insert(np.begin(), np.end());
+   EvaluatePopulation(mPopBuffA);
 }
 
 template <typename Environment, int NThreads>
@@ -563,8 +593,6 @@ PGenetic<Environment, NThreads>::Initialize(
    PopulationSizeType      PopSize_;
    Individual              IndBuff;
    NaturalType             TrialCounter;
-   //threads
-   boost::thread_group threadGroup;
 
    PopSize_= boost::numeric::converter<PopulationSizeType, NaturalType>::convert(mPopSize);
 
@@ -602,17 +630,7 @@ PGenetic<Environment, NThreads>::Initialize(
    }
 
    //multi-threaded evaluation of new population fitness...
-   Population np;
-   PopulationIterator it=mPopBuffA.begin();
-
-   for(NaturalType i=0;i<NThreads;i++)
-       threadGroup.add_thread(new boost::thread(
-               boost::bind(&PGenetic::GetFitness, this, &mPopBuffA, &np, &it)));
-
-   threadGroup.join_all();
-
-   mPopBuffA.clear();
-   mPopBuffA.insert(np.begin(), np.end());
+   EvaluatePopulation(mPopBuffA);
 }
 
 //==================================== ACCESS ==============================================
@@ -713,8 +731,6 @@ PGenetic<Environment, NThreads>::NextGeneration(
    Individual                IndBuffA;
    Individual                IndBuffB;
    NaturalType               TrialCounter;
-   //threads
-   boost::thread_group threadGroup;
 
    if ( OldPop.empty() )
    {
@@ -790,17 +806,7 @@ PGenetic<Environment, NThreads>::NextGeneration(
    OldPop.clear();
 
    //multi-threaded evaluation of new population fitness...
-   Population np;
-   PopulationIterator it=NewPop.begin();
-
-   for(NaturalType i=0;i<NThreads;i++)
-       threadGroup.add_thread(new boost::thread(
-               boost::bind(&PGenetic::GetFitness, this, &NewPop, &np, &it)));
-
-   threadGroup.join_all();
-
-   NewPop.clear();
-   NewPop.insert(np.begin(), np.end());
+   EvaluatePopulation(NewPop);
 
    // Riduzione popolazione a valore fisso (Problema con il multithread. Infatti si calcolano le fitness anche di individui che poi potrei eliminare. Il problema sta nel fatto che non possiamo eliminare a priori gli individui solo sulla base del numero, perche' non conosciamo la loro fitness)
    while (NewPop.size() > PopSize_)
@@ -811,41 +817,32 @@ PGenetic<Environment, NThreads>::NextGeneration(
 
 template <typename Environment, int NThreads>
 void
-PGenetic<Environment, NThreads>::GetFitness(Population* population, Population* np,
-        PopulationIterator* it)
+PGenetic<Environment, NThreads>::EvaluatePopulation(Population& rPop)
 {
-    //local variables
-    Individual ind;
-    PopulationIterator lIt;
-
-    do
-    {
-        itMutex.lock();
-
-        //stop condition
-        if((*it) == (*population).end())
-        {
-            itMutex.unlock();
-            break;
-        }
-
-        lIt=*it;
-        ind=*lIt;
-        (*it)++;
+   using boost::placeholders::_1;
+   using boost::placeholders::_2;
 
-        itMutex.unlock();
+   // Copia degli individui, valutati in slot indipendenti.
+   std::vector<Individual> Individuals(rPop.begin(), rPop.end());
 
-        //parallel evaluation of the fitness
-        ind.first=GetFitness(ind.second);
+   GetExecutor()->ParallelFor(0, Individuals.size(), 1,
+                              boost::bind(&PGenetic::EvaluateRange, this, &Individuals, _1, _2) );
 
-        itMutex.lock();
-
-        //insert of the individual
-        (*np).insert(ind);
-
-        itMutex.unlock();
+   rPop.clear();
+   rPop.insert(Individuals.begin(), Individuals.end());
+}
 
-    }while(true);
+template <typename Environment, int NThreads>
+void
+PGenetic<Environment, NThreads>::EvaluateRange(
+                                 std::vector<Individual>*   pIndividuals,
+                                 Executor::SizeType         aFirst,
+                                 Executor::SizeType         aLast)
+{
+   for (Executor::SizeType i= aFirst; i < aLast; i++)
+   {
+      (*pIndividuals)[i].first= GetFitness( (*pIndividuals)[i].second );
+   }
 }
 
 template <typename Environment, int NThreads>
@@ -25,9 +25,18 @@
 #ifndef DISSIMILARITYREPR_HPP
 #define DISSIMILARITYREPR_HPP
 
+//BOOST INCLUDES
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
 //SPARE INCLUDES
+#include <spare/Executor.hpp>
 #include <spare/SpareTypes.hpp>
 
+#ifdef SPARE_USE_EIGEN
+#include <spare/Dissimilarity/PairwiseDistances.hpp>
+#endif
+
 
 namespace spare {  // Inclusione in namespace spare.
 
@@ -37,6 +46,9 @@ namespace spare {  // Inclusione in namespace spare.
  * This class implements a @a Representation concept.
  * Given a dissimilarity measure, an input set, and a reference (representation) set of n and r samples, respectively, an n x r dissimilarity matrix D is computed.
  * The allocated matrix must be a boost-compliant (real-valued) matrix.
+ * When the SPARE_USE_EIGEN macro is defined (the Eigen 3 library is then required), the dissimilarity is an unweighted Euclidean
+ * and both sets contain std::vector<RealType> samples, the matrix is computed at once by PairwiseDistances (blocked matrix products, multithreaded), equal to the pairwise computation up to a relative
+ * error of 1e-8 on the squared distances.
  */
 template <class DissimilarityType>
 class DissimilarityRepr {
@@ -86,12 +98,39 @@ public:
      */
     const DissimilarityType& DissAgent() const { return mDiss; }
 
+#ifdef SPARE_USE_EIGEN
+    /**
+     * Setup of the executor used by getMatrix for dense real vectors (see PairwiseDistances)
+     * @param[in] pExecutor Shared pointer to the executor
+     */
+    void ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor) { mPairwise.ExecutorSetup(pExecutor); }
+#endif
+
 private:
 
     /**
      * Dissimilarity measure
      */
     DissimilarityType mDiss;
+
+#ifdef SPARE_USE_EIGEN
+    /**
+     * Many-to-many distances for dense real vectors
+     */
+    PairwiseDistances mPairwise;
+#endif
+
+    //pairwise computation of the dissimilarity matrix
+    template <typename SamplesContainer1, typename SamplesContainer2, typename BoostMatrixType>
+    void computeMatrix(const SamplesContainer1& inputSet, const SamplesContainer2& representationSet,
+            BoostMatrixType& m, boost::false_type) const;
+
+#ifdef SPARE_USE_EIGEN
+    //computation of the dissimilarity matrix with PairwiseDistances
+    template <typename SamplesContainer1, typename SamplesContainer2, typename BoostMatrixType>
+    void computeMatrix(const SamplesContainer1& inputSet, const SamplesContainer2& representationSet,
+            BoostMatrixType& m, boost::true_type) const;
+#endif
 };
 
 //IMPL
@@ -100,6 +139,23 @@ template <class DissimilarityType>
 template <typename SamplesContainer1, typename SamplesContainer2, typename BoostMatrixType>
 void DissimilarityRepr<DissimilarityType>::getMatrix(const SamplesContainer1& inputSet, const SamplesContainer2& representationSet,
         BoostMatrixType& m) const
+{
+    //dense real vectors under the euclidean distance
+#ifdef SPARE_USE_EIGEN
+    typedef boost::integral_constant<bool,
+            HasPairwiseDistances<DissimilarityType, typename SamplesContainer1::value_type>::value &&
+            HasPairwiseDistances<DissimilarityType, typename SamplesContainer2::value_type>::value> denseTag;
+#else
+    typedef boost::false_type denseTag;
+#endif
+
+    computeMatrix(inputSet, representationSet, m, denseTag());
+}
+
+template <class DissimilarityType>
+template <typename SamplesContainer1, typename SamplesContainer2, typename BoostMatrixType>
+void DissimilarityRepr<DissimilarityType>::computeMatrix(const SamplesContainer1& inputSet, const SamplesContainer2& representationSet,
+        BoostMatrixType& m, boost::false_type) const
 {
     //iterator types
     typedef typename SamplesContainer1::const_iterator samplesItType1;
@@ -132,6 +188,29 @@ void DissimilarityRepr<DissimilarityType>::getMatrix(const SamplesContainer1& in
     }
 }
 
+#ifdef SPARE_USE_EIGEN
+template <class DissimilarityType>
+template <typename SamplesContainer1, typename SamplesContainer2, typename BoostMatrixType>
+void DissimilarityRepr<DissimilarityType>::computeMatrix(const SamplesContainer1& inputSet, const SamplesContainer2& representationSet,
+        BoostMatrixType& m, boost::true_type) const
+{
+    //the weighted distance is computed pair by pair
+    if(mDiss.IsWeighted())
+    {
+        computeMatrix(inputSet, representationSet, m, boost::false_type());
+        return;
+    }
+
+    //var
+    PairwiseDistances::Matrix inputMatrix, reprMatrix;
+
+    PairwiseDistances::Pack(inputSet.begin(), inputSet.end(), inputMatrix);
+    PairwiseDistances::Pack(representationSet.begin(), representationSet.end(), reprMatrix);
+
+    mPairwise.Diss(inputMatrix, reprMatrix, m);
+}
+#endif
+
 template <class DissimilarityType>
 template <typename SamplesContainer1, typename SamplesContainer2, typename DissVectorContainerType>
 void DissimilarityRepr<DissimilarityType>::getVectors(const SamplesContainer1& inputSet, const SamplesContainer2& representationSet,
@@ -33,6 +33,7 @@
 #include <cmath>
 
 //SPARE INCLUDES
+#include <spare/Dissimilarity/BoundedDiss.hpp>
 #include <spare/SpareTypes.hpp>
 #include <spare/SpareExceptions.hpp>
 
@@ -254,8 +255,13 @@ void SymbolicHistograms<Dissimilarity>::getMatrix(const SamplesContainer1& input
             spare::RealType threshold=sym.getDissMetric();
             sample symSubgraph = sym.getSubstructure();
 
-            distance = mDiss.Diss(subgraph, symSubgraph);
-
+            //only the hard threshold needs no distance above the threshold
+            if(Hard){
+                distance = BoundedDiss(mDiss, subgraph, symSubgraph, threshold);
+            }
+            else{
+                distance = mDiss.Diss(subgraph, symSubgraph);
+            }
 
             if(Hard){
                 //hard threshold
@@ -358,7 +364,7 @@ void SymbolicHistograms<Dissimilarity>::getVectors(const SamplesContainer1& inpu
             spare::RealType threshold=sym.getDissMetric();
             sample symSubgraph = sym.getSubstructure();
 
-            distance = mDiss.Diss(subgraph, symSubgraph);
+            distance = BoundedDiss(mDiss, subgraph, symSubgraph, threshold);
 
 
             if(distance <= threshold){
@@ -424,7 +430,7 @@ void SymbolicHistograms<Dissimilarity>::getVector(const SampleType& inputPattern
             sample symSubgraph = sym.getSubstructure();
             spare::RealType threshold=sym.getDissMetric();
 
-            distance = mDiss.Diss(subgraph, symSubgraph);
+            distance = BoundedDiss(mDiss, subgraph, symSubgraph, threshold);
 
             if(Hard){
                 //hard threshold
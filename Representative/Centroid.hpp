@@ -26,6 +26,7 @@
 #define _Centroid_h_
 
 // STD INCLUDES
+#include <cmath>
 #include <iterator>
 #include <utility>
 #include <vector>
@@ -36,8 +37,11 @@
 #include <boost/serialization/vector.hpp>
 
 // SPARE INCLUDES
+#include <spare/Dissimilarity/Euclidean.hpp>
+#include <spare/Dissimilarity/Minkowski.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
+#include <spare/VectorKernels.hpp>
 
 namespace spare {  // Inclusione in namespace spare.
 
@@ -47,10 +51,18 @@ namespace spare {  // Inclusione in namespace spare.
  * It's a cluster model based on centroid, that is the mean of the vector in the cluster.
  * The centroid thus is vector of real numbers.
  * The dissimilarity measure used for centroid-centroid and centroid-sample comparison is a template argument.
+ * The components are stored as StorageType, which defaults to RealType: with float storage
+ * the memory footprint of the centroid is halved, while all the computations are still carried
+ * out in RealType.
+ * Samples stored as std::vector<RealType> take a fast path working on contiguous memory: the
+ * update uses the SIMD kernels of VectorKernels, and so does the dissimilarity computation when
+ * Dissimilarity is an unweighted Euclidean, or an unweighted Minkowski of order 2. The same holds
+ * for the comparison between two centroids.
+ * When Dissimilarity is Euclidean the SquaredDiss methods return the squared dissimilarity
+ * between the sample and the centroid (see HasSquaredDiss).
  * @todo BatchUpdate Implementation.
- * @todo Merge Implementation.
  */
-template <typename Dissimilarity>
+template <typename Dissimilarity, typename StorageType = RealType>
 class Centroid
 {
 public:
@@ -59,9 +71,14 @@ public:
 
    /** Real centroid.
     */
-   typedef std::vector<RealType>
+   typedef std::vector<StorageType>
                         CentroidVector;
 
+   /** Dense real sample.
+    */
+   typedef std::vector<RealType>
+                        DenseVector;
+
 // LIFECYCLE
 
    /** Default constructor.
@@ -86,6 +103,55 @@ public:
    template <typename SequenceContainer>
    void                 Update(const SequenceContainer& rSample);
 
+   /** Centroid update routine, contiguous fast path.
+    *
+    * @param[in] rSample Reference to the vector that store the sample.
+    */
+   void                 Update(const DenseVector& rSample);
+
+   /** Centroid downdate routine, removing a sample previously used to update the centroid.
+    *
+    * @param[in] aSample Pair of iterators that delimit the sample.
+    */
+   template <typename ForwardIterator>
+   void                 Remove(std::pair<ForwardIterator, ForwardIterator> aSample);
+
+   /** Centroid downdate routine, removing a sample previously used to update the centroid.
+    *
+    * @param[in] rSample Reference to the container that store the sample.
+    */
+   template <typename SequenceContainer>
+   void                 Remove(const SequenceContainer& rSample);
+
+   /** Centroid downdate routine, contiguous fast path.
+    *
+    * @param[in] rSample Reference to the vector that store the sample.
+    */
+   void                 Remove(const DenseVector& rSample);
+
+   /** Move of a sample from this centroid to another one.
+    *
+    * @param[in] rSample The sample, previously used to update this centroid.
+    * @param[in,out] rTarget Reference to the centroid receiving the sample.
+    */
+   template <typename SampleType>
+   void                 Move(
+                           const SampleType& rSample,
+                           Centroid&         rTarget)
+                                                   {
+                                                      Remove(rSample);
+                                                      rTarget.Update(rSample);
+                                                   }
+
+   /** Merge of another centroid.
+    *
+    * The result is the mean of the samples of both centroids, i.e. the mean of the two
+    * centroids weighted by their sample counts.
+    *
+    * @param[in] rOther Reference to the centroid to be merged.
+    */
+   void                 Merge(const Centroid& rOther);
+
    /** Calculates the dissimilarity between the sample and the centroid.
     *
     * @param[in] aSample Pair of iterators that delimit the sample.
@@ -126,6 +192,22 @@ public:
                                                  rSample);
                            }
 
+   /** Calculates the dissimilarity between the sample and the centroid, contiguous fast path.
+    *
+    * @param[in] rSample Reference to the vector that store the sample.
+    * @return The calculated dissimilarity value.
+    */
+   RealType             Diss(const DenseVector& rSample) const
+                           {
+                              if (!mCount)
+                              {
+                                 throw SpareLogicError("Centroid, 10, Uninitialized "
+                                                       "object.");
+                              }
+
+                              return DenseDiss(mDissAgent, rSample);
+                           }
+
    /** Calculates the dissimilarity between two centroid.
     *
     * @param[in] rOther Reference to another centroid.
@@ -139,9 +221,67 @@ public:
                                                        "object.");
                               }
 
-                              return mDissAgent.Diss(
+                              return DenseDiss(mDissAgent, rOther.mCentroid);
+                           }
+
+   /** Calculates the squared dissimilarity between the sample and the centroid.
+    *
+    * Available when the dissimilarity measure provides SquaredDiss.
+    *
+    * @param[in] aSample Pair of iterators that delimit the sample.
+    * @return The calculated squared dissimilarity value.
+    */
+   template <typename ForwardIterator>
+   RealType             SquaredDiss(std::pair<ForwardIterator, ForwardIterator> aSample) const
+                           {
+                              if (!mCount)
+                              {
+                                 throw SpareLogicError("Centroid, 15, Uninitialized "
+                                                       "object.");
+                              }
+                              return mDissAgent.SquaredDiss(
+                                                 std::make_pair(
+                                                    mCentroid.begin(),
+                                                    mCentroid.end() ),
+                                                 aSample);
+                           }
+
+   /** Calculates the squared dissimilarity between the sample and the centroid.
+    *
+    * Available when the dissimilarity measure provides SquaredDiss.
+    *
+    * @param[in] rSample Reference to the container that store the sample.
+    * @return The calculated squared dissimilarity value.
+    */
+   template <typename SequenceContainer>
+   RealType             SquaredDiss(const SequenceContainer& rSample) const
+                           {
+                              if (!mCount)
+                              {
+                                 throw SpareLogicError("Centroid, 16, Uninitialized "
+                                                       "object.");
+                              }
+                              return mDissAgent.SquaredDiss(
                                                  mCentroid,
-                                                 rOther.mCentroid);
+                                                 rSample);
+                           }
+
+   /** Calculates the squared dissimilarity between the sample and the centroid, contiguous
+    * fast path.
+    *
+    * Available when the dissimilarity measure provides SquaredDiss.
+    *
+    * @param[in] rSample Reference to the vector that store the sample.
+    * @return The calculated squared dissimilarity value.
+    */
+   RealType             SquaredDiss(const DenseVector& rSample) const
+                           {
+                              if (!mCount)
+                              {
+                                 throw SpareLogicError("Centroid, 17, Uninitialized "
+                                                       "object.");
+                              }
+                              return DenseSquaredDiss(mDissAgent, rSample);
                            }
 
 // ACCESS
@@ -181,6 +321,83 @@ private:
    // Istanza classe misuratrice di dissimilarit&agrave;.
    Dissimilarity        mDissAgent;
 
+   // Dissimilarità da un vettore contiguo, caso generale.
+   template <typename DissType, typename ValueType>
+   RealType             DenseDiss(
+                           const DissType&                  rAgent,
+                           const std::vector<ValueType>&    rOther) const
+                           {
+                              return rAgent.Diss(mCentroid, rOther);
+                           }
+
+   // Dissimilarità da un vettore contiguo, distanza euclidea.
+   template <typename ValueType>
+   RealType             DenseDiss(
+                           const Euclidean&                 rAgent,
+                           const std::vector<ValueType>&    rOther) const
+                           {
+                              if ( rAgent.IsWeighted() )
+                              {
+                                 return rAgent.Diss(mCentroid, rOther);
+                              }
+
+                              return std::sqrt( KernelSquaredDiss(rOther) );
+                           }
+
+   // Dissimilarità da un vettore contiguo, distanza di Minkowski.
+   template <typename ValueType>
+   RealType             DenseDiss(
+                           const Minkowski&                 rAgent,
+                           const std::vector<ValueType>&    rOther) const
+                           {
+                              if ( rAgent.IsWeighted() || (rAgent.P() != static_cast<NaturalType>(2)) )
+                              {
+                                 return rAgent.Diss(mCentroid, rOther);
+                              }
+
+                              return std::sqrt( KernelSquaredDiss(rOther) );
+                           }
+
+   // Dissimilarità al quadrato da un vettore contiguo, caso generale.
+   template <typename DissType, typename ValueType>
+   RealType             DenseSquaredDiss(
+                           const DissType&                  rAgent,
+                           const std::vector<ValueType>&    rOther) const
+                           {
+                              return rAgent.SquaredDiss(mCentroid, rOther);
+                           }
+
+   // Dissimilarità al quadrato da un vettore contiguo, distanza euclidea.
+   template <typename ValueType>
+   RealType             DenseSquaredDiss(
+                           const Euclidean&                 rAgent,
+                           const std::vector<ValueType>&    rOther) const
+                           {
+                              if ( rAgent.IsWeighted() )
+                              {
+                                 return rAgent.SquaredDiss(mCentroid, rOther);
+                              }
+
+                              return KernelSquaredDiss(rOther);
+                           }
+
+   // Distanza euclidea al quadrato da un vettore contiguo.
+   template <typename ValueType>
+   RealType             KernelSquaredDiss(const std::vector<ValueType>& rOther) const
+                           {
+                              #if SPARE_DEBUG
+                              if ( mCentroid.size() != rOther.size() )
+                              {
+                                 throw SpareLogicError("Centroid, 11, Different lenghts.");
+                              }
+                              #endif
+
+                              return VectorKernels::SquaredDistance(
+                                                       mCentroid.data(),
+                                                       rOther.data(),
+                                                       mCentroid.size() );
+                           }
+
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
 
@@ -200,22 +417,24 @@ private:
 
 //==================================== OPERATIONS ==========================================
 
-template <typename Dissimilarity>
+template <typename Dissimilarity, typename StorageType>
 template <typename ForwardIterator>
 void
-Centroid<Dissimilarity>::Update(std::pair<ForwardIterator, ForwardIterator> aSample)
+Centroid<Dissimilarity, StorageType>::Update(std::pair<ForwardIterator, ForwardIterator> aSample)
 {
    // Typedef locali.
-   typedef CentroidVector::size_type
+   typedef typename CentroidVector::size_type
                         CentroidSizeType;
 
    typedef typename std::iterator_traits<ForwardIterator>::difference_type
                         SampleDiffType;
 
    // Variabili.
-   CentroidVector::iterator
+   typename CentroidVector::iterator
                         Mit;
 
+   RealType             Weight;
+
    // Se è il primo aggiornamento imposto la dimensione.
    if (!mCount)
    {
@@ -234,34 +453,37 @@ Centroid<Dissimilarity>::Update(std::pair<ForwardIterator, ForwardIterator> aSam
 
    Mit= mCentroid.begin();
    ++mCount;
+   Weight= 1. / static_cast<RealType>(mCount);
 
    while (aSample.first != aSample.second)
    {
-      (*Mit)+= ( static_cast<RealType>(*aSample.first++) - *Mit ) /
-                 static_cast<RealType>(mCount);
+      *Mit= static_cast<StorageType>(
+               *Mit + ( static_cast<RealType>(*aSample.first++) - *Mit ) * Weight );
       ++Mit;
    }
 }  // Update
 
-template <typename Dissimilarity>
+template <typename Dissimilarity, typename StorageType>
 template <typename SequenceContainer>
 void
-Centroid<Dissimilarity>::Update(const SequenceContainer& rSample)
+Centroid<Dissimilarity, StorageType>::Update(const SequenceContainer& rSample)
 {
    // Typedef locali.
-   typedef CentroidVector::size_type
+   typedef typename CentroidVector::size_type
                         CentroidSizeType;
 
    typedef typename SequenceContainer::size_type
                         SampleSizeType;
 
    // Variabili.
-   CentroidVector::iterator
+   typename CentroidVector::iterator
                         Mit;
 
    typename SequenceContainer::const_iterator
                         Sit;
 
+   RealType             Weight;
+
    // Se è il primo aggiornamento imposto la dimensione.
    if (!mCount)
    {
@@ -280,15 +502,198 @@ Centroid<Dissimilarity>::Update(const SequenceContainer& rSample)
    Mit= mCentroid.begin();
    Sit= rSample.begin();
    ++mCount;
+   Weight= 1. / static_cast<RealType>(mCount);
 
    while (rSample.end() != Sit)
    {
-      (*Mit)+= ( static_cast<RealType>(*Sit++) - *Mit ) /
-                 static_cast<RealType>(mCount);
+      *Mit= static_cast<StorageType>(
+               *Mit + ( static_cast<RealType>(*Sit++) - *Mit ) * Weight );
       ++Mit;
    }
 }  // Update
 
+template <typename Dissimilarity, typename StorageType>
+void
+Centroid<Dissimilarity, StorageType>::Update(const DenseVector& rSample)
+{
+   // Se è il primo aggiornamento imposto la dimensione.
+   if (!mCount)
+   {
+      mCentroid.resize( rSample.size() );
+   }
+
+   // Controllo.
+   #if SPARE_DEBUG
+   if ( mCentroid.size() != rSample.size() )
+   {
+      throw SpareLogicError("Centroid, 12, Different lenghts.");
+   }
+   #endif
+
+   ++mCount;
+
+   VectorKernels::MeanStep(
+                     mCentroid.data(),
+                     rSample.data(),
+                     mCentroid.size(),
+                     1. / static_cast<RealType>(mCount) );
+}  // Update
+
+template <typename Dissimilarity, typename StorageType>
+template <typename ForwardIterator>
+void
+Centroid<Dissimilarity, StorageType>::Remove(std::pair<ForwardIterator, ForwardIterator> aSample)
+{
+   // Variabili.
+   typename CentroidVector::iterator
+                        Mit;
+
+   RealType             Weight;
+
+   if (!mCount)
+   {
+      throw SpareLogicError("Centroid, 6, Uninitialized object.");
+   }
+
+   // Controllo.
+   #if SPARE_DEBUG
+   // Typedef locali.
+   typedef typename std::iterator_traits<ForwardIterator>::difference_type
+                        SampleDiffType;
+
+   if ( static_cast<SampleDiffType>( mCentroid.size() ) !=
+        std::distance(aSample.first, aSample.second) )
+   {
+      throw SpareLogicError("Centroid, 7, Different lenghts.");
+   }
+   #endif
+
+   // Se era l'ultimo campione il centroide torna vuoto.
+   if (!--mCount)
+   {
+      return;
+   }
+
+   Mit= mCentroid.begin();
+   Weight= 1. / static_cast<RealType>(mCount);
+
+   while (aSample.first != aSample.second)
+   {
+      *Mit= static_cast<StorageType>(
+               *Mit + ( *Mit - static_cast<RealType>(*aSample.first++) ) * Weight );
+      ++Mit;
+   }
+}  // Remove
+
+template <typename Dissimilarity, typename StorageType>
+template <typename SequenceContainer>
+void
+Centroid<Dissimilarity, StorageType>::Remove(const SequenceContainer& rSample)
+{
+   // Variabili.
+   typename CentroidVector::iterator
+                        Mit;
+
+   typename SequenceContainer::const_iterator
+                        Sit;
+
+   RealType             Weight;
+
+   if (!mCount)
+   {
+      throw SpareLogicError("Centroid, 8, Uninitialized object.");
+   }
+
+   // Controllo.
+   #if SPARE_DEBUG
+   if ( mCentroid.size() != rSample.size() )
+   {
+      throw SpareLogicError("Centroid, 9, Different lenghts.");
+   }
+   #endif
+
+   // Se era l'ultimo campione il centroide torna vuoto.
+   if (!--mCount)
+   {
+      return;
+   }
+
+   Mit= mCentroid.begin();
+   Sit= rSample.begin();
+   Weight= 1. / static_cast<RealType>(mCount);
+
+   while (rSample.end() != Sit)
+   {
+      *Mit= static_cast<StorageType>(
+               *Mit + ( *Mit - static_cast<RealType>(*Sit++) ) * Weight );
+      ++Mit;
+   }
+}  // Remove
+
+template <typename Dissimilarity, typename StorageType>
+void
+Centroid<Dissimilarity, StorageType>::Remove(const DenseVector& rSample)
+{
+   if (!mCount)
+   {
+      throw SpareLogicError("Centroid, 13, Uninitialized object.");
+   }
+
+   // Controllo.
+   #if SPARE_DEBUG
+   if ( mCentroid.size() != rSample.size() )
+   {
+      throw SpareLogicError("Centroid, 14, Different lenghts.");
+   }
+   #endif
+
+   // Se era l'ultimo campione il centroide torna vuoto.
+   if (!--mCount)
+   {
+      return;
+   }
+
+   // Passo con peso negativo: m + (m - x)/n.
+   VectorKernels::MeanStep(
+                     mCentroid.data(),
+                     rSample.data(),
+                     mCentroid.size(),
+                     -1. / static_cast<RealType>(mCount) );
+}  // Remove
+
+template <typename Dissimilarity, typename StorageType>
+void
+Centroid<Dissimilarity, StorageType>::Merge(const Centroid& rOther)
+{
+   if (!rOther.mCount)
+   {
+      return;
+   }
+
+   if (!mCount)
+   {
+      mCentroid= rOther.mCentroid;
+      mCount= rOther.mCount;
+      return;
+   }
+
+   // Controllo.
+   #if SPARE_DEBUG
+   if ( mCentroid.size() != rOther.mCentroid.size() )
+   {
+      throw SpareLogicError("Centroid, 5, Different lenghts.");
+   }
+   #endif
+
+   mCount+= rOther.mCount;
+
+   VectorKernels::MeanStep(
+                     mCentroid.data(),
+                     rOther.mCentroid.data(),
+                     mCentroid.size(),
+                     static_cast<RealType>(rOther.mCount) / static_cast<RealType>(mCount) );
+}  // Merge
+
 }  // namespace spare
 
 #endif  // _Centroid_h_
@@ -0,0 +1,616 @@
+//  CholeskyMahalanobis class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File CholeskyMahalanobis.hpp, containing the CholeskyMahalanobis class.
+ *
+ * The file contains the CholeskyMahalanobis class, implementing a cluster model based on a
+ * multivariate gaussian function, whose scatter matrix is stored as a Cholesky factor.
+ *
+ * @file CholeskyMahalanobis.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _CholeskyMahalanobis_h_
+#define _CholeskyMahalanobis_h_
+
+// STD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// BOOST INCLUDES
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+// SPARE INCLUDES
+#include <spare/SpareExceptions.hpp>
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusion in namespace spare.
+
+/** @brief Cluster model based on a multivariate gaussian function, Cholesky factorization.
+ *
+ * This class models the @a Representative concept, and it is a drop-in replacement for the
+ * Mahalanobis class, with the same estimates and dissimilarity values up to rounding. Instead
+ * of the inverse covariance matrix, the class keeps the lower triangular Cholesky factor
+ * \f$L\f$ of the regularized scatter matrix \f$A = I/\alpha + \sum_i \mathbf{d}_i
+ * \mathbf{d}_i^T\f$, where \f$\mathbf{d}_i\f$ is the difference between the i-th sample and
+ * the mean right after its insertion. The inverse covariance matrix is
+ * \f$C^{-1} = \gamma I + (1 - \gamma) n A^{-1}\f$, hence the squared %Mahalanobis distance of
+ * \f$\mathbf{y}\f$ is \f$\gamma |\mathbf{e}|^2 + (1 - \gamma) n |L^{-1}\mathbf{e}|^2\f$ with
+ * \f$\mathbf{e} = \mathbf{y} - \mathbf{x}\f$: one forward substitution and a dot product.
+ * The factor is kept up to date by O(n^2) rank-one updates (Update) and downdates (Remove),
+ * which never form an explicit inverse. The DissBatch method evaluates the distances of
+ * many samples with a single triangular solve on a matrix of right hand sides.
+ * @todo Merge implementation.
+ */
+class CholeskyMahalanobis
+{
+public:
+
+// PUBLIC TYPES
+
+   /** Dense matrix type.
+    */
+   typedef boost::numeric::ublas::matrix<RealType>
+                        BoostRealMatrix;
+
+// LIFECYCLE
+
+   /** Default constructor.
+    */
+   CholeskyMahalanobis()
+      : mCount(0),
+        mAlpha(1.),
+        mBeta(0.99),
+        mGamma(0.),
+        mCovGamma(0.)
+                                                   { }
+
+// OPERATIONS
+
+   /** Update of the representative using the boost vector interface.
+    *
+    * @param[in] rSample A reference to the boost vector holding the new sample.
+    */
+   void                 Update(const BoostRealVector& rSample);
+
+   /** Update of the representative using the iterator pair interface.
+    *
+    * @param[in] aSample Iterator pair delimiting the new sample.
+    */
+   template <typename ForwardIterator>
+   void                 Update(std::pair<ForwardIterator, ForwardIterator> aSample);
+
+   /** Update of the representative using the sequence container interface.
+    *
+    * @param[in] rSample A reference to the container holding the new sample.
+    */
+   template <typename SequenceContainer>
+   void                 Update(const SequenceContainer& rSample);
+
+   /** Removal of a sample from the representative, boost vector interface.
+    *
+    * The mean is downdated and the rank-one term of the sample, taken with respect to the
+    * current mean, is removed from the Cholesky factor. This is the exact inverse of the
+    * last Update, and an approximation of the removal of an earlier sample. If the scatter
+    * matrix would lose positive definiteness the object is left unchanged and an exception is
+    * thrown.
+    *
+    * @param[in] rSample A reference to the boost vector holding the sample.
+    */
+   void                 Remove(const BoostRealVector& rSample);
+
+   /** Removal of a sample from the representative, sequence container interface.
+    *
+    * @param[in] rSample A reference to the container holding the sample.
+    */
+   template <typename SequenceContainer>
+   void                 Remove(const SequenceContainer& rSample);
+
+   /** Mahalanobis distance between sample and representative, boost vector interface.
+    *
+    * @param[in] rSample A reference to the boost vector holding the sample.
+    * @return The dissimilarity value.
+    */
+   RealType             Diss(const BoostRealVector& rSample) const;
+
+   /** Mahalanobis distance between sample and representative, iterator pair interface.
+    *
+    * @param[in] aSample Iterator pair delimiting the new sample.
+    * @return The dissimilarity value.
+    */
+   template <typename ForwardIterator>
+   RealType             Diss(std::pair<ForwardIterator, ForwardIterator> aSample) const;
+
+   /** Mahalanobis distance between sample and representative, sequence container interface.
+    *
+    * @param[in] rSample A reference to the container holding the sample.
+    * @return The dissimilarity value.
+    */
+   template <typename SequenceContainer>
+   RealType             Diss(const SequenceContainer& rSample) const;
+
+   /** Mahalanobis distances between a range of samples and the representative.
+    *
+    * The samples are processed in blocks of 64: the differences from the mean are stored as
+    * the columns of a matrix, and the triangular system is solved for all of them at once,
+    * sweeping the rows of the factor once per block.
+    *
+    * @param[in] aFirst Iterator pointing to the first sample (a container or a boost vector).
+    * @param[in] aLast Iterator pointing to the first position after the last sample.
+    * @param[out] aOut Iterator pointing to the first position of the output distances.
+    */
+   template <typename ForwardIterator, typename OutputIterator>
+   void                 DissBatch(
+                           ForwardIterator   aFirst,
+                           ForwardIterator   aLast,
+                           OutputIterator    aOut) const;
+
+// ACCESS
+
+   /** Read only access to the mean vector.
+    *
+    * @return A const reference to the mean vector.
+    */
+   const BoostRealVector&
+                        getRepresentativeSample() const        { return mCentroid; }
+
+   /** Read only access to the lower triangular Cholesky factor of the scatter matrix.
+    *
+    * @return A const reference to the Cholesky factor (the upper part is zero).
+    */
+   const BoostRealMatrix&
+                        GetCholeskyFactor() const  { return mL; }
+
+   /** Inverse covariance matrix, computed from the Cholesky factor.
+    *
+    * @return The inverse covariance matrix.
+    */
+   BoostRealSymmMatrix  GetInvCov() const;
+
+   /** Read access to the number of samples inserted so far.
+    *
+    * @return The number of samples.
+    */
+   NaturalType          GetCount() const           { return mCount; }
+
+private:
+
+   // Centroide.
+   BoostRealVector      mCentroid;
+
+   // Fattore di Cholesky (triangolare inferiore) della matrice di dispersione regolarizzata.
+   BoostRealMatrix      mL;
+
+   // Conteggio dei campioni.
+   NaturalType          mCount;
+
+   // Alpha.
+   RealType             mAlpha;
+
+   // Beta.
+   RealType             mBeta;
+
+   // Gamma.
+   RealType             mGamma;
+
+   // Gamma usato nella matrice di covarianza corrente.
+   RealType             mCovGamma;
+
+   // Ausiliaria per Update e Remove.
+   BoostRealVector      mTemp1;
+
+   // Aggiornamento di rango uno L L^T + v v^T (aSign = 1) o L L^T - v v^T (aSign = -1);
+   // rV viene distrutto. Restituisce false se il risultato non è definito positivo.
+   bool                 RankOne(
+                           BoostRealVector&  rV,
+                           RealType          aSign);
+
+   // Distanza al quadrato a partire dalla differenza rE, che viene distrutta.
+   RealType             SquaredDiss(BoostRealVector& rE) const;
+
+   // Copia di un campione in un boost vector.
+   template <typename SequenceContainer>
+   static void          Load(
+                           const SequenceContainer&   rSample,
+                           BoostRealVector&           rOut);
+
+}; // class CholeskyMahalanobis
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+////////////////////////////////////// PUBLIC //////////////////////////////////////////////
+
+//==================================== OPERATIONS ==========================================
+
+inline void
+CholeskyMahalanobis::Update(const BoostRealVector& rInput)
+{
+   // Dichiarazioni.
+   BoostRealMatrix::size_type
+                        i;
+
+   // Se è il primo aggiornamento faccio inizializzazioni.
+   if (!mCount)
+   {
+      mCentroid.resize(rInput.size());
+      mL.resize(rInput.size(), rInput.size(), false);
+      mTemp1.resize(rInput.size());
+      mL.clear();
+      for (i= 0; i < mL.size1(); ++i)
+      {
+         mL(i, i)= 1. / std::sqrt(mAlpha);
+      }
+   }
+
+   // Controllo.
+   #if SPARE_DEBUG
+   if (mCentroid.size() != rInput.size())
+   {
+      throw SpareLogicError("CholeskyMahalanobis, 3, Different lenghts.");
+   }
+   #endif
+
+   // Aggiorno centroide.
+   mCentroid= (static_cast<RealType>(mCount)*mCentroid + rInput) /
+              (static_cast<RealType>(mCount)+1.);
+
+   // Incremento count.
+   ++mCount;
+
+   // Aggiorno fattore: A + d d^T.
+   mTemp1= rInput - mCentroid;
+   RankOne(mTemp1, 1.);
+
+   mCovGamma= mGamma;
+   mGamma*= mBeta;
+}
+
+template <typename ForwardIterator>
+void
+CholeskyMahalanobis::Update(std::pair<ForwardIterator, ForwardIterator> aSample)
+{
+   typename std::iterator_traits<ForwardIterator>::difference_type
+                             Diff= std::distance(aSample.first, aSample.second);
+
+   #if SPARE_DEBUG
+   if (Diff < 0)
+   {
+      throw SpareLogicError("CholeskyMahalanobis, 3, Invalid range.");
+   }
+   #endif
+
+   BoostRealVector           Input(Diff);
+   std::copy(aSample.first, aSample.second, Input.begin());
+
+   Update(Input);
+}
+
+template <typename SequenceContainer>
+void
+CholeskyMahalanobis::Update(const SequenceContainer& rSample)
+{
+   BoostRealVector           Input;
+
+   Load(rSample, Input);
+   Update(Input);
+}
+
+inline void
+CholeskyMahalanobis::Remove(const BoostRealVector& rInput)
+{
+   // Dichiarazioni.
+   BoostRealMatrix      Backup;
+
+   if (mCount < 2)
+   {
+      throw SpareLogicError("CholeskyMahalanobis, 1, Cannot remove the last sample.");
+   }
+
+   #if SPARE_DEBUG
+   if (mCentroid.size() != rInput.size())
+   {
+      throw SpareLogicError("CholeskyMahalanobis, 3, Different lenghts.");
+   }
+   #endif
+
+   // Tolgo dal fattore il termine del campione rispetto alla media corrente.
+   Backup= mL;
+   mTemp1= rInput - mCentroid;
+   if ( !RankOne(mTemp1, -1.) )
+   {
+      mL.swap(Backup);
+      throw SpareLogicError("CholeskyMahalanobis, 2, Downdate breaks positive definiteness.");
+   }
+
+   // Aggiorno centroide.
+   mCentroid= (static_cast<RealType>(mCount)*mCentroid - rInput) /
+              (static_cast<RealType>(mCount)-1.);
+
+   --mCount;
+
+   if (mBeta > 0.)
+   {
+      mGamma/= mBeta;
+      mCovGamma= mGamma / mBeta;
+   }
+}
+
+template <typename SequenceContainer>
+void
+CholeskyMahalanobis::Remove(const SequenceContainer& rSample)
+{
+   BoostRealVector           Input;
+
+   Load(rSample, Input);
+   Remove(Input);
+}
+
+inline RealType
+CholeskyMahalanobis::Diss(const BoostRealVector& rSample) const
+{
+   if (!mCount)
+   {
+      throw SpareLogicError("CholeskyMahalanobis, 0, Uninitialized object.");
+   }
+
+   #if SPARE_DEBUG
+   if (rSample.size() != mCentroid.size())
+   {
+      throw SpareLogicError("CholeskyMahalanobis, 3, Different lenghts.");
+   }
+   #endif
+
+   // Differenza locale: Diss può essere chiamato in concorrenza.
+   BoostRealVector           E(rSample - mCentroid);
+
+   return std::sqrt( SquaredDiss(E) );
+}
+
+template <typename ForwardIterator>
+RealType
+CholeskyMahalanobis::Diss(std::pair<ForwardIterator, ForwardIterator> aSample) const
+{
+   typename std::iterator_traits<ForwardIterator>::difference_type
+                             Diff= std::distance(aSample.first, aSample.second);
+
+   #if SPARE_DEBUG
+   if (Diff < 0)
+   {
+      throw SpareLogicError("CholeskyMahalanobis, 3, Invalid range.");
+   }
+   #endif
+
+   BoostRealVector           Input(Diff);
+   std::copy(aSample.first, aSample.second, Input.begin());
+
+   return Diss(Input);
+}
+
+template <typename SequenceContainer>
+RealType
+CholeskyMahalanobis::Diss(const SequenceContainer& rSample) const
+{
+   BoostRealVector           Input;
+
+   Load(rSample, Input);
+
+   return Diss(Input);
+}
+
+template <typename ForwardIterator, typename OutputIterator>
+void
+CholeskyMahalanobis::DissBatch(
+                        ForwardIterator   aFirst,
+                        ForwardIterator   aLast,
+                        OutputIterator    aOut) const
+{
+   // Dichiarazioni.
+   const BoostRealMatrix::size_type  BlockSize= 64;
+   BoostRealMatrix::size_type        N= mCentroid.size();
+   BoostRealMatrix::size_type        K;
+   BoostRealMatrix::size_type        i, j, c;
+   BoostRealMatrix                   Y(N, BlockSize);
+   std::vector<RealType>             Norm2(BlockSize);
+   std::vector<RealType>             Acc(BlockSize);
+   RealType                          Scale= (1. - mCovGamma) * static_cast<RealType>(mCount);
+   RealType                          Lij;
+
+   if (!mCount)
+   {
+      throw SpareLogicError("CholeskyMahalanobis, 0, Uninitialized object.");
+   }
+
+   while (aFirst != aLast)
+   {
+      // Differenze dalla media, un campione per colonna.
+      for (K= 0; (aFirst != aLast) && (K < BlockSize); ++aFirst, ++K)
+      {
+         #if SPARE_DEBUG
+         if (static_cast<BoostRealMatrix::size_type>(
+                std::distance(aFirst->begin(), aFirst->end())) != N)
+         {
+            throw SpareLogicError("CholeskyMahalanobis, 3, Different lenghts.");
+         }
+         #endif
+
+         i= 0;
+         for (typename std::iterator_traits<ForwardIterator>::value_type::const_iterator
+                 Sit= aFirst->begin(); i < N; ++Sit, ++i)
+         {
+            Y(i, K)= *Sit - mCentroid[i];
+         }
+      }
+
+      // Sostituzione in avanti L Y = E, una riga di L alla volta su tutte le colonne.
+      std::fill(Norm2.begin(), Norm2.begin() + K, 0.);
+      std::fill(Acc.begin(), Acc.begin() + K, 0.);
+      for (i= 0; i < N; ++i)
+      {
+         for (c= 0; c < K; ++c)
+         {
+            Norm2[c]+= Y(i, c) * Y(i, c);
+         }
+
+         for (j= 0; j < i; ++j)
+         {
+            Lij= mL(i, j);
+            for (c= 0; c < K; ++c)
+            {
+               Y(i, c)-= Lij * Y(j, c);
+            }
+         }
+
+         for (c= 0; c < K; ++c)
+         {
+            Y(i, c)/= mL(i, i);
+            Acc[c]+= Y(i, c) * Y(i, c);
+         }
+      }
+
+      for (c= 0; c < K; ++c)
+      {
+         *aOut++= std::sqrt(mCovGamma * Norm2[c] + Scale * Acc[c]);
+      }
+   }
+}
+
+//====================================== ACCESS ============================================
+
+inline BoostRealSymmMatrix
+CholeskyMahalanobis::GetInvCov() const
+{
+   // Dichiarazioni.
+   BoostRealMatrix::size_type        N= mL.size1();
+   BoostRealMatrix::size_type        i, j, k;
+   BoostRealMatrix                   Linv(N, N);
+   BoostRealSymmMatrix               InvCov(N);
+   RealType                          Acc;
+
+   // Inversa del fattore, per colonne.
+   Linv.clear();
+   for (j= 0; j < N; ++j)
+   {
+      Linv(j, j)= 1. / mL(j, j);
+      for (i= j + 1; i < N; ++i)
+      {
+         Acc= 0.;
+         for (k= j; k < i; ++k)
+         {
+            Acc+= mL(i, k) * Linv(k, j);
+         }
+         Linv(i, j)= -Acc / mL(i, i);
+      }
+   }
+
+   // C^-1 = gamma I + (1 - gamma) n L^-T L^-1.
+   for (i= 0; i < N; ++i)
+   {
+      for (j= 0; j <= i; ++j)
+      {
+         Acc= 0.;
+         for (k= i; k < N; ++k)
+         {
+            Acc+= Linv(k, i) * Linv(k, j);
+         }
+         InvCov(i, j)= (1. - mCovGamma) * static_cast<RealType>(mCount) * Acc +
+                       ( (i == j) ? mCovGamma : 0. );
+      }
+   }
+
+   return InvCov;
+}
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+inline bool
+CholeskyMahalanobis::RankOne(
+                        BoostRealVector&  rV,
+                        RealType          aSign)
+{
+   // Dichiarazioni.
+   BoostRealMatrix::size_type        N= mL.size1();
+   BoostRealMatrix::size_type        i, k;
+   RealType                          R2, R, C, S, Lkk;
+
+   for (k= 0; k < N; ++k)
+   {
+      Lkk= mL(k, k);
+      R2= Lkk * Lkk + aSign * rV[k] * rV[k];
+      if (R2 <= 0.)
+      {
+         return false;
+      }
+
+      R= std::sqrt(R2);
+      C= R / Lkk;
+      S= rV[k] / Lkk;
+      mL(k, k)= R;
+
+      for (i= k + 1; i < N; ++i)
+      {
+         mL(i, k)= ( mL(i, k) + aSign * S * rV[i] ) / C;
+         rV[i]= C * rV[i] - S * mL(i, k);
+      }
+   }
+
+   return true;
+}
+
+inline RealType
+CholeskyMahalanobis::SquaredDiss(BoostRealVector& rE) const
+{
+   // Dichiarazioni.
+   BoostRealMatrix::size_type        N= mL.size1();
+   BoostRealMatrix::size_type        i, j;
+   RealType                          Norm2= 0.;
+   RealType                          Acc= 0.;
+   RealType                          Y;
+
+   // Sostituzione in avanti L y = e, sovrascrivendo e.
+   for (i= 0; i < N; ++i)
+   {
+      Norm2+= rE[i] * rE[i];
+
+      Y= rE[i];
+      for (j= 0; j < i; ++j)
+      {
+         Y-= mL(i, j) * rE[j];
+      }
+      rE[i]= Y / mL(i, i);
+      Acc+= rE[i] * rE[i];
+   }
+
+   return mCovGamma * Norm2 + (1. - mCovGamma) * static_cast<RealType>(mCount) * Acc;
+}
+
+template <typename SequenceContainer>
+void
+CholeskyMahalanobis::Load(
+                        const SequenceContainer&   rSample,
+                        BoostRealVector&           rOut)
+{
+   rOut.resize(rSample.size(), false);
+   std::copy(rSample.begin(), rSample.end(), rOut.begin());
+}
+
+}  // namespace spare
+
+#endif  // _CholeskyMahalanobis_h_
@@ -0,0 +1,560 @@
+//  FuzzyHyperboxSet class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File FuzzyHyperboxSet.hpp, containing the FuzzyHyperboxSet class.
+ *
+ * The file contains the FuzzyHyperboxSet class, a container of fuzzy hyperboxes evaluating
+ * the memberships of a sample in all the boxes at once.
+ *
+ * @file FuzzyHyperboxSet.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _FuzzyHyperboxSet_h_
+#define _FuzzyHyperboxSet_h_
+
+// STD INCLUDES
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// BOOST INCLUDES
+#include <boost/align/aligned_allocator.hpp>
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+
+// SPARE INCLUDES
+#include <spare/BoundedParameter.hpp>
+#include <spare/Representative/FuzzyHyperbox.hpp>
+#include <spare/SpareExceptions.hpp>
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusion in namespace spare.
+
+/** @brief Set of fuzzy hyperboxes with vectorized membership evaluation.
+ *
+ * The class stores the min and max vertices of a set of hyperboxes of the same dimension in
+ * structure-of-arrays form: for each component, the values of all the boxes are contiguous
+ * and aligned. The memberships of a sample in all the boxes are then computed one component
+ * at a time, with SIMD min/max operations over the boxes (AVX or SSE2, chosen at compile
+ * time). The membership functions are the same of FuzzyHyperbox (Simpson or trapezoidal,
+ * selected by MembType, with sensitivity Gamma) and give the same values; the MembType and
+ * Gamma parameters are shared by all the boxes of the set.
+ * The Argmax methods return directly the box of maximum membership, which is what the
+ * classifiers built on hyperboxes need.
+ */
+class FuzzyHyperboxSet
+{
+public:
+
+// PUBLIC TYPES
+
+   /** Index and size type.
+    */
+   typedef std::size_t  SizeType;
+
+   /** Real parameter.
+    */
+   typedef BoundedParameter<RealType>
+                        RealParam;
+
+   /** Membership switch parameter.
+    */
+   typedef BoundedParameter<NaturalType>
+                        MembershipParam;
+
+// LIFECYCLE
+
+   /** Default constructor.
+    */
+   FuzzyHyperboxSet()
+      : mMembType(FHB_MT_SIMPSON, FHB_MT_TRAPEZOIDAL),
+        mGamma(RealType(0), std::numeric_limits<RealType>::max()),
+        mSize(0),
+        mStride(0),
+        mDim(0)
+   {
+      mMembType= FHB_MT_SIMPSON;
+      mGamma= RealType(1);
+   }
+
+// OPERATIONS
+
+   /** Insertion of a hyperbox.
+    *
+    * The vertices of the box are copied in the set; its MembType and Gamma are not used.
+    *
+    * @param[in] rBox The hyperbox, already updated with at least one sample.
+    * @return The index of the box in the set.
+    */
+   SizeType             Insert(const FuzzyHyperbox& rBox);
+
+   /** Update of a hyperbox of the set, with the same rule of FuzzyHyperbox::Update.
+    *
+    * @param[in] aBox Index of the box.
+    * @param[in] rSample Reference to the container storing the sample.
+    */
+   template <typename SequenceContainer>
+   void                 Update(
+                           SizeType                   aBox,
+                           const SequenceContainer&   rSample);
+
+   /** Removal of all the hyperboxes.
+    */
+   void                 Clear()
+                           {
+                              mV.clear();
+                              mW.clear();
+                              mSize= 0;
+                              mStride= 0;
+                              mDim= 0;
+                           }
+
+   /** Memberships of a sample in all the hyperboxes.
+    *
+    * @param[in] rSample Reference to the container storing the sample.
+    * @param[out] aOut Iterator to the first of the GetSize() output memberships.
+    */
+   template <typename SequenceContainer, typename OutputIterator>
+   void                 Eval(
+                           const SequenceContainer&   rSample,
+                           OutputIterator             aOut) const;
+
+   /** Hyperbox of maximum membership for a sample.
+    *
+    * Ties are resolved in favour of the lowest index.
+    *
+    * @param[in] rSample Reference to the container storing the sample.
+    * @param[out] rMemb The maximum membership.
+    * @return The index of the box.
+    */
+   template <typename SequenceContainer>
+   SizeType             Argmax(
+                           const SequenceContainer&   rSample,
+                           RealType&                  rMemb) const;
+
+   /** Hyperbox of maximum membership for a sample.
+    *
+    * @param[in] rSample Reference to the container storing the sample.
+    * @return The index of the box.
+    */
+   template <typename SequenceContainer>
+   SizeType             Argmax(const SequenceContainer& rSample) const
+                           {
+                              RealType Memb;
+
+                              return Argmax(rSample, Memb);
+                           }
+
+   /** Hyperboxes of maximum membership for a batch of samples.
+    *
+    * @param[in] aFirst Iterator to the first sample.
+    * @param[in] aLast Iterator to the position after the last sample.
+    * @param[out] aOut Iterator to the first output box index.
+    */
+   template <typename ForwardIterator, typename OutputIterator>
+   void                 ArgmaxBatch(
+                           ForwardIterator            aFirst,
+                           ForwardIterator            aLast,
+                           OutputIterator             aOut) const;
+
+// ACCESS
+
+   /** Read/write access to the MembType parameter.
+    *
+    * @return A reference to the MembType parameter.
+    */
+   MembershipParam&     MembType()                 { return mMembType; }
+
+   /** Read only access to the MembType parameter.
+    *
+    * @return A const reference to the MembType parameter.
+    */
+   const MembershipParam&
+                        MembType() const           { return mMembType; }
+
+   /** Read/write access to the Gamma parameter.
+    *
+    * @return A reference to the Gamma parameter.
+    */
+   RealParam&           Gamma()                    { return mGamma; }
+
+   /** Read only access to the Gamma parameter.
+    *
+    * @return A const reference to the Gamma parameter.
+    */
+   const RealParam&     Gamma() const              { return mGamma; }
+
+   /** Read access to the number of hyperboxes.
+    *
+    * @return The number of hyperboxes.
+    */
+   SizeType             GetSize() const            { return mSize; }
+
+   /** Read access to the dimension of the hyperboxes.
+    *
+    * @return The dimension.
+    */
+   SizeType             GetDimension() const       { return mDim; }
+
+private:
+
+   // Vertici, per componente: la componente d del box k è in posizione d*mStride + k.
+   typedef std::vector<RealType, boost::alignment::aligned_allocator<RealType, 64> >
+                        VertexArray;
+
+   VertexArray          mV;
+   VertexArray          mW;
+
+   MembershipParam      mMembType;
+   RealParam            mGamma;
+
+   // Numero di box, capacità di ciascuna riga e dimensione.
+   SizeType             mSize;
+   SizeType             mStride;
+   SizeType             mDim;
+
+   // Memberships di un campione in tutti i box, in rAcc.
+   template <typename SequenceContainer>
+   void                 Accumulate(
+                           const SequenceContainer&   rSample,
+                           VertexArray&               rAcc) const;
+
+   // Contributo della componente x su tutti i box: somma (Simpson) o minimo (trapezoidale).
+   void                 Component(
+                           const RealType*   pV,
+                           const RealType*   pW,
+                           RealType          x,
+                           RealType*         pAcc) const;
+
+   // BOOST SERIALIZATION
+   friend class boost::serialization::access;
+
+   template<class Archive>
+   void serialize(Archive & ar, const unsigned int version)
+   {
+      ar & BOOST_SERIALIZATION_NVP(mV);
+      ar & BOOST_SERIALIZATION_NVP(mW);
+      ar & BOOST_SERIALIZATION_NVP(mMembType);
+      ar & BOOST_SERIALIZATION_NVP(mGamma);
+      ar & BOOST_SERIALIZATION_NVP(mSize);
+      ar & BOOST_SERIALIZATION_NVP(mStride);
+      ar & BOOST_SERIALIZATION_NVP(mDim);
+   } // BOOST SERIALIZATION
+
+}; // class FuzzyHyperboxSet
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+////////////////////////////////////// PUBLIC //////////////////////////////////////////////
+
+//==================================== OPERATIONS ==========================================
+
+inline FuzzyHyperboxSet::SizeType
+FuzzyHyperboxSet::Insert(const FuzzyHyperbox& rBox)
+{
+   // Variables.
+   SizeType             Stride;
+   SizeType             d, k;
+   VertexArray          V, W;
+
+   if ( !rBox.GetCount() )
+   {
+      throw SpareLogicError("FuzzyHyperboxSet, 0, Uninitialized hyperbox.");
+   }
+
+   if (!mSize)
+   {
+      mDim= rBox.GetV().size();
+   }
+   else if ( rBox.GetV().size() != mDim )
+   {
+      throw SpareLogicError("FuzzyHyperboxSet, 1, Different lenghts.");
+   }
+
+   // Growth of the rows, keeping their length a multiple of the SIMD width.
+   if (mSize == mStride)
+   {
+      Stride= std::max<SizeType>(8, 2 * mStride);
+      V.assign(mDim * Stride, RealType(0));
+      W.assign(mDim * Stride, RealType(0));
+      for (d= 0; d < mDim; ++d)
+      {
+         for (k= 0; k < mSize; ++k)
+         {
+            V[d * Stride + k]= mV[d * mStride + k];
+            W[d * Stride + k]= mW[d * mStride + k];
+         }
+      }
+      mV.swap(V);
+      mW.swap(W);
+      mStride= Stride;
+   }
+
+   for (d= 0; d < mDim; ++d)
+   {
+      mV[d * mStride + mSize]= rBox.GetV()[d];
+      mW[d * mStride + mSize]= rBox.GetW()[d];
+   }
+
+   return mSize++;
+}  // Insert
+
+template <typename SequenceContainer>
+void
+FuzzyHyperboxSet::Update(
+                     SizeType                   aBox,
+                     const SequenceContainer&   rSample)
+{
+   // Variables.
+   typename SequenceContainer::const_iterator
+                        Sit= rSample.begin();
+
+   RealType*            pV;
+   RealType*            pW;
+
+   if (aBox >= mSize)
+   {
+      throw SpareLogicError("FuzzyHyperboxSet, 2, Invalid hyperbox index.");
+   }
+
+   #if SPARE_DEBUG
+   if (rSample.size() != mDim)
+   {
+      throw SpareLogicError("FuzzyHyperboxSet, 3, Different lenghts.");
+   }
+   #endif
+
+   for (SizeType d= 0; d < mDim; ++d, ++Sit)
+   {
+      pV= &mV[d * mStride + aBox];
+      pW= &mW[d * mStride + aBox];
+      if (*Sit < *pV)
+      {
+         *pV= *Sit;
+      }
+      else
+      {
+         if (*Sit > *pW)
+         {
+            *pW= *Sit;
+         }
+      }
+   }
+}  // Update
+
+template <typename SequenceContainer, typename OutputIterator>
+void
+FuzzyHyperboxSet::Eval(
+                     const SequenceContainer&   rSample,
+                     OutputIterator             aOut) const
+{
+   VertexArray          Acc;
+
+   Accumulate(rSample, Acc);
+   std::copy(Acc.begin(), Acc.begin() + mSize, aOut);
+}  // Eval
+
+template <typename SequenceContainer>
+FuzzyHyperboxSet::SizeType
+FuzzyHyperboxSet::Argmax(
+                     const SequenceContainer&   rSample,
+                     RealType&                  rMemb) const
+{
+   VertexArray          Acc;
+   SizeType             Best;
+
+   Accumulate(rSample, Acc);
+   Best= std::max_element(Acc.begin(), Acc.begin() + mSize) - Acc.begin();
+   rMemb= Acc[Best];
+
+   return Best;
+}  // Argmax
+
+template <typename ForwardIterator, typename OutputIterator>
+void
+FuzzyHyperboxSet::ArgmaxBatch(
+                     ForwardIterator            aFirst,
+                     ForwardIterator            aLast,
+                     OutputIterator             aOut) const
+{
+   // Accumulator shared by all the samples of the batch.
+   VertexArray          Acc;
+
+   while (aFirst != aLast)
+   {
+      Accumulate(*aFirst++, Acc);
+      *aOut++= std::max_element(Acc.begin(), Acc.begin() + mSize) - Acc.begin();
+   }
+}  // ArgmaxBatch
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+template <typename SequenceContainer>
+void
+FuzzyHyperboxSet::Accumulate(
+                     const SequenceContainer&   rSample,
+                     VertexArray&               rAcc) const
+{
+   // Variables.
+   typename SequenceContainer::const_iterator
+                        Sit= rSample.begin();
+
+   SizeType             k;
+
+   if (!mSize)
+   {
+      throw SpareLogicError("FuzzyHyperboxSet, 4, Empty set.");
+   }
+
+   #if SPARE_DEBUG
+   if (rSample.size() != mDim)
+   {
+      throw SpareLogicError("FuzzyHyperboxSet, 5, Different lenghts.");
+   }
+   #endif
+
+   switch (mMembType)
+   {
+      case FHB_MT_SIMPSON:
+         rAcc.assign(mStride, RealType(0));
+      break;
+
+      case FHB_MT_TRAPEZOIDAL:
+         rAcc.assign(mStride, RealType(1));
+      break;
+
+      default:
+         throw SpareLogicError("FuzzyHyperboxSet, 6, Unknown membership function.");
+      break;
+   }
+
+   for (SizeType d= 0; d < mDim; ++d, ++Sit)
+   {
+      Component(&mV[d * mStride], &mW[d * mStride], static_cast<RealType>(*Sit), &rAcc[0]);
+   }
+
+   // Same normalization of FuzzyHyperbox.
+   if (mMembType == FHB_MT_SIMPSON)
+   {
+      for (k= 0; k < mSize; ++k)
+      {
+         rAcc[k]/= (2 * mDim);
+         rAcc[k]-= RealType(0.5);
+         rAcc[k]*= RealType(2);
+      }
+   }
+}  // Accumulate
+
+inline void
+FuzzyHyperboxSet::Component(
+                     const RealType*   pV,
+                     const RealType*   pW,
+                     RealType          x,
+                     RealType*         pAcc) const
+{
+   // Variables.
+   const RealType       G= mGamma;
+   const bool           Simpson= (mMembType == FHB_MT_SIMPSON);
+   RealType             A, B;
+   SizeType             k= 0;
+
+   // The SIMD operations keep the operand order of std::min/std::max, hence the results
+   // are identical to the scalar ones.
+#if defined(__AVX__)
+   const __m256d        Zero= _mm256_setzero_pd();
+   const __m256d        One= _mm256_set1_pd(1.);
+   const __m256d        Gv= _mm256_set1_pd(G);
+   const __m256d        Xv= _mm256_set1_pd(x);
+   __m256d              Av, Bv;
+
+   for (; k + 4 <= mSize; k+= 4)
+   {
+      Av= _mm256_min_pd( _mm256_sub_pd(_mm256_load_pd(pV + k), Xv), One );
+      Av= _mm256_max_pd( _mm256_mul_pd(Gv, Av), Zero );
+      Av= _mm256_max_pd( _mm256_sub_pd(One, Av), Zero );
+      Bv= _mm256_min_pd( _mm256_sub_pd(Xv, _mm256_load_pd(pW + k)), One );
+      Bv= _mm256_max_pd( _mm256_mul_pd(Gv, Bv), Zero );
+      Bv= _mm256_max_pd( _mm256_sub_pd(One, Bv), Zero );
+      if (Simpson)
+      {
+         _mm256_store_pd( pAcc + k, _mm256_add_pd( _mm256_load_pd(pAcc + k),
+                                                   _mm256_add_pd(Av, Bv) ) );
+      }
+      else
+      {
+         _mm256_store_pd( pAcc + k, _mm256_min_pd( _mm256_min_pd(Av, Bv),
+                                                   _mm256_load_pd(pAcc + k) ) );
+      }
+   }
+#elif defined(__SSE2__)
+   const __m128d        Zero= _mm_setzero_pd();
+   const __m128d        One= _mm_set1_pd(1.);
+   const __m128d        Gv= _mm_set1_pd(G);
+   const __m128d        Xv= _mm_set1_pd(x);
+   __m128d              Av, Bv;
+
+   for (; k + 2 <= mSize; k+= 2)
+   {
+      Av= _mm_min_pd( _mm_sub_pd(_mm_load_pd(pV + k), Xv), One );
+      Av= _mm_max_pd( _mm_mul_pd(Gv, Av), Zero );
+      Av= _mm_max_pd( _mm_sub_pd(One, Av), Zero );
+      Bv= _mm_min_pd( _mm_sub_pd(Xv, _mm_load_pd(pW + k)), One );
+      Bv= _mm_max_pd( _mm_mul_pd(Gv, Bv), Zero );
+      Bv= _mm_max_pd( _mm_sub_pd(One, Bv), Zero );
+      if (Simpson)
+      {
+         _mm_store_pd( pAcc + k, _mm_add_pd( _mm_load_pd(pAcc + k), _mm_add_pd(Av, Bv) ) );
+      }
+      else
+      {
+         _mm_store_pd( pAcc + k, _mm_min_pd( _mm_min_pd(Av, Bv), _mm_load_pd(pAcc + k) ) );
+      }
+   }
+#endif
+
+   for (; k < mSize; ++k)
+   {
+      A= std::max( RealType(0),
+                   RealType(1) - std::max( RealType(0),
+                                           G * std::min(RealType(1), pV[k] - x) ) );
+      B= std::max( RealType(0),
+                   RealType(1) - std::max( RealType(0),
+                                           G * std::min(RealType(1), x - pW[k]) ) );
+      if (Simpson)
+      {
+         pAcc[k]+= A + B;
+      }
+      else
+      {
+         pAcc[k]= std::min( pAcc[k], std::min(A, B) );
+      }
+   }
+}  // Component
+
+}  // namespace spare
+
+#endif  // _FuzzyHyperboxSet_h_
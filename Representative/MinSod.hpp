@@ -28,19 +28,24 @@
 
 // STD INCLUDES
 #include <algorithm>
-#include <iterator>
+#include <cmath>
+#include <functional>
 #include <limits>
 #include <vector>
 
 // BOOST INCLUDES
+#include <boost/align/aligned_allocator.hpp>
 #include <boost/numeric/conversion/converter.hpp>
-#include <boost/numeric/ublas/symmetric.hpp>
 #include <boost/random.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/shared_ptr.hpp>
 
 // SPARE INCLUDES
+#include <spare/Dissimilarity/BoundedDiss.hpp>
+#include <spare/Executor.hpp>
+#include <spare/Representative/SodRowBlock.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
 
@@ -53,8 +58,10 @@ namespace spare {  // Inclusione in namespace spare.
  * other samples in the cluster. This allows the usage with a generic data type for samples,
  * only requiring a dissimilarity measure to be defined. A speed up is adopted, based on
  * the tracking of the SOD-minimizing element within a reduced pool of samples (@a cache).
- * @todo BatchUpdate implementation.
- * @todo Merge implementation.
+ * The dissimilarities between the cached samples are stored in a packed, cache-line aligned
+ * lower triangular buffer (see GetDissCache).
+ * The dissimilarities of the incoming samples from the cache can be evaluated in parallel on
+ * an Executor (see UpdateParallel and UpdateBatch).
  * @todo Random choose between SODs of the same score.
  */
 template <typename SampleType, typename Dissimilarity>
@@ -78,12 +85,17 @@ public:
    typedef typename std::vector<SampleType>::size_type
                         SampleSizeType;
 
+   /** Container type for the packed lower triangular dissimilarity matrix of the cache.
+    */
+   typedef std::vector<RealType, boost::alignment::aligned_allocator<RealType, 64> >
+                        DissCache;
+
 // LIFECYCLE
 
    /** Default constructor.
     */
    MinSod()
-      : mSampleDist( 0, std::numeric_limits<BoostRealSymmMatrix::size_type>::max() )
+      : mSampleDist( 0, std::numeric_limits<typename DissCache::size_type>::max() )
                                                    { Init(20);
                                                      mP=1;
                                                    }
@@ -93,7 +105,7 @@ public:
     * @param[in] aM Cache size.
     */
    MinSod(NaturalType aM)
-      : mSampleDist( 0, std::numeric_limits<BoostRealSymmMatrix::size_type>::max() )
+      : mSampleDist( 0, std::numeric_limits<typename DissCache::size_type>::max() )
                                                    { Init(aM);
                                                         mP=1;
                                                    }
@@ -106,6 +118,45 @@ public:
     */
    void                 Update(const SampleType& rSample);
 
+   /** Update of the representative, evaluating the dissimilarities in parallel.
+    *
+    * Same as Update, but the M dissimilarities of the new sample from the cache are evaluated
+    * on the executor (see ExecutorSetup). The Diss method of the dissimilarity agent must be
+    * safe for concurrent calls.
+    *
+    * @param[in] rSample A reference to the new sample.
+    */
+   void                 UpdateParallel(const SampleType& rSample)
+                           {
+                              UpdateBatch(&rSample, &rSample + 1);
+                           }
+
+   /** Update of the representative with a range of samples.
+    *
+    * The result is the same as calling Update on each sample in order. The samples are taken
+    * in blocks of max(1, M/8): the dissimilarities of a block from the cache, and among the
+    * samples of the block, are evaluated in parallel on the executor (see ExecutorSetup),
+    * then the updates are applied sequentially. The block size bounds the evaluations spent
+    * on cached samples replaced within the block to about 6%. The Diss method of the
+    * dissimilarity agent must be safe for concurrent calls.
+    *
+    * @param[in] aFirst Iterator pointing to the first sample.
+    * @param[in] aLast Iterator pointing to the first position after the last sample.
+    */
+   template <typename ForwardIterator>
+   void                 UpdateBatch(ForwardIterator aFirst, ForwardIterator aLast);
+
+   /** Merge of another representative.
+    *
+    * The caches of the two representatives are merged by weighted reservoir sampling: each
+    * cached sample stands for GetCount()/|cache| samples of its cluster, and the M samples
+    * with the highest random keys, drawn according to these weights, are kept. The
+    * dissimilarities between samples coming from the same cache are reused.
+    *
+    * @param[in] rOther Reference to the representative to be merged.
+    */
+   void                 Merge(const MinSod<SampleType, Dissimilarity>& rOther);
+
    /** Dissimilarity evaluation between sample and representative.
     *
     * @param[in] rSample Reference to the sample.
@@ -123,6 +174,30 @@ public:
                                                    rSample);
                            }
 
+   /** Bounded dissimilarity evaluation between the representative and a sample.
+    *
+    * The bounded Diss of the dissimilarity agent is used when available (see BoundedDiss).
+    *
+    * @param[in] rSample Reference to the sample.
+    * @param[in] aBound The bound.
+    * @return The dissimilarity value if not greater than aBound, a greater value otherwise.
+    */
+   RealType             Diss(
+                           const SampleType& rSample,
+                           RealType          aBound) const
+                           {
+                              if ( mSamples.empty() )
+                              {
+                                 throw SpareLogicError("MinSod, 0, Uninitialized object.");
+                              }
+
+                              return BoundedDiss(
+                                        mDissAgent,
+                                        mSamples[mMinSodIndex],
+                                        rSample,
+                                        aBound);
+                           }
+
    /** Dissimilarity evaluation between two representatives.
     *
     * @param[in] rOther Reference to another representative.
@@ -224,9 +299,27 @@ public:
    NaturalType          GetCount() const           { return mCount; }
 
    /**
-    * Read-only access to the internal dissimilarity matrix
+    * Read-only access to the internal dissimilarity matrix, as a symmetric matrix whose order is
+    * the cache size. The matrix is built on demand from the packed cache (see GetDissCache).
     */
-   const BoostRealSymmMatrix& DissimilarityMatrix() { return mDissMatrix; }
+   BoostRealSymmMatrix  DissimilarityMatrix() const;
+
+   /**
+    * Read-only access to the internal dissimilarity matrix, packed by rows in lower triangular
+    * form: the element (i, j), with j <= i, is stored in position i*(i+1)/2 + j.
+    */
+   const DissCache&     GetDissCache() const       { return mDissMatrix; }
+
+   /** Read access to an element of the internal dissimilarity matrix.
+    *
+    * @param[in] i Row index.
+    * @param[in] j Column index.
+    * @return The dissimilarity between the i-th and the j-th cached samples.
+    */
+   RealType             CachedDiss(SampleSizeType i, SampleSizeType j) const
+                           {
+                              return mDissMatrix[ (i < j) ? Packed(j, i) : Packed(i, j) ];
+                           }
 
 
 // SETUP
@@ -240,6 +333,31 @@ public:
                               mRng.seed(aSeed);
                            }
 
+   /** Setup of the executor used by UpdateParallel and UpdateBatch.
+    *
+    * @param[in] pExecutor Shared pointer to the executor.
+    */
+   void                 ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor)
+                                                   { mExecutor= pExecutor; }
+
+   /** Read access to the executor used by UpdateParallel and UpdateBatch.
+    *
+    * If no executor has been set up, the process-wide one (see Executor::Shared) is used, so
+    * that the representatives of a clustering share the same threads.
+    *
+    * @return A shared pointer to the executor.
+    */
+   const boost::shared_ptr<Executor>&
+                        GetExecutor() const
+                           {
+                              if (!mExecutor)
+                              {
+                                 return Executor::Shared();
+                              }
+
+                              return mExecutor;
+                           }
+
 private:
 
    // Potenza da applicare alle distanze
@@ -257,8 +375,19 @@ private:
    // Campioni immagazzinati.
    SampleVector         mSamples;
 
-   // Matrice dissimilarità.
-   BoostRealSymmMatrix  mDissMatrix;
+   // Matrice dissimilarità, triangolare inferiore impaccata per righe.
+   DissCache            mDissMatrix;
+
+   // Riga di lavoro delle dissimilarità del nuovo campione.
+   SodVector            mRow;
+
+   // Dissimilarità del blocco corrente di UpdateBatch.
+   SodRowBlock<SampleType, Dissimilarity>
+                        mBlock;
+
+   // Executor per UpdateParallel e UpdateBatch.
+   boost::shared_ptr<Executor>
+                        mExecutor;
 
    // Valori SOD relativi ai campioni immagazzinati.
    SodVector            mSods;
@@ -278,22 +407,42 @@ private:
                         mRng;
 
    // Distribuzione per estrazione campione.
-   mutable boost::uniform_int<BoostRealSymmMatrix::size_type>
+   mutable boost::uniform_int<typename DissCache::size_type>
                         mSampleDist;
    // BOOST RANDOM
 
    // Inizializzazione, richiamata dai costruttori.
    void                 Init(NaturalType aM);
 
+   // Posizione dell'elemento (i, j), con j <= i, nella matrice impaccata.
+   static SampleSizeType
+                        Packed(SampleSizeType i, SampleSizeType j)
+                           {
+                              return i * (i + 1) / 2 + j;
+                           }
+
+   // Elevamento a potenza mP degli elementi di [aFirst, aLast); per P = 1 e P = 2, i cui
+   // risultati coincidono con std::pow, senza chiamate a funzione.
+   void                 ApplyPower(RealType* aFirst, RealType* aLast) const;
+
+   // Sostituzione della riga i della matrice con mRow e aggiornamento delle SOD.
+   void                 StoreRow(SampleSizeType i, SampleSizeType aSize);
+
+   // Inserimento del campione nella cache, restituisce lo slot occupato.
+   SampleSizeType       Place(const SampleType& rSample);
+
+   // Aggiornamento degli indici MinSod, MaxSod e di scarto.
+   void                 UpdateIndices();
+
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
 
    template<class Archive>
    void serialize(Archive & ar, const unsigned int version)
    {
-      BoostRealSymmMatrix::size_type i, j, k;
+      SampleSizeType i, j, k;
 
-      k= boost::numeric::converter<BoostRealSymmMatrix::size_type, NaturalType>
+      k= boost::numeric::converter<SampleSizeType, NaturalType>
          ::convert(mM);
 
       ar & BOOST_SERIALIZATION_NVP(mM);
@@ -303,20 +452,19 @@ private:
 
       if (k != mM)
       {
-         mDissMatrix.resize(
-                        boost::numeric
-                        ::converter<BoostRealSymmMatrix::size_type, NaturalType>
-                        ::convert(mM) );
+         k= boost::numeric::converter<SampleSizeType, NaturalType>::convert(mM);
+         mDissMatrix.resize( Packed(k, 0) );
       }
 
-      k= boost::numeric::converter<BoostRealSymmMatrix::size_type, SampleSizeType>
-         ::convert( mSamples.size() );
+      // Stesso ordine della symmetric_matrix usata in precedenza, per compatibilità degli
+      // archivi.
+      k= mSamples.size();
 
       for (i= 0; i < k; i++)
       {
          for (j= 0; j <= i; j++)
          {
-            ar & boost::serialization::make_nvp("dmel", mDissMatrix(i, j));
+            ar & boost::serialization::make_nvp("dmel", mDissMatrix[ Packed(i, j) ]);
          }
       }
 
@@ -337,124 +485,338 @@ template <typename SampleType, typename Dissimilarity>
 void
 MinSod<SampleType, Dissimilarity>::Update(const SampleType& rSample)
 {
-   // Typedef locali.
-   typedef std::iterator_traits<std::vector<RealType>::const_iterator>::difference_type
-                        SodDiffType;
-
    // Variabili.
-   typename std::vector<SampleType>::const_iterator   Pit;
-   std::vector<RealType>::iterator                    Sit, S2it;
-   BoostRealSymmMatrix::size_type                     i;
-   BoostRealSymmMatrix::size_type                     j;
-   BoostRealSymmMatrix::size_type                     k;
-   RealType                                           Sod;
-   RealType                                           Temp;
+   SampleSizeType       i;
+   SampleSizeType       j;
 
-   if ( mSamples.size() < boost::numeric::converter<SampleSizeType, NaturalType>
-                          ::convert(mM) )
+   i= Place(rSample);
+
+   // Calcolo distanze del nuovo campione dagli altri.
+   mRow.resize( mSamples.size() );
+   for (j= 0; j < mSamples.size(); j++)
    {
-      // In questo caso accresco l'insieme dei campioni immagazzinati,
-      // senza scartare nessuno.
+      mRow[j]= (j != i) ? mDissAgent.Diss(mSamples[j], mSamples[i]) : 0;
+   }
 
-      // Aggiungo campione.
-      mSamples.push_back(rSample);
-      mSods.push_back(0);
+   StoreRow( i, mSamples.size() );
+
+   UpdateIndices();
+
+   mCount++;
+}  // Update
+
+template <typename SampleType, typename Dissimilarity>
+template <typename ForwardIterator>
+void
+MinSod<SampleType, Dissimilarity>::UpdateBatch(ForwardIterator aFirst, ForwardIterator aLast)
+{
+   // Variabili.
+   typename SodRowBlock<SampleType, Dissimilarity>::SamplePtrVector
+                        Block;
+   SampleSizeType       M_;
+   SampleSizeType       BlockSize;
+   SampleSizeType       FirstSlot;
+   SampleSizeType       b;
+   SampleSizeType       i;
+
+   M_= boost::numeric::converter<SampleSizeType, NaturalType>::convert(mM);
+   BlockSize= std::max<SampleSizeType>(1, M_ / 8);
+
+   while (aFirst != aLast)
+   {
+      Block.clear();
+      for (; (aFirst != aLast) && (Block.size() < BlockSize); ++aFirst)
+      {
+         Block.push_back( &(*aFirst) );
+      }
 
-      // Calcolo distanze del nuovo campione dai vecchi.
-      Pit= mSamples.begin();
-      Sit= mSods.begin();
-      Sod= 0;
-      i= boost::numeric::converter<BoostRealSymmMatrix::size_type, SampleSizeType>
-         ::convert(mSamples.size() - 1);
+      FirstSlot= (mSamples.size() < M_) ? mSamples.size() : mDiscardIndex;
+      mBlock.Evaluate(*GetExecutor(), mDissAgent, mSamples, Block, FirstSlot);
 
-      // Eseguo aggiornamento.
-      for(j= 0; j < i; ++j)
+      // Aggiornamenti in sequenza, come in Update.
+      for (b= 0; b < Block.size(); b++)
       {
-         Temp= std::pow(mDissAgent.Diss(*Pit++, mSamples.back()), mP);
+         i= Place( *Block[b] );
+         mBlock.FillRow( b, i, mSamples.size(), mRow );
+
+         StoreRow( i, mSamples.size() );
 
-         (*Sit++)+= Temp;
-         Sod+= Temp;
-         mDissMatrix(i, j)= Temp;
+         UpdateIndices();
+
+         mCount++;
       }
+   }
+}  // UpdateBatch
+
+template <typename SampleType, typename Dissimilarity>
+void
+MinSod<SampleType, Dissimilarity>::Merge(const MinSod<SampleType, Dissimilarity>& rOther)
+{
+   // Typedef locali.
+   typedef SampleSizeType
+                        MatrixSizeType;
+
+   // Elemento del serbatoio: chiave, provenienza (true se da rOther), indice nella cache.
+   typedef std::pair<RealType, std::pair<bool, MatrixSizeType> >
+                        PoolItem;
 
-      (*Sit)= Sod;
-      mDissMatrix(i, i)= 0;
+   // Variabili.
+   std::vector<PoolItem>            Pool;
+   DissCache                        Matrix( mDissMatrix.size() );
+   SampleVector                     Samples;
+   boost::uniform_01<boost::mt19937&>
+                                    Unif(mRng);
+   MatrixSizeType                   i;
+   MatrixSizeType                   j;
+   RealType                         Weight;
+   RealType                         Temp;
+
+   if ( rOther.mSamples.empty() )
+   {
+      return;
    }
-   else
+
+   // Chiavi log(u)/w, con w numero di campioni rappresentati da ciascun elemento in cache.
+   if ( !mSamples.empty() )
+   {
+      Weight= static_cast<RealType>(mCount) / static_cast<RealType>( mSamples.size() );
+      for (i= 0; i < mSamples.size(); i++)
+      {
+         Pool.push_back( PoolItem(std::log( Unif() ) / Weight, std::make_pair(false, i)) );
+      }
+   }
+
+   Weight= static_cast<RealType>(rOther.mCount) / static_cast<RealType>( rOther.mSamples.size() );
+   for (i= 0; i < rOther.mSamples.size(); i++)
    {
-      // In questo caso scarto il campione da scartare.
-      i= boost::numeric::converter<BoostRealSymmMatrix::size_type, SampleSizeType>
-         ::convert(mDiscardIndex);
+      Pool.push_back( PoolItem(std::log( Unif() ) / Weight, std::make_pair(true, i)) );
+   }
 
-      mSamples[mDiscardIndex]= rSample;
+   // Tengo le M chiavi più alte.
+   j= boost::numeric::converter<MatrixSizeType, NaturalType>::convert(mM);
+   if (Pool.size() > j)
+   {
+      std::partial_sort(
+               Pool.begin(),
+               Pool.begin() + j,
+               Pool.end(),
+               std::greater<PoolItem>() );
 
-      Pit= mSamples.begin();
-      Sit= mSods.begin();
-      Sod= 0;
+      Pool.resize(j);
+   }
 
-      for(j= 0; j < mDissMatrix.size2(); ++j)
+   // Ricostruisco cache, matrice e SOD, riusando le distanze interne a ciascuna cache.
+   Samples.reserve( mSamples.capacity() );
+   mSods.assign(Pool.size(), 0);
+   for (i= 0; i < Pool.size(); i++)
+   {
+      const MinSod&  Src_i= Pool[i].second.first ? rOther : *this;
+
+      Samples.push_back( Src_i.mSamples[ Pool[i].second.second ] );
+      for (j= 0; j < i; j++)
       {
-         if (i != j)
+         if (Pool[i].second.first == Pool[j].second.first)
          {
-            Temp= std::pow(mDissAgent.Diss(*Pit++, mSamples[mDiscardIndex]), mP);
+            Temp= Src_i.CachedDiss(Pool[i].second.second, Pool[j].second.second);
          }
          else
          {
-            Temp= 0;
-            Pit++;
+            Temp= mDissAgent.Diss(Samples[j], Samples[i]);
+            ApplyPower(&Temp, &Temp + 1);
          }
 
-         (*Sit++)+= ( Temp - mDissMatrix(i, j) );
-         Sod+= Temp;
-         mDissMatrix(i, j)= Temp;
+         Matrix[ Packed(i, j) ]= Temp;
+         mSods[i]+= Temp;
+         mSods[j]+= Temp;
       }
 
-      mSods[ boost::numeric::converter<std::vector<RealType>::size_type, SampleSizeType>
-             ::convert(mDiscardIndex) ]= Sod;
+      Matrix[ Packed(i, i) ]= 0;
+   }
+
+   mSamples.swap(Samples);
+   mDissMatrix.swap(Matrix);
+   mCount+= rOther.mCount;
+
+   UpdateIndices();
+}  // Merge
+
+//==================================== ACCESS ==============================================
 
+template <typename SampleType, typename Dissimilarity>
+BoostRealSymmMatrix
+MinSod<SampleType, Dissimilarity>::DissimilarityMatrix() const
+{
+   // Variabili.
+   SampleSizeType       M_= boost::numeric::converter<SampleSizeType, NaturalType>::convert(mM);
+   BoostRealSymmMatrix  Matrix(M_, M_);
+
+   for (SampleSizeType i= 0; i < M_; i++)
+   {
+      for (SampleSizeType j= 0; j <= i; j++)
+      {
+         Matrix(i, j)= mDissMatrix[ Packed(i, j) ];
+      }
    }
 
-   // Aggiorno  MinSodIndex.
-   Sit= std::min_element(
-           mSods.begin(),
-           mSods.end() );
+   return Matrix;
+}  // DissimilarityMatrix
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
 
-   mMinSodIndex= boost::numeric::converter<SampleSizeType, SodDiffType>::convert(
-                                                                         std::distance(
-                                                                            mSods.begin(),
-                                                                            Sit) );
+// Aggiornamento degli indici.
+template <typename SampleType, typename Dissimilarity>
+void
+MinSod<SampleType, Dissimilarity>::UpdateIndices()
+{
+   // Variabili.
+   const RealType*      Sods= &mSods[0];
+   SampleSizeType       Size= mSods.size();
+   SampleSizeType       MinIdx= 0;
+   SampleSizeType       MaxIdx= 0;
+   RealType             MinVal= Sods[0];
+   RealType             MaxVal= Sods[0];
+   SampleSizeType       i;
+   SampleSizeType       j;
+   SampleSizeType       k;
+
+   // Aggiorno MinSodIndex e MaxSodIndex in un'unica passata (primo minimo e primo massimo,
+   // come min_element e max_element).
+   for (i= 1; i < Size; i++)
+   {
+      if (Sods[i] < MinVal)
+      {
+         MinVal= Sods[i];
+         MinIdx= i;
+      }
 
-   //update the max sod
-   S2it=std::max_element(mSods.begin(), mSods.end());
+      if (Sods[i] > MaxVal)
+      {
+         MaxVal= Sods[i];
+         MaxIdx= i;
+      }
+   }
 
-   mMaxSodIndex=boost::numeric::converter<SampleSizeType, SodDiffType>::convert(std::distance(mSods.begin(), S2it));
+   mMinSodIndex= MinIdx;
+   mMaxSodIndex= MaxIdx;
 
    // Aggiorno  WorstIndex, il peggiore &egrave; il pi&ugrave; distante dal rappresentante tra due scelti
    // a caso.
-   k= boost::numeric::converter<BoostRealSymmMatrix::size_type, SampleSizeType>
-      ::convert(mMinSodIndex);
+   k= mMinSodIndex;
 
-   BoostRealSymmMatrix::size_type sampleSize=boost::numeric::converter<BoostRealSymmMatrix::size_type, SampleSizeType>
-         ::convert( mSamples.size() );
-
-   i= mSampleDist(mRng)%sampleSize;
-   j= mSampleDist(mRng)%sampleSize;
+   i= mSampleDist(mRng)%Size;
+   j= mSampleDist(mRng)%Size;
 
    if(i==k&&j==k)
-       i=(k+1)%sampleSize;
+       i=(k+1)%Size;
 
-   if ( mDissMatrix(k, j) > mDissMatrix(k, i) )
+   if ( CachedDiss(k, j) > CachedDiss(k, i) )
    {
       i= j;
    }
 
-   mDiscardIndex= boost::numeric::converter<SampleSizeType, BoostRealSymmMatrix::size_type>
-                  ::convert(i);
+   mDiscardIndex= i;
+}  // UpdateIndices
 
-   mCount++;
-}  // Update
+// Elevamento a potenza.
+template <typename SampleType, typename Dissimilarity>
+void
+MinSod<SampleType, Dissimilarity>::ApplyPower(RealType* aFirst, RealType* aLast) const
+{
+   // Variabili.
+   RealType*            It;
 
-////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+   if (mP == 1)
+   {
+      return;
+   }
+
+   if (mP == 2)
+   {
+      for (It= aFirst; It != aLast; ++It)
+      {
+         (*It)*= (*It);
+      }
+   }
+   else
+   {
+      for (It= aFirst; It != aLast; ++It)
+      {
+         *It= std::pow(*It, mP);
+      }
+   }
+}  // ApplyPower
+
+// Inserimento nella cache.
+template <typename SampleType, typename Dissimilarity>
+typename MinSod<SampleType, Dissimilarity>::SampleSizeType
+MinSod<SampleType, Dissimilarity>::Place(const SampleType& rSample)
+{
+   // Variabili.
+   SampleSizeType       i;
+
+   if ( mSamples.size() < boost::numeric::converter<SampleSizeType, NaturalType>
+                          ::convert(mM) )
+   {
+      // In questo caso accresco l'insieme dei campioni immagazzinati,
+      // senza scartare nessuno.
+
+      // Aggiungo campione.
+      mSamples.push_back(rSample);
+      mSods.push_back(0);
+      i= mSamples.size() - 1;
+
+      // La riga nuova non ha ancora contributi da togliere alle SOD.
+      std::fill(
+         mDissMatrix.begin() + Packed(i, 0),
+         mDissMatrix.begin() + Packed(i + 1, 0),
+         0);
+   }
+   else
+   {
+      // In questo caso sostituisco il campione da scartare.
+      i= mDiscardIndex;
+      mSamples[i]= rSample;
+   }
+
+   return i;
+}  // Place
+
+// Memorizzazione della riga i.
+template <typename SampleType, typename Dissimilarity>
+void
+MinSod<SampleType, Dissimilarity>::StoreRow(SampleSizeType i, SampleSizeType aSize)
+{
+   // Variabili.
+   RealType*            Row= &mRow[0];
+   RealType*            Sods= &mSods[0];
+   RealType*            Cell= &mDissMatrix[ Packed(i, 0) ];
+   SampleSizeType       Pos;
+   SampleSizeType       j;
+   RealType             Sod= 0;
+
+   ApplyPower(Row, Row + aSize);
+   Row[i]= 0;
+
+   // Parte contigua della riga, j < i.
+   for (j= 0; j < i; j++)
+   {
+      Sods[j]+= Row[j] - Cell[j];
+      Sod+= Row[j];
+      Cell[j]= Row[j];
+   }
+
+   Cell[i]= 0;
+
+   // Parte della colonna i sotto la diagonale, j > i.
+   for (j= i + 1, Pos= Packed(i + 1, i); j < aSize; Pos+= ++j)
+   {
+      Sods[j]+= Row[j] - mDissMatrix[Pos];
+      Sod+= Row[j];
+      mDissMatrix[Pos]= Row[j];
+   }
+
+   Sods[i]= Sod;
+}  // StoreRow
 
 // Funzione Init()
 template <typename SampleType, typename Dissimilarity>
@@ -484,15 +846,17 @@ MinSod<SampleType, Dissimilarity>::Init(NaturalType aM)
 
    // Alloco tutto lo spazio che mi può servire (tecnica subottima), su mSamples e mSods
    // uso reserve, così mSamples.size() mi conta quanti campioni ho dentro. Su mDissMatrix
-   // faccio direttamente resize, perché reserve non c'è...
+   // faccio direttamente resize, azzerando la matrice impaccata.
 
    mSamples.reserve(
       boost::numeric::converter<SampleSizeType, NaturalType>::convert(mM) );
 
    mSods.reserve(M_);
 
-   mDissMatrix.resize(
-      boost::numeric::converter<BoostRealSymmMatrix::size_type, NaturalType>::convert(mM) );
+   mDissMatrix.assign(
+      Packed(boost::numeric::converter<SampleSizeType, NaturalType>::convert(mM), 0), 0 );
+
+   mRow.reserve(M_);
 
    // Solo per non lasciarli non inizializzati...
    mMinSodIndex= 0;
@@ -40,8 +40,11 @@
 #include <boost/random.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/shared_ptr.hpp>
 
 // SPARE INCLUDES
+#include <spare/Executor.hpp>
+#include <spare/Representative/SodRowBlock.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
 
@@ -59,7 +62,10 @@ namespace spare {  // Inclusione in namespace spare.
  * only requiring a dissimilarity measure to be defined. A speed up is adopted, based on
  * the tracking of the SOD-minimizing element within a reduced pool of samples (@a cache).
  * The replacement policy is fully probabilistic, selecting the element to be replaced according to its distance to the MinSOD element.
- * @todo BatchUpdate implementation.
+ * The selection weights are kept in a Fenwick tree, updated incrementally while the MinSOD element does not change, so each
+ * selection costs O(log M).
+ * The dissimilarities of the incoming samples from the cache can be evaluated in parallel on
+ * an Executor (see UpdateParallel and UpdateBatch).
  * @todo Merge implementation.
  * @todo Random choose between SODs of the same score.
  */
@@ -95,7 +101,7 @@ public:
    /** Default constructor.
     */
    PFuzzyMinSod()
-      : mSampleDist( 0, 1 )
+      : mSampleDist( 0, 1 ), mTreeRow( std::numeric_limits<SampleSizeType>::max() )
                                                    { Init(20);
                                                      mP=1;
                                                    }
@@ -105,7 +111,7 @@ public:
     * @param[in] aM Cache size.
     */
    PFuzzyMinSod(NaturalType aM)
-      : mSampleDist( 0, 1 )
+      : mSampleDist( 0, 1 ), mTreeRow( std::numeric_limits<SampleSizeType>::max() )
                                                    { Init(aM);
                                                         mP=1;
                                                    }
@@ -118,6 +124,33 @@ public:
     */
    void                 Update(const SampleType& rSample);
 
+   /** Update of the representative, evaluating the dissimilarities in parallel.
+    *
+    * Same as Update, but the M dissimilarities of the new sample from the cache are evaluated
+    * on the executor (see ExecutorSetup). The Diss method of the dissimilarity agent must be
+    * safe for concurrent calls.
+    *
+    * @param[in] rSample A reference to the new sample.
+    */
+   void                 UpdateParallel(const SampleType& rSample)
+                           {
+                              UpdateBatch(&rSample, &rSample + 1);
+                           }
+
+   /** Update of the representative with a range of samples.
+    *
+    * The result is the same as calling Update on each sample in order. The samples are taken
+    * in blocks of max(1, M/8), whose dissimilarities from the cache and among themselves are
+    * evaluated in parallel on the executor (see ExecutorSetup) before applying the updates
+    * sequentially. The Diss method of the dissimilarity agent must be safe for concurrent
+    * calls.
+    *
+    * @param[in] aFirst Iterator pointing to the first sample.
+    * @param[in] aLast Iterator pointing to the first position after the last sample.
+    */
+   template <typename ForwardIterator>
+   void                 UpdateBatch(ForwardIterator aFirst, ForwardIterator aLast);
+
    /** Dissimilarity evaluation between sample and representative.
     *
     * @param[in] rSample Reference to the sample.
@@ -272,6 +305,31 @@ public:
                               mRng.seed(aSeed);
                            }
 
+   /** Setup of the executor used by UpdateParallel and UpdateBatch.
+    *
+    * @param[in] pExecutor Shared pointer to the executor.
+    */
+   void                 ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor)
+                                                   { mExecutor= pExecutor; }
+
+   /** Read access to the executor used by UpdateParallel and UpdateBatch.
+    *
+    * If no executor has been set up, the process-wide one (see Executor::Shared) is used, so
+    * that the representatives of a clustering share the same threads.
+    *
+    * @return A shared pointer to the executor.
+    */
+   const boost::shared_ptr<Executor>&
+                        GetExecutor() const
+                           {
+                              if (!mExecutor)
+                              {
+                                 return Executor::Shared();
+                              }
+
+                              return mExecutor;
+                           }
+
 private:
 
    // Potenza da applicare alle distanze
@@ -295,6 +353,17 @@ private:
    // Matrice dissimilarità.
    BoostRealSymmMatrix   mDissMatrix;
 
+   // Riga di lavoro delle dissimilarità del nuovo campione.
+   SodVector             mRow;
+
+   // Dissimilarità del blocco corrente di UpdateBatch.
+   SodRowBlock<SampleType, Dissimilarity>
+                         mBlock;
+
+   // Executor per UpdateParallel e UpdateBatch.
+   boost::shared_ptr<Executor>
+                         mExecutor;
+
    // Valori SOD relativi ai campioni immagazzinati.
    SodVector             mSods;
 
@@ -313,13 +382,45 @@ private:
                          mRng;
 
    // Distribuzione per estrazione campione.
-   mutable boost::uniform_int<BoostRealSymmMatrix::size_type>
+   mutable boost::uniform_real<RealType>
                          mSampleDist;
    // BOOST RANDOM
 
+   // Pesi di scarto, ovvero la riga della matrice relativa all'elemento MinSod.
+   std::vector<RealType> mWeights;
+
+   // Albero di Fenwick sui pesi di scarto (indici a partire da 1).
+   std::vector<RealType> mTree;
+
+   // Somma dei pesi di scarto.
+   RealType              mTreeTotal;
+
+   // Riga della matrice su cui è costruito l'albero.
+   SampleSizeType        mTreeRow;
+
+   // Ricostruzione dell'albero sulla riga aRow.
+   void                  TreeBuild(SampleSizeType aRow);
+
+   // Aggiornamento del peso in posizione aPos.
+   void                  TreeSet(SampleSizeType aPos, RealType aWeight);
+
+   // Primo elemento la cui somma cumulativa dei pesi supera aThreshold.
+   SampleSizeType        TreeFind(RealType aThreshold) const;
+
    // Inizializzazione, richiamata dai costruttori.
    void                  Init(NaturalType aM);
 
+   // Inserimento del campione nella cache, restituisce lo slot occupato; rNew indica se la
+   // cache è cresciuta.
+   SampleSizeType        Place(const SampleType& rSample, bool& rNew);
+
+   // Memorizzazione della riga i della matrice da mRow e aggiornamento delle SOD.
+   void                  StoreRow(SampleSizeType i, bool aNew);
+
+   // Aggiornamento dell'indice MinSod, delle membership e dell'indice di scarto; se la
+   // selezione non trova un candidato lo scarto resta su aSlot, lo slot appena scritto.
+   void                  UpdateIndices(SampleSizeType aSlot);
+
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
 
@@ -358,6 +459,9 @@ private:
       ar & mSods;
       ar & mMinSodIndex;
       ar & mDiscardIndex;
+
+      // I pesi di scarto non sono archiviati: l'albero va ricostruito.
+      mTreeRow= std::numeric_limits<SampleSizeType>::max();
    }  // BOOST SERIALIZATION
 
 }; // class MinSod
@@ -372,85 +476,144 @@ template <typename SampleType, typename Dissimilarity, typename Evaluator>
 void
 PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::Update(const SampleType& rSample)
 {
-    // Typedef locali.
-    typedef std::iterator_traits<std::vector<RealType>::const_iterator>::difference_type
-                        SodDiffType;
+   // Variabili.
+   SampleSizeType       i;
+   SampleSizeType       j;
+   bool                 New;
 
-    // Variabili.
-    typename std::vector<SampleType>::const_iterator   Pit;
-    std::vector<RealType>::iterator                    Sit;
-    BoostRealSymmMatrix::size_type                     i;
-    BoostRealSymmMatrix::size_type                     j;
-    BoostRealSymmMatrix::size_type                     k;
-    RealType                                           Sod;
-    RealType                                           Temp;
+   i= Place(rSample, New);
 
+   // Calcolo distanze del nuovo campione dagli altri.
+   mRow.resize( mSamples.size() );
+   for (j= 0; j < mSamples.size(); j++)
+   {
+      mRow[j]= (j != i) ? mDissAgent.Diss(mSamples[j], mSamples[i]) : 0;
+   }
 
-    if ( mSamples.size() < boost::numeric::converter<SampleSizeType, NaturalType>
-                          ::convert(mM) )
-    {
+   StoreRow(i, New);
+
+   UpdateIndices(i);
+
+   mCount++;
+}  // Update
+
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+template <typename ForwardIterator>
+void
+PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::UpdateBatch(ForwardIterator aFirst, ForwardIterator aLast)
+{
+   // Variabili.
+   typename SodRowBlock<SampleType, Dissimilarity>::SamplePtrVector
+                        Block;
+   SampleSizeType       M_;
+   SampleSizeType       BlockSize;
+   SampleSizeType       FirstSlot;
+   SampleSizeType       b;
+   SampleSizeType       i;
+   bool                 New;
+
+   M_= boost::numeric::converter<SampleSizeType, NaturalType>::convert(mM);
+   BlockSize= std::max<SampleSizeType>(1, M_ / 8);
+
+   while (aFirst != aLast)
+   {
+      Block.clear();
+      for (; (aFirst != aLast) && (Block.size() < BlockSize); ++aFirst)
+      {
+         Block.push_back( &(*aFirst) );
+      }
+
+      FirstSlot= (mSamples.size() < M_) ? mSamples.size() : mDiscardIndex;
+      mBlock.Evaluate(*GetExecutor(), mDissAgent, mSamples, Block, FirstSlot);
+
+      // Aggiornamenti in sequenza, come in Update.
+      for (b= 0; b < Block.size(); b++)
+      {
+         i= Place(*Block[b], New);
+         mBlock.FillRow( b, i, mSamples.size(), mRow );
+
+         StoreRow(i, New);
+
+         UpdateIndices(i);
+
+         mCount++;
+      }
+   }
+}  // UpdateBatch
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+typename PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::SampleSizeType
+PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::Place(const SampleType& rSample, bool& rNew)
+{
+   // Variabili.
+   SampleSizeType       i;
+
+   rNew= ( mSamples.size() < boost::numeric::converter<SampleSizeType, NaturalType>
+                             ::convert(mM) );
+
+   if (rNew)
+   {
       // In questo caso accresco l'insieme dei campioni immagazzinati,
       // senza scartare nessuno.
-
-      // Aggiungo campione.
       mSamples.push_back(rSample);
       mSods.push_back(0);
       mMembershipValues.push_back(1);
+      i= mSamples.size() - 1;
+   }
+   else
+   {
+      // In questo caso sostituisco il campione da scartare.
+      i= mDiscardIndex;
+      mSamples[i]= rSample;
+   }
 
-      // Calcolo distanze del nuovo campione dai vecchi.
-      Pit= mSamples.begin();
-      Sit= mSods.begin();
-      Sod= 0;
-      i= boost::numeric::converter<BoostRealSymmMatrix::size_type, SampleSizeType>
-         ::convert(mSamples.size() - 1);
+   return i;
+}  // Place
 
-      // Eseguo aggiornamento.
-      for(j= 0; j < i; ++j)
-      {
-         Temp= std::pow(mDissAgent.Diss(*Pit++, mSamples.back()), mP);
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+void
+PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::StoreRow(SampleSizeType i, bool aNew)
+{
+   // Variabili.
+   SampleSizeType       j;
+   RealType             Sod= 0;
+   RealType             Temp;
 
-         (*Sit++)+= Temp;
-         Sod+= Temp;
-         mDissMatrix(i, j)= Temp;
+   for (j= 0; j < mSamples.size(); j++)
+   {
+      if (j == i)
+      {
+         continue;
       }
 
-      (*Sit)= Sod;
-      mDissMatrix(i, i)= 0;
-    }
-    else
-    {
-      // In questo caso scarto il campione da scartare.
-      i= boost::numeric::converter<BoostRealSymmMatrix::size_type, SampleSizeType>
-         ::convert(mDiscardIndex);
+      Temp= std::pow(mRow[j], mP);
 
-      mSamples[mDiscardIndex]= rSample;
+      // Una riga nuova non ha contributi da togliere alle SOD.
+      mSods[j]+= aNew ? Temp : ( Temp - mDissMatrix(i, j) );
+      Sod+= Temp;
+      mDissMatrix(i, j)= Temp;
+   }
 
-      Pit= mSamples.begin();
-      Sit= mSods.begin();
-      Sod= 0;
+   mSods[i]= Sod;
+   mDissMatrix(i, i)= 0;
+}  // StoreRow
 
-      for(j= 0; j < mDissMatrix.size2(); ++j)
-      {
-         if (i != j)
-         {
-            Temp= std::pow(mDissAgent.Diss(*Pit++, mSamples[mDiscardIndex]), mP);
-         }
-         else
-         {
-            Temp= 0;
-            Pit++;
-         }
-
-         (*Sit++)+= ( Temp - mDissMatrix(i, j) );
-         Sod+= Temp;
-         mDissMatrix(i, j)= Temp;
-         //mMembershipValues[j]= mMembershipAgent.Eval(Temp);
-      }
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+void
+PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::UpdateIndices(SampleSizeType aSlot)
+{
+    // Typedef locali.
+    typedef std::iterator_traits<std::vector<RealType>::const_iterator>::difference_type
+                        SodDiffType;
 
-      mSods[ boost::numeric::converter<std::vector<RealType>::size_type, SampleSizeType>
-             ::convert(mDiscardIndex) ]= Sod;
+    // Variabili.
+    std::vector<RealType>::iterator                    Sit;
+    BoostRealSymmMatrix::size_type                     i;
+    BoostRealSymmMatrix::size_type                     k;
 
-    }
+    i= aSlot;
 
     // Aggiorno  MinSodIndex.
     Sit= std::min_element(
@@ -474,21 +637,20 @@ PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::Update(const SampleType& rSa
     BoostRealSymmMatrix::size_type sampleSize=boost::numeric::converter<BoostRealSymmMatrix::size_type, SampleSizeType>
             ::convert( mSamples.size() );
 
-    //compute the replacement probabilities
-    std::vector<RealType> probs;
-    for(unsigned int h=0;h<mSamples.size();h++)
-        probs.push_back((RealType)mDissMatrix(mMinSodIndex, h)/(RealType)mSods[mMinSodIndex]);
+    // Pesi di scarto proporzionali alla distanza dal MinSod: finché il MinSod non cambia è
+    // cambiato solo il peso dello slot appena scritto.
+    if ( (mTreeRow != k) || (aSlot == k) || (mWeights.size() != mSamples.size()) )
+    {
+        TreeBuild(k);
+    }
+    else
+    {
+        TreeSet(aSlot, mDissMatrix(k, aSlot));
+    }
 
-    j=mSampleDist(mRng);
-    RealType sum=0;
-    for(unsigned int h=0;h<mSamples.size();h++)
+    if (mTreeTotal > 0)
     {
-        sum+=probs[h];
-        if(sum>=j)
-        {
-            i=j;
-            break;
-        }
+        i= TreeFind( mSampleDist(mRng) * mTreeTotal );
     }
 
     if(i==k)
@@ -496,11 +658,83 @@ PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::Update(const SampleType& rSa
 
     mDiscardIndex= boost::numeric::converter<SampleSizeType, BoostRealSymmMatrix::size_type>
                   ::convert(i);
+}  // UpdateIndices
 
-    mCount++;
-}  // Update
+// Ricostruzione dell'albero di Fenwick.
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+void
+PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::TreeBuild(SampleSizeType aRow)
+{
+   // Variabili.
+   SampleSizeType       Size= mSamples.size();
+   SampleSizeType       h;
+   SampleSizeType       Parent;
 
-////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+   mWeights.resize(Size);
+   mTree.assign(Size + 1, 0);
+   mTreeTotal= 0;
+   mTreeRow= aRow;
+
+   // Costruzione in O(M): ogni nodo propaga la sua somma al padre.
+   for (h= 1; h <= Size; h++)
+   {
+      mWeights[h - 1]= mDissMatrix(aRow, h - 1);
+      mTree[h]+= mWeights[h - 1];
+      mTreeTotal+= mWeights[h - 1];
+
+      Parent= h + (h & (~h + 1));
+      if (Parent <= Size)
+      {
+         mTree[Parent]+= mTree[h];
+      }
+   }
+}  // TreeBuild
+
+// Aggiornamento di un peso.
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+void
+PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::TreeSet(SampleSizeType aPos, RealType aWeight)
+{
+   // Variabili.
+   RealType             Delta= aWeight - mWeights[aPos];
+   SampleSizeType       h;
+
+   mWeights[aPos]= aWeight;
+   mTreeTotal+= Delta;
+
+   for (h= aPos + 1; h < mTree.size(); h+= h & (~h + 1))
+   {
+      mTree[h]+= Delta;
+   }
+}  // TreeSet
+
+// Ricerca per discesa dell'albero.
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+typename PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::SampleSizeType
+PFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::TreeFind(RealType aThreshold) const
+{
+   // Variabili.
+   SampleSizeType       Pos= 0;
+   SampleSizeType       Step= 1;
+
+   while ( (Step << 1) < mTree.size() )
+   {
+      Step<<= 1;
+   }
+
+   // Pos è il numero di elementi la cui somma cumulativa non supera la soglia.
+   for (; Step; Step>>= 1)
+   {
+      if ( (Pos + Step < mTree.size()) && (mTree[Pos + Step] <= aThreshold) )
+      {
+         Pos+= Step;
+         aThreshold-= mTree[Pos];
+      }
+   }
+
+   // Gli arrotondamenti possono portare oltre l'ultimo elemento.
+   return std::min<SampleSizeType>(Pos, mWeights.size() - 1);
+}  // TreeFind
 
 // Funzione Init()
 template <typename SampleType, typename Dissimilarity, typename Evaluator>
@@ -40,8 +40,11 @@
 #include <boost/random.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/shared_ptr.hpp>
 
 // SPARE INCLUDES
+#include <spare/Executor.hpp>
+#include <spare/Representative/SodRowBlock.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
 
@@ -59,7 +62,8 @@ namespace spare {  // Inclusione in namespace spare.
  * only requiring a dissimilarity measure to be defined. A speed up is adopted, based on
  * the tracking of the SOD-minimizing element within a reduced pool of samples (@a cache).
  * The replacement policy has a deterministic behaviour, discarding the element farthest away from the current representative element.
- * @todo BatchUpdate implementation.
+ * The dissimilarities of the incoming samples from the cache can be evaluated in parallel on
+ * an Executor (see UpdateParallel and UpdateBatch).
  * @todo Merge implementation.
  * @todo Random choose between SODs of the same score.
  */
@@ -112,6 +116,48 @@ public:
     */
    void                 Update(const SampleType& rSample);
 
+   /** Update of the representative, evaluating the dissimilarities in parallel.
+    *
+    * Same as Update, but the M dissimilarities of the new sample from the cache are evaluated
+    * on the executor (see ExecutorSetup). The Diss method of the dissimilarity agent must be
+    * safe for concurrent calls.
+    *
+    * @param[in] rSample A reference to the new sample.
+    */
+   void                 UpdateParallel(const SampleType& rSample)
+                           {
+                              UpdateBatch(&rSample, &rSample + 1);
+                           }
+
+   /** Update of the representative with a range of samples.
+    *
+    * The result is the same as calling Update on each sample in order. The samples are taken
+    * in blocks of max(1, M/8), whose dissimilarities from the cache and among themselves are
+    * evaluated in parallel on the executor (see ExecutorSetup) before applying the updates
+    * sequentially. The Diss method of the dissimilarity agent must be safe for concurrent
+    * calls.
+    *
+    * @param[in] aFirst Iterator pointing to the first sample.
+    * @param[in] aLast Iterator pointing to the first position after the last sample.
+    */
+   template <typename ForwardIterator>
+   void                 UpdateBatch(ForwardIterator aFirst, ForwardIterator aLast);
+
+   /** Update of the representative with a range of samples.
+    *
+    * Same as UpdateBatch: the dissimilarities are evaluated in blocks, and the membership
+    * values, which do not affect the replacement policy, are refreshed once at the end of
+    * the range instead of after each sample.
+    *
+    * @param[in] aFirst Iterator pointing to the first sample.
+    * @param[in] aLast Iterator pointing to the first position after the last sample.
+    */
+   template <typename ForwardIterator>
+   void                 BatchUpdate(ForwardIterator aFirst, ForwardIterator aLast)
+                           {
+                              UpdateBatch(aFirst, aLast);
+                           }
+
    /** Dissimilarity evaluation between sample and representative.
     *
     * @param[in] rSample Reference to the sample.
@@ -265,6 +311,31 @@ public:
                               mRng.seed(aSeed);
                            }
 
+   /** Setup of the executor used by UpdateParallel and UpdateBatch.
+    *
+    * @param[in] pExecutor Shared pointer to the executor.
+    */
+   void                 ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor)
+                                                   { mExecutor= pExecutor; }
+
+   /** Read access to the executor used by UpdateParallel and UpdateBatch.
+    *
+    * If no executor has been set up, the process-wide one (see Executor::Shared) is used, so
+    * that the representatives of a clustering share the same threads.
+    *
+    * @return A shared pointer to the executor.
+    */
+   const boost::shared_ptr<Executor>&
+                        GetExecutor() const
+                           {
+                              if (!mExecutor)
+                              {
+                                 return Executor::Shared();
+                              }
+
+                              return mExecutor;
+                           }
+
 private:
 
    // Potenza da applicare alle distanze
@@ -288,6 +359,17 @@ private:
    // Matrice dissimilarità.
    BoostRealSymmMatrix   mDissMatrix;
 
+   // Riga di lavoro delle dissimilarità del nuovo campione.
+   SodVector             mRow;
+
+   // Dissimilarità del blocco corrente di UpdateBatch.
+   SodRowBlock<SampleType, Dissimilarity>
+                         mBlock;
+
+   // Executor per UpdateParallel e UpdateBatch.
+   boost::shared_ptr<Executor>
+                         mExecutor;
+
    // Valori SOD relativi ai campioni immagazzinati.
    SodVector             mSods;
 
@@ -313,6 +395,21 @@ private:
    // Inizializzazione, richiamata dai costruttori.
    void                  Init(NaturalType aM);
 
+   // Inserimento del campione nella cache, restituisce lo slot occupato; rNew indica se la
+   // cache è cresciuta.
+   SampleSizeType        Place(const SampleType& rSample, bool& rNew);
+
+   // Memorizzazione della riga i della matrice da mRow e aggiornamento delle SOD.
+   void                  StoreRow(SampleSizeType i, bool aNew);
+
+   // Aggiornamento dell'indice MinSod, delle membership (se aMemberships) e dell'indice di
+   // scarto; se la selezione non trova un candidato lo scarto resta su aSlot, lo slot appena
+   // scritto.
+   void                  UpdateIndices(SampleSizeType aSlot, bool aMemberships);
+
+   // Aggiornamento delle membership rispetto all'elemento MinSod.
+   void                  UpdateMemberships();
+
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
 
@@ -365,85 +462,150 @@ template <typename SampleType, typename Dissimilarity, typename Evaluator>
 void
 RFFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::Update(const SampleType& rSample)
 {
-   // Typedef locali.
-   typedef std::iterator_traits<std::vector<RealType>::const_iterator>::difference_type
-                        SodDiffType;
-
    // Variabili.
-   typename std::vector<SampleType>::const_iterator   Pit;
-   std::vector<RealType>::iterator                    Sit;
-   BoostRealSymmMatrix::size_type                     i;
-   BoostRealSymmMatrix::size_type                     j;
-   RealType                                           Sod;
-   RealType                                           Temp;
+   SampleSizeType       i;
+   SampleSizeType       j;
+   bool                 New;
 
+   i= Place(rSample, New);
 
-   if ( mSamples.size() < boost::numeric::converter<SampleSizeType, NaturalType>
-                          ::convert(mM) )
+   // Calcolo distanze del nuovo campione dagli altri.
+   mRow.resize( mSamples.size() );
+   for (j= 0; j < mSamples.size(); j++)
    {
-      // In questo caso accresco l'insieme dei campioni immagazzinati,
-      // senza scartare nessuno.
+      mRow[j]= (j != i) ? mDissAgent.Diss(mSamples[j], mSamples[i]) : 0;
+   }
 
-      // Aggiungo campione.
-      mSamples.push_back(rSample);
-      mSods.push_back(0);
-      mMembershipValues.push_back(1);
+   StoreRow(i, New);
 
-      // Calcolo distanze del nuovo campione dai vecchi.
-      Pit= mSamples.begin();
-      Sit= mSods.begin();
-      Sod= 0;
-      i= boost::numeric::converter<BoostRealSymmMatrix::size_type, SampleSizeType>
-         ::convert(mSamples.size() - 1);
+   UpdateIndices(i, true);
+
+   mCount++;
+}  // Update
 
-      // Eseguo aggiornamento.
-      for(j= 0; j < i; ++j)
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+template <typename ForwardIterator>
+void
+RFFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::UpdateBatch(ForwardIterator aFirst, ForwardIterator aLast)
+{
+   // Variabili.
+   typename SodRowBlock<SampleType, Dissimilarity>::SamplePtrVector
+                        Block;
+   SampleSizeType       M_;
+   SampleSizeType       BlockSize;
+   SampleSizeType       FirstSlot;
+   SampleSizeType       b;
+   SampleSizeType       i;
+   bool                 New;
+
+   M_= boost::numeric::converter<SampleSizeType, NaturalType>::convert(mM);
+   BlockSize= std::max<SampleSizeType>(1, M_ / 8);
+
+   while (aFirst != aLast)
+   {
+      Block.clear();
+      for (; (aFirst != aLast) && (Block.size() < BlockSize); ++aFirst)
       {
-         Temp= std::pow(mDissAgent.Diss(*Pit++, mSamples.back()), mP);
+         Block.push_back( &(*aFirst) );
+      }
+
+      FirstSlot= (mSamples.size() < M_) ? mSamples.size() : mDiscardIndex;
+      mBlock.Evaluate(*GetExecutor(), mDissAgent, mSamples, Block, FirstSlot);
+
+      // Aggiornamenti in sequenza, come in Update.
+      for (b= 0; b < Block.size(); b++)
+      {
+         i= Place(*Block[b], New);
+         mBlock.FillRow( b, i, mSamples.size(), mRow );
+
+         StoreRow(i, New);
 
-         (*Sit++)+= Temp;
-         Sod+= Temp;
-         mDissMatrix(i, j)= Temp;
+         // Le membership non influenzano lo scarto: le aggiorno alla fine.
+         UpdateIndices(i, false);
+
+         mCount++;
       }
+   }
 
-      (*Sit)= Sod;
-      mDissMatrix(i, i)= 0;
+   if ( !mSamples.empty() )
+   {
+      UpdateMemberships();
+   }
+}  // UpdateBatch
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+typename RFFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::SampleSizeType
+RFFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::Place(const SampleType& rSample, bool& rNew)
+{
+   // Variabili.
+   SampleSizeType       i;
+
+   rNew= ( mSamples.size() < boost::numeric::converter<SampleSizeType, NaturalType>
+                             ::convert(mM) );
+
+   if (rNew)
+   {
+      // In questo caso accresco l'insieme dei campioni immagazzinati,
+      // senza scartare nessuno.
+      mSamples.push_back(rSample);
+      mSods.push_back(0);
+      mMembershipValues.push_back(1);
+      i= mSamples.size() - 1;
    }
    else
    {
-      // In questo caso scarto il campione da scartare.
-      i= boost::numeric::converter<BoostRealSymmMatrix::size_type, SampleSizeType>
-         ::convert(mDiscardIndex);
+      // In questo caso sostituisco il campione da scartare.
+      i= mDiscardIndex;
+      mSamples[i]= rSample;
+   }
 
-      mSamples[mDiscardIndex]= rSample;
+   return i;
+}  // Place
 
-      Pit= mSamples.begin();
-      Sit= mSods.begin();
-      Sod= 0;
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+void
+RFFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::StoreRow(SampleSizeType i, bool aNew)
+{
+   // Variabili.
+   SampleSizeType       j;
+   RealType             Sod= 0;
+   RealType             Temp;
 
-      for(j= 0; j < mDissMatrix.size2(); ++j)
+   for (j= 0; j < mSamples.size(); j++)
+   {
+      if (j == i)
       {
-         if (i != j)
-         {
-            Temp= std::pow(mDissAgent.Diss(*Pit++, mSamples[mDiscardIndex]), mP);
-         }
-         else
-         {
-            Temp= 0;
-            Pit++;
-         }
-
-         (*Sit++)+= ( Temp - mDissMatrix(i, j) );
-         Sod+= Temp;
-         mDissMatrix(i, j)= Temp;
-         //mMembershipValues[j]= mMembershipAgent.Eval(Temp);
+         continue;
       }
 
-      mSods[ boost::numeric::converter<std::vector<RealType>::size_type, SampleSizeType>
-             ::convert(mDiscardIndex) ]= Sod;
+      Temp= std::pow(mRow[j], mP);
 
+      // Una riga nuova non ha contributi da togliere alle SOD.
+      mSods[j]+= aNew ? Temp : ( Temp - mDissMatrix(i, j) );
+      Sod+= Temp;
+      mDissMatrix(i, j)= Temp;
    }
 
+   mSods[i]= Sod;
+   mDissMatrix(i, i)= 0;
+}  // StoreRow
+
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+void
+RFFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::UpdateIndices(SampleSizeType aSlot, bool aMemberships)
+{
+   // Typedef locali.
+   typedef std::iterator_traits<std::vector<RealType>::const_iterator>::difference_type
+                        SodDiffType;
+
+   // Variabili.
+   std::vector<RealType>::iterator                    Sit;
+   BoostRealSymmMatrix::size_type                     i;
+
+   i= aSlot;
+
    // Aggiorno  MinSodIndex.
    Sit= std::min_element(
            mSods.begin(),
@@ -454,11 +616,10 @@ RFFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::Update(const SampleType& rS
                                                                             mSods.begin(),
                                                                             Sit) );
 
-   //membership minsod
-   mMembershipValues[mMinSodIndex]= 1.;
-   //update samples mvs
-   for(unsigned int i=0;i<mSamples.size();i++)
-       mMembershipValues[i]= mMembershipAgent.Eval(mDissMatrix(mMinSodIndex, i));
+   if (aMemberships)
+   {
+      UpdateMemberships();
+   }
 
 
 
@@ -474,11 +635,18 @@ RFFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::Update(const SampleType& rS
 
    mDiscardIndex= boost::numeric::converter<SampleSizeType, BoostRealSymmMatrix::size_type>
                   ::convert(i);
+}  // UpdateIndices
 
-   mCount++;
-}  // Update
-
-////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+template <typename SampleType, typename Dissimilarity, typename Evaluator>
+void
+RFFuzzyMinSod<SampleType, Dissimilarity, Evaluator>::UpdateMemberships()
+{
+   //membership minsod
+   mMembershipValues[mMinSodIndex]= 1.;
+   //update samples mvs
+   for(unsigned int i=0;i<mSamples.size();i++)
+       mMembershipValues[i]= mMembershipAgent.Eval(mDissMatrix(mMinSodIndex, i));
+}  // UpdateMemberships
 
 // Funzione Init()
 template <typename SampleType, typename Dissimilarity, typename Evaluator>
@@ -0,0 +1,74 @@
+//  RepresentativeTraits, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File RepresentativeTraits.hpp, containing the optional representative operation traits.
+ *
+ * The file contains the traits declaring which representatives provide the optional
+ * operations used by some clustering schemes: HasMerge and HasMove.
+ *
+ * @file RepresentativeTraits.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _RepresentativeTraits_h_
+#define _RepresentativeTraits_h_
+
+// BOOST INCLUDES
+#include <boost/type_traits/integral_constant.hpp>
+
+namespace spare {  // Inclusione in namespace spare.
+
+// Forward declarations.
+template <typename Dissimilarity, typename StorageType>
+class Centroid;
+
+template <typename SampleType, typename Dissimilarity>
+class MinSod;
+
+/** @brief Merge declaration trait.
+ *
+ * HasMerge<T>::value is true if the representative T provides a Merge(const T&) method,
+ * which adds to the representative the samples accumulated by another one, as if they had been
+ * inserted by Update. Algorithms which accumulate the samples in several partial copies of the
+ * representatives (e.g. the @a Parallel scheme of Kmeans) are enabled only for such types.
+ * User-defined representatives can be declared by specializing the trait.
+ */
+template <typename T>
+struct HasMerge : boost::false_type { };
+
+template <typename Dissimilarity, typename StorageType>
+struct HasMerge< Centroid<Dissimilarity, StorageType> > : boost::true_type { };
+
+template <typename SampleType, typename Dissimilarity>
+struct HasMerge< MinSod<SampleType, Dissimilarity> > : boost::true_type { };
+
+/** @brief Move declaration trait.
+ *
+ * HasMove<T>::value is true if the representative T provides a Move(sample, T&) method, which
+ * removes a previously inserted sample from the representative and inserts it in another one.
+ * Algorithms which update the representatives only with the samples whose cluster has changed
+ * (e.g. the @a Incremental scheme of Kmeans) are enabled only for such types.
+ * User-defined representatives can be declared by specializing the trait.
+ */
+template <typename T>
+struct HasMove : boost::false_type { };
+
+template <typename Dissimilarity, typename StorageType>
+struct HasMove< Centroid<Dissimilarity, StorageType> > : boost::true_type { };
+
+}  // namespace spare
+
+#endif  // _RepresentativeTraits_h_
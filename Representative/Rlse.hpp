@@ -34,6 +34,8 @@
 // BOOST INCLUDES
 #include <boost/numeric/conversion/converter.hpp>
 #include <boost/numeric/ublas/io.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/symmetric.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 
@@ -55,7 +57,8 @@ namespace spare {  // Inclusione in namespace spare.
  * x_{n_2} + b\f$. The coefficients \f$a_0, a_1, ...,a_{n-2}\f$ and \f$b\f$ are incrementally 
  * estimated by the insertion of new points in the representative by the Update method. The 
  * dissimilarity measure is based on the distance of the point from the estimated hyperplane.
- * @todo BatchUpdate implementation.
+ * Several points can be inserted at once by the BatchUpdate method, which performs a block
+ * update equivalent to the sequence of the single updates.
  * @todo Merge implementation.
  */
 class Rlse
@@ -94,6 +97,22 @@ public:
    template <typename SequenceContainer>
    void                 Update(const SequenceContainer& rSample);
 
+   /** Coefficients update with a range of samples.
+    *
+    * The samples are inserted in blocks of up to 64 by the Woodbury identity: for a block of
+    * k samples with inputs X (k rows) and outputs y, the gain is
+    * \f$K = P X^T (\Lambda + X P X^T)^{-1}\f$, with \f$\Lambda = diag(\lambda, \lambda^2, ...,
+    * \lambda^k)\f$, then \f$w \leftarrow w + K (y - X w)\f$ and
+    * \f$P \leftarrow (P - K X P) / \lambda^k\f$. The result equals the sequence of the single
+    * updates, up to rounding, with matrix-matrix products and a single k x k solve per block
+    * in place of k rank-one updates.
+    *
+    * @param[in] aFirst Iterator pointing to the first sample (a container or a boost vector).
+    * @param[in] aLast Iterator pointing to the first position after the last sample.
+    */
+   template <typename ForwardIterator>
+   void                 BatchUpdate(ForwardIterator aFirst, ForwardIterator aLast);
+
    /** Distance between the point passed as argument and the current hyperplane.
     *
     * @param[in] rSample A reference to the boost vector holding the point.
@@ -159,11 +178,19 @@ private:
    mutable BoostRealSymmMatrix
                         mTemp4;
 
+   // Inizializzazione al primo aggiornamento, con ingressi di dimensione aSize.
+   void                 Init(BoostRealVector::size_type aSize);
+
    // Update (rInput ha già l'1 come ultima componente)
    void                 Update(
                            const BoostRealVector& rInput,
                            RealType               aOutput);
 
+   // Update di un blocco (le righe di rInputs hanno già l'1 come ultima componente)
+   void                 BlockUpdate(
+                           const boost::numeric::ublas::matrix<RealType>& rInputs,
+                           const BoostRealVector&                          rOutputs);
+
    // DissOrtho (rInput ha già l'1 come ultima componente)
    RealType             DissOrtho(
                            const BoostRealVector& rInput,
@@ -183,39 +210,47 @@ private:
 //==================================== OPERATIONS ==========================================
 
 inline void
-Rlse::Update(
-         const BoostRealVector& rInput,
-         RealType               aOutput)
+Rlse::Init(BoostRealVector::size_type aSize)
 {
    // Dichiarazioni.
-   RealType             E, D;
    BoostRealSymmMatrix::size_type
                         i, j;
 
-   // Se è il primo aggiornamento faccio inizializzazioni.
-   if (!mCount)
+   mW.resize(aSize);
+   mP.resize(aSize);
+   mTemp1.resize(aSize);
+   mTemp3.resize(aSize);
+   mTemp4.resize(aSize);
+   for (i= 0; i < mP.size1(); ++i)
    {
-      mW.resize(rInput.size());
-      mP.resize(rInput.size());
-      mTemp1.resize(rInput.size());
-      mTemp3.resize(rInput.size());
-      mTemp4.resize(rInput.size());
-      for (i= 0; i < mP.size1(); ++i)
+      mW[i]= 0.;
+      for (j= 0; j <= i; ++j)
       {
-         mW[i]= 0.;
-         for (j= 0; j <= i; ++j)
+         if (i == j)
+         {
+            mP(i, j)= mAlpha;
+         }
+         else
          {
-            if (i == j)
-            {
-               mP(i, j)= mAlpha;
-            }
-            else
-            {
-               mP(i, j)= 0.;
-            }
+            mP(i, j)= 0.;
          }
       }
    }
+}
+
+inline void
+Rlse::Update(
+         const BoostRealVector& rInput,
+         RealType               aOutput)
+{
+   // Dichiarazioni.
+   RealType             E, D;
+
+   // Se è il primo aggiornamento faccio inizializzazioni.
+   if (!mCount)
+   {
+      Init(rInput.size());
+   }
 
    // Aggiorno.
    E= aOutput - inner_prod(mW, rInput);
@@ -339,6 +374,145 @@ Rlse::Update(const SequenceContainer& rSample)
    Update(mTemp2, Y);
 }
 
+inline void
+Rlse::BlockUpdate(
+         const boost::numeric::ublas::matrix<RealType>& rInputs,
+         const BoostRealVector&                          rOutputs)
+{
+   // Typedef locali.
+   typedef boost::numeric::ublas::matrix<RealType>
+                        Matrix;
+   typedef Matrix::size_type
+                        SizeType;
+
+   // Dichiarazioni.
+   SizeType             K= rInputs.size1();
+   SizeType             i, j, c;
+   RealType             Lk, Acc;
+   Matrix               PXt(mP.size1(), K);
+   Matrix               S(K, K);
+   Matrix               G;
+   BoostRealVector      E;
+   boost::numeric::ublas::permutation_matrix<SizeType>
+                        Pm(K);
+
+   // P X^T e S = Lambda + X P X^T.
+   PXt= prod(mP, trans(rInputs));
+   S= prod(rInputs, PXt);
+   Lk= 1.;
+   for (i= 0; i < K; ++i)
+   {
+      Lk*= mLambda;
+      S(i, i)+= Lk;
+   }
+
+   // G = S^-1 X P, da cui il guadagno K = G^T.
+   G= trans(PXt);
+   if ( boost::numeric::ublas::lu_factorize(S, Pm) )
+   {
+      throw SpareLogicError("Rlse, 4, Singular block matrix.");
+   }
+   boost::numeric::ublas::lu_substitute(S, Pm, G);
+
+   // Coefficienti.
+   E= rOutputs - prod(rInputs, mW);
+   mW+= prod(trans(G), E);
+
+   // P, solo triangolo inferiore.
+   for (i= 0; i < mP.size1(); ++i)
+   {
+      for (j= 0; j <= i; ++j)
+      {
+         Acc= 0.;
+         for (c= 0; c < K; ++c)
+         {
+            Acc+= PXt(i, c) * G(c, j);
+         }
+
+         mP(i, j)= (mP(i, j) - Acc) / Lk;
+      }
+   }
+
+   mCount+= boost::numeric::converter<NaturalType, SizeType>::convert(K);
+}
+
+template <typename ForwardIterator>
+void
+Rlse::BatchUpdate(ForwardIterator aFirst, ForwardIterator aLast)
+{
+   // Dichiarazioni.
+   const BoostRealVector::size_type  BlockSize= 64;
+   boost::numeric::ublas::matrix<RealType>
+                                     X;
+   BoostRealVector                   Y;
+   BoostRealVector::size_type        Sz;
+   BoostRealVector::size_type        k;
+   BoostRealVector::size_type        j;
+   ForwardIterator                   It;
+
+   if (aFirst == aLast)
+   {
+      return;
+   }
+
+   Sz= std::distance(aFirst->begin(), aFirst->end());
+
+   #if SPARE_DEBUG
+   if (!mCount)
+   {
+      if (Sz < 2)
+      {
+         throw SpareLogicError("Rlse, 3, Invalid input size.");
+      }
+   }
+   else
+   {
+      if (Sz != mW.size())
+      {
+         throw SpareLogicError("Rlse, 3, Different lenghts.");
+      }
+   }
+   #endif
+
+   if (!mCount)
+   {
+      Init(Sz);
+   }
+
+   while (aFirst != aLast)
+   {
+      // Numero di campioni del blocco.
+      for (k= 0, It= aFirst; (It != aLast) && (k < BlockSize); ++It, ++k)
+      {
+         #if SPARE_DEBUG
+         if (static_cast<BoostRealVector::size_type>(std::distance(It->begin(), It->end())) != Sz)
+         {
+            throw SpareLogicError("Rlse, 3, Different lenghts.");
+         }
+         #endif
+      }
+
+      X.resize(k, Sz, false);
+      Y.resize(k, false);
+
+      // Righe del blocco, con l'1 al posto dell'uscita.
+      for (k= 0; aFirst != It; ++aFirst, ++k)
+      {
+         typename std::iterator_traits<ForwardIterator>::value_type::const_iterator
+                        Sit= aFirst->begin();
+
+         for (j= 0; j + 1 < Sz; ++j)
+         {
+            X(k, j)= *Sit++;
+         }
+         X(k, Sz - 1)= 1.;
+         Y[k]= *Sit;
+      }
+
+      BlockUpdate(X, Y);
+   }
+}
+
 inline RealType
 Rlse::DissOrtho(
        const BoostRealVector& rInput,
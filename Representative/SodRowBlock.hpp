@@ -0,0 +1,289 @@
+//  SodRowBlock class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File SodRowBlock.hpp, containing the SodRowBlock class.
+ *
+ * The file contains the SodRowBlock class, which evaluates in parallel the dissimilarity
+ * rows of a block of samples entering the cache of a SOD-based representative.
+ *
+ * @file SodRowBlock.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _SodRowBlock_h_
+#define _SodRowBlock_h_
+
+// STD INCLUDES
+#include <limits>
+#include <vector>
+
+// BOOST INCLUDES
+#include <boost/bind/bind.hpp>
+
+// SPARE INCLUDES
+#include <spare/Executor.hpp>
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusione in namespace spare.
+
+/** @brief Parallel evaluation of the dissimilarity rows of a block of incoming samples.
+ *
+ * Helper class of the SOD-based representatives (MinSod, FuzzyMinSod, PFuzzyMinSod,
+ * RFFuzzyMinSod). Given the cache of a representative and a block of B incoming samples, the
+ * Evaluate method computes on an Executor the dissimilarities of each incoming sample from
+ * the samples in the cache and from the preceding incoming samples, i.e. every value that the
+ * B sequential updates can ask for. The updates are then applied sequentially by the
+ * representative: for each incoming sample, FillRow builds the row of the dissimilarities
+ * from the current content of the cache slots, taking into account the slots already
+ * overwritten by the block. The values, and the order of the arguments of the Diss method,
+ * are the same as in the sequential updates, hence the results are identical and do not
+ * depend on the number of threads. The Diss method of the dissimilarity agent must be safe
+ * for concurrent calls.
+ */
+template <typename SampleType, typename Dissimilarity>
+class SodRowBlock
+{
+public:
+
+// PUBLIC TYPES
+
+   /** Index type.
+    */
+   typedef Executor::SizeType
+                        SizeType;
+
+   /** Container of pointers to the incoming samples.
+    */
+   typedef std::vector<const SampleType*>
+                        SamplePtrVector;
+
+// OPERATIONS
+
+   /** Parallel evaluation of the dissimilarities of the block.
+    *
+    * @param[in] rExecutor Executor running the evaluations.
+    * @param[in] rDissAgent Dissimilarity agent.
+    * @param[in] rCache Samples in the cache before the block.
+    * @param[in] rIncoming Pointers to the incoming samples, in update order.
+    * @param[in] aFirstSlot Cache slot of the first incoming sample, whose dissimilarity from
+    * the sample being replaced is not needed.
+    */
+   void                 Evaluate(
+                           Executor&                        rExecutor,
+                           const Dissimilarity&             rDissAgent,
+                           const std::vector<SampleType>&   rCache,
+                           const SamplePtrVector&           rIncoming,
+                           SizeType                         aFirstSlot);
+
+   /** Row of the dissimilarities of an incoming sample from the cache.
+    *
+    * The b-th incoming sample is assumed to be stored in the cache slot i, after the
+    * preceding b-1 incoming samples. On exit rRow[j] holds the dissimilarity of the sample in
+    * the slot j from the incoming one, for j in [0, aSize), with rRow[i] = 0.
+    *
+    * @param[in] b Index of the incoming sample in the block.
+    * @param[in] i Cache slot of the incoming sample.
+    * @param[in] aSize Cache size after the insertion.
+    * @param[out] rRow Row of the dissimilarities.
+    */
+   void                 FillRow(
+                           SizeType                b,
+                           SizeType                i,
+                           SizeType                aSize,
+                           std::vector<RealType>&  rRow);
+
+private:
+
+   // Contenuto di uno slot della cache non ancora sovrascritto dal blocco.
+   static SizeType      Cached()                   { return std::numeric_limits<SizeType>::max(); }
+
+   // Dimensione della cache prima del blocco.
+   SizeType             mCacheSize;
+
+   // Slot del primo campione entrante.
+   SizeType             mFirstSlot;
+
+   // Dissimilarità dei campioni entranti dalla cache, per righe.
+   std::vector<RealType>
+                        mCross;
+
+   // Dissimilarità tra campioni entranti, (b, c) con c < b in posizione b*(b-1)/2 + c.
+   std::vector<RealType>
+                        mInner;
+
+   // Campione entrante memorizzato in ciascuno slot, o Cached().
+   std::vector<SizeType>
+                        mOrigin;
+
+   // Valutazione delle righe [aFirst, aLast) di mCross.
+   void                 CrossRange(
+                           const Dissimilarity*             pDissAgent,
+                           const std::vector<SampleType>*   pCache,
+                           const SamplePtrVector*           pIncoming,
+                           SizeType                         aFirst,
+                           SizeType                         aLast);
+
+   // Valutazione delle righe [aFirst, aLast) di mInner.
+   void                 InnerRange(
+                           const Dissimilarity*             pDissAgent,
+                           const SamplePtrVector*           pIncoming,
+                           SizeType                         aFirst,
+                           SizeType                         aLast);
+
+}; // class SodRowBlock
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+////////////////////////////////////// PUBLIC //////////////////////////////////////////////
+
+//==================================== OPERATIONS ==========================================
+
+template <typename SampleType, typename Dissimilarity>
+void
+SodRowBlock<SampleType, Dissimilarity>::Evaluate(
+                                          Executor&                        rExecutor,
+                                          const Dissimilarity&             rDissAgent,
+                                          const std::vector<SampleType>&   rCache,
+                                          const SamplePtrVector&           rIncoming,
+                                          SizeType                         aFirstSlot)
+{
+   using boost::placeholders::_1;
+   using boost::placeholders::_2;
+
+   // Variabili.
+   SizeType             B= rIncoming.size();
+
+   mCacheSize= rCache.size();
+   mFirstSlot= aFirstSlot;
+   mCross.resize(B * mCacheSize);
+   mInner.resize(B * (B - (B ? 1 : 0)) / 2);
+   mOrigin.assign(mCacheSize, Cached());
+
+   // Una valutazione per elemento: il costo di Diss domina su tutto il resto.
+   rExecutor.ParallelFor(
+                0,
+                B * mCacheSize,
+                0,
+                boost::bind(&SodRowBlock::CrossRange, this,
+                            &rDissAgent, &rCache, &rIncoming, _1, _2) );
+
+   rExecutor.ParallelFor(
+                0,
+                mInner.size(),
+                0,
+                boost::bind(&SodRowBlock::InnerRange, this,
+                            &rDissAgent, &rIncoming, _1, _2) );
+}  // Evaluate
+
+template <typename SampleType, typename Dissimilarity>
+void
+SodRowBlock<SampleType, Dissimilarity>::FillRow(
+                                          SizeType                b,
+                                          SizeType                i,
+                                          SizeType                aSize,
+                                          std::vector<RealType>&  rRow)
+{
+   // Variabili.
+   SizeType             j;
+   SizeType             c;
+
+   if (i >= mOrigin.size())
+   {
+      mOrigin.resize(i + 1, Cached());
+   }
+
+   mOrigin[i]= b;
+   rRow.resize(aSize);
+
+   for (j= 0; j < aSize; j++)
+   {
+      c= mOrigin[j];
+      if (j == i)
+      {
+         rRow[j]= 0;
+      }
+      else if (c == Cached())
+      {
+         rRow[j]= mCross[b * mCacheSize + j];
+      }
+      else
+      {
+         rRow[j]= mInner[b * (b - 1) / 2 + c];
+      }
+   }
+}  // FillRow
+
+////////////////////////////////////// PRIVATE /////////////////////////////////////////////
+
+template <typename SampleType, typename Dissimilarity>
+void
+SodRowBlock<SampleType, Dissimilarity>::CrossRange(
+                                          const Dissimilarity*             pDissAgent,
+                                          const std::vector<SampleType>*   pCache,
+                                          const SamplePtrVector*           pIncoming,
+                                          SizeType                         aFirst,
+                                          SizeType                         aLast)
+{
+   // Variabili.
+   SizeType             b;
+   SizeType             j;
+
+   for (SizeType t= aFirst; t < aLast; t++)
+   {
+      b= t / mCacheSize;
+      j= t % mCacheSize;
+
+      // Il campione sostituito dal primo entrante non serve.
+      mCross[t]= ( (b == 0) && (j == mFirstSlot) )
+                 ? 0
+                 : pDissAgent->Diss( (*pCache)[j], *(*pIncoming)[b] );
+   }
+}  // CrossRange
+
+template <typename SampleType, typename Dissimilarity>
+void
+SodRowBlock<SampleType, Dissimilarity>::InnerRange(
+                                          const Dissimilarity*             pDissAgent,
+                                          const SamplePtrVector*           pIncoming,
+                                          SizeType                         aFirst,
+                                          SizeType                         aLast)
+{
+   // Variabili.
+   SizeType             b= 1;
+   SizeType             c= aFirst;
+
+   // Riga della prima posizione.
+   while (c >= b)
+   {
+      c-= b;
+      b++;
+   }
+
+   for (SizeType t= aFirst; t < aLast; t++)
+   {
+      mInner[t]= pDissAgent->Diss( *(*pIncoming)[c], *(*pIncoming)[b] );
+
+      if (++c == b)
+      {
+         c= 0;
+         b++;
+      }
+   }
+}  // InnerRange
+
+}  // namespace spare
+
+#endif  // _SodRowBlock_h_
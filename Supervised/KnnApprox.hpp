@@ -241,15 +241,15 @@ private:
    // Etichette immagazzinate.
    LabelList            mLabels;
 
-   // Set coppie (dissimilarità, etichetta), per uso interno alle funzioni.
-   mutable DissLabelPairSet
-                        mDlSet;
-
-   // Funzione trova vicini.
-   void                 FindNeighbors(const SampleType& rSample) const;
+   // Funzione trova vicini: coppie (dissimilarità, etichetta) dei K vicini in rDlSet.
+   void                 FindNeighbors(
+                           const SampleType&    rSample,
+                           DissLabelPairSet&    rDlSet) const;
 
    // Funzione regressione.
-   void                 DissWeightedRegression(LabelType& rLabel) const;
+   void                 DissWeightedRegression(
+                           const DissLabelPairSet& rDlSet,
+                           LabelType&              rLabel) const;
 
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
@@ -307,8 +307,11 @@ KnnApprox<SampleType, Dissimilarity, LabelType, Evaluator>
       const SampleType& rSample,
       LabelType&        rLabel) const
 {
-   FindNeighbors(rSample);
-   DissWeightedRegression(rLabel);
+   // Variabili.
+   DissLabelPairSet     DlSet;
+
+   FindNeighbors(rSample, DlSet);
+   DissWeightedRegression(DlSet, rLabel);
 }  // Process
 
 template <typename SampleType,typename Dissimilarity,typename LabelType,typename Evaluator>
@@ -340,7 +343,9 @@ KnnApprox<SampleType, Dissimilarity, LabelType, Evaluator>
 template <typename SampleType,typename Dissimilarity,typename LabelType,typename Evaluator>
 void
 KnnApprox<SampleType, Dissimilarity, LabelType, Evaluator>
-::FindNeighbors(const SampleType& rSample) const
+::FindNeighbors(
+      const SampleType& rSample,
+      DissLabelPairSet& rDlSet) const
 {
    // Variabili.
    SampleIterator                Sit;
@@ -355,30 +360,30 @@ KnnApprox<SampleType, Dissimilarity, LabelType, Evaluator>
    }
 
    // Inizializzo.
-   mDlSet.clear();
+   rDlSet.clear();
    Sit= mSamples.begin();
    Lit= mLabels.begin();
    K_= boost::numeric::converter<DissLabelPairSetSizeType, NaturalType>::convert(mK);
 
    // Primo elemento.
    DissBuff= mDissAgent.Diss(rSample, *Sit++);
-   mDlSet.insert( std::make_pair(DissBuff, *Lit++) );
+   rDlSet.insert( std::make_pair(DissBuff, *Lit++) );
 
    // Ciclo principale.
    while (mSamples.end() != Sit)
    {
       DissBuff= mDissAgent.Diss(rSample, *Sit++);
 
-      if (mDlSet.size() < K_)
+      if (rDlSet.size() < K_)
       {
-         mDlSet.insert( std::make_pair(DissBuff, *Lit++) );
+         rDlSet.insert( std::make_pair(DissBuff, *Lit++) );
       }
       else
       {
-         if (mDlSet.rbegin()->first >= DissBuff)
+         if (rDlSet.rbegin()->first >= DissBuff)
          {
-            mDlSet.erase( --mDlSet.end() );
-            mDlSet.insert( std::make_pair(DissBuff, *Lit++) );
+            rDlSet.erase( --rDlSet.end() );
+            rDlSet.insert( std::make_pair(DissBuff, *Lit++) );
          }
          else
          {
@@ -391,7 +396,9 @@ KnnApprox<SampleType, Dissimilarity, LabelType, Evaluator>
 template <typename SampleType,typename Dissimilarity,typename LabelType,typename Evaluator>
 void
 KnnApprox<SampleType, Dissimilarity, LabelType, Evaluator>
-::DissWeightedRegression(LabelType& rLabel) const
+::DissWeightedRegression(
+      const DissLabelPairSet& rDlSet,
+      LabelType&              rLabel) const
 {
    // Variabili.
    DissLabelPairSetIterator     Sit;
@@ -401,8 +408,8 @@ KnnApprox<SampleType, Dissimilarity, LabelType, Evaluator>
 
    Output= 0;
    WeightSum= 0;
-   Sit= mDlSet.begin();
-   while (mDlSet.end() != Sit)
+   Sit= rDlSet.begin();
+   while (rDlSet.end() != Sit)
    {
       Weight= mWeightAgent.Eval(Sit->first);
       Output+= (*Sit++).second * Weight;
@@ -41,6 +41,9 @@
 
 // SPARE INCLUDES
 #include <spare/BoundedParameter.hpp>
+#include <spare/Dissimilarity/BoundedDiss.hpp>
+#include <spare/Dissimilarity/DtwCascade.hpp>
+#include <spare/Dissimilarity/SquaredDiss.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
 #include <spare/SwitchParameter.hpp>
@@ -57,6 +60,11 @@ static const size_t      KNNC_NSVAL_SZ= 2;
  * sample type, label type and dissimilarity measure. The template arguments SampleType and
  * LabelType can be any type provided with the basic operators. The chosen dissimilarity 
  * agent must accept the SampleType as argument to the Diss method.
+ * With a Dtw dissimilarity the stored samples are indexed by a DtwCascade, whose lower bounds
+ * discard most of the samples farther than the current K-th neighbour without evaluating the
+ * Dtw; the envelopes are computed on learning, with the window set at that time.
+ * With a dissimilarity providing SquaredDiss (see HasSquaredDiss) the neighbours are searched
+ * on the squared dissimilarities.
  *
  * <b>Parameter summary</b>
  *  <table class="contents">
@@ -152,6 +160,7 @@ public:
                            {
                               mSamples.push_back(rSample);
                               mLabels.push_back(rLabel);
+                              mCascade.Insert(mDissAgent, rSample);
                            }
 
    /** Learning of a batch of training samples.
@@ -287,6 +296,9 @@ private:
    typedef typename LabelList::const_iterator
                         LabelIterator;
 
+   typedef DtwCascade<Dissimilarity>
+                        Cascade;
+
    // Valore K (numero di vicini usati per l'inferenza).
    NaturalParam         mK;
 
@@ -302,19 +314,22 @@ private:
    // Etichette immagazzinate.
    LabelList            mLabels;
 
-   // Set coppie (dissimilarit&agrave;, etichetta), per uso interno alle funzioni.
-   mutable DissLabelPairSet
-                        mDlSet;
+   // Limiti inferiori per la ricerca dei vicini (solo con Dtw).
+   Cascade              mCascade;
 
-   // Conteggio etichette, per uso interno alle funzioni.
-   mutable LabelCountMap
-                        mLcMap;
+   // Funzione trova vicini: coppie (dissimilarit&agrave;, etichetta) dei K vicini in rDlSet.
+   void                 FindNeighbors(
+                           const SampleType&    rSample,
+                           DissLabelPairSet&    rDlSet) const;
 
-   // Funzione trova vicini.
-   void                 FindNeighbors(const SampleType& rSample) const;
+   // Funzione classificazione: conteggio etichette dei vicini in rLcMap.
+   void                 Classification(
+                           const DissLabelPairSet& rDlSet,
+                           LabelCountMap&          rLcMap,
+                           LabelType&              rLabel) const;
 
-   // Funzione classificazione.
-   void                 Classification(LabelType& rLabel) const;
+   // Ricostruzione dei limiti inferiori sui campioni immagazzinati.
+   void                 BuildCascade();
 
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
@@ -327,6 +342,11 @@ private:
       ar & BOOST_SERIALIZATION_NVP(mDissAgent);
       ar & BOOST_SERIALIZATION_NVP(mSamples);
       ar & BOOST_SERIALIZATION_NVP(mLabels);
+
+      if (Archive::is_loading::value)
+      {
+         BuildCascade();
+      }
    } // BOOST SERIALIZATION
 
 }; // class KnnClass
@@ -354,12 +374,14 @@ KnnClass<SampleType, Dissimilarity, LabelType>::Learn(
    {
       mSamples.clear();
       mLabels.clear();
+      mCascade.Clear();
    }
 
    while (iSampleBegin != iSampleEnd)
    {
       mSamples.push_back(*iSampleBegin++);
       mLabels.push_back(*iLabelBegin++);
+      mCascade.Insert(mDissAgent, mSamples.back());
    }
 }  // Learn
 
@@ -369,8 +391,12 @@ KnnClass<SampleType, Dissimilarity, LabelType>::Process(
                                                     const SampleType& rSample,
                                                     LabelType&        rLabel) const
 {
-   FindNeighbors(rSample);
-   Classification(rLabel);
+   // Variabili.
+   DissLabelPairSet      DlSet;
+   LabelCountMap         LcMap;
+
+   FindNeighbors(rSample, DlSet);
+   Classification(DlSet, LcMap, rLabel);
 }  // Process
 
 template <typename SampleType, typename Dissimilarity, typename LabelType>
@@ -380,25 +406,27 @@ KnnClass<SampleType, Dissimilarity, LabelType>::Process(
                                                     LabelType&        rLabel,
                                                     ExtraInfoStruct&  rExtraInfo) const
 {
+   DissLabelPairSet      DlSet;
+   LabelCountMap         LcMap;
    LabelCountMapIterator Mit;
    NaturalType           WinnerNum, SecondNum;
    LabelType             Winner;
    bool                  First;
 
-   FindNeighbors(rSample);
-   Classification(rLabel);
+   FindNeighbors(rSample, DlSet);
+   Classification(DlSet, LcMap, rLabel);
 
    // Calcolo affidabilità.
-   if (mLcMap.size() == 1)
+   if (LcMap.size() == 1)
    {
       rExtraInfo.Reliability= RealType(1.);
    }
    else
    {
-      Mit= mLcMap.begin();
+      Mit= LcMap.begin();
       WinnerNum= Mit->second;
       Winner= (*Mit++).first;
-      while (mLcMap.end() != Mit)
+      while (LcMap.end() != Mit)
       {
          if (Mit->second > WinnerNum)
          {
@@ -410,9 +438,9 @@ KnnClass<SampleType, Dissimilarity, LabelType>::Process(
             ++Mit;
          }
       }
-      Mit= mLcMap.begin();
+      Mit= LcMap.begin();
       First= true;
-      while (mLcMap.end() != Mit)
+      while (LcMap.end() != Mit)
       {
          if (Mit->first != Winner)
          {
@@ -435,7 +463,7 @@ KnnClass<SampleType, Dissimilarity, LabelType>::Process(
    }
 
    // Calcolo dissimilarità minima.
-   rExtraInfo.MinDiss= mDlSet.begin()->first;
+   rExtraInfo.MinDiss= DlSet.begin()->first;
 
 }  // Process
 
@@ -487,14 +515,18 @@ KnnClass<SampleType, Dissimilarity, LabelType>::Process(
 
 template <typename SampleType, typename Dissimilarity, typename LabelType>
 void
-KnnClass<SampleType, Dissimilarity, LabelType>
-::FindNeighbors(const SampleType& rSample) const
+KnnClass<SampleType, Dissimilarity, LabelType>::FindNeighbors(
+                                 const SampleType&          rSample,
+                                 DissLabelPairSet&          rDlSet) const
 {
    // Variabili.
    SampleIterator                Sit;
    LabelIterator                 Lit;
    RealType                      DissBuff;
    DissLabelPairSetSizeType      K_;
+   typename Cascade::SizeType    i;
+   typename Cascade::Envelope    Query;
+   const RealType                Max= std::numeric_limits<RealType>::max();
 
    // Controllo se ho qualcosa nella base-esempi.
    if ( mSamples.empty() )
@@ -503,42 +535,72 @@ KnnClass<SampleType, Dissimilarity, LabelType>
    }
 
    // Inizializzo.
-   mDlSet.clear();
+   rDlSet.clear();
    Sit= mSamples.begin();
    Lit= mLabels.begin();
    K_= boost::numeric::converter<DissLabelPairSetSizeType, NaturalType>::convert(mK);
+   mCascade.Prepare(mDissAgent, rSample, Query);
 
    // Primo elemento.
-   DissBuff= mDissAgent.Diss(rSample, *Sit++);
-   mDlSet.insert( std::make_pair(DissBuff, *Lit++) );
+   DissBuff= ComparableDiss(mDissAgent, rSample, *Sit++, Max);
+   rDlSet.insert( std::make_pair(DissBuff, *Lit++) );
+   i= 1;
 
    // Ciclo principale.
    while (mSamples.end() != Sit)
    {
-      DissBuff= mDissAgent.Diss(rSample, *Sit++);
-
-      if (mDlSet.size() < K_)
+      if (rDlSet.size() < K_)
       {
-         mDlSet.insert( std::make_pair(DissBuff, *Lit++) );
+         DissBuff= ComparableDiss(mDissAgent, rSample, *Sit++, Max);
+         rDlSet.insert( std::make_pair(DissBuff, *Lit++) );
       }
       else
       {
-         if (mDlSet.rbegin()->first >= DissBuff)
+         // A vicinato completo serve solo sapere se il campione batte il k-esimo.
+         if ( mCascade.Prune(mDissAgent, Query, i, rDlSet.rbegin()->first) )
          {
-            mDlSet.erase( --mDlSet.end() );
-            mDlSet.insert( std::make_pair(DissBuff, *Lit++) );
+            Sit++;
+            Lit++;
          }
          else
          {
-            Lit++;
+            DissBuff= ComparableDiss(mDissAgent, rSample, *Sit++, rDlSet.rbegin()->first);
+
+            if (rDlSet.rbegin()->first >= DissBuff)
+            {
+               rDlSet.erase( --rDlSet.end() );
+               rDlSet.insert( std::make_pair(DissBuff, *Lit++) );
+            }
+            else
+            {
+               Lit++;
+            }
          }
       }
+      ++i;
+   }
+
+   // Dalle dissimilarità comparabili alle dissimilarità.
+   if ( HasSquaredDiss<Dissimilarity>::value )
+   {
+      DissLabelPairSet           Neighbors;
+      DissLabelPairSetIterator   Nit;
+
+      for (Nit= rDlSet.begin(); rDlSet.end() != Nit; ++Nit)
+      {
+         Neighbors.insert(
+            std::make_pair(ComparableToDiss<Dissimilarity>(Nit->first), Nit->second) );
+      }
+      rDlSet.swap(Neighbors);
    }
 }  // FindNeighbors
 
 template <typename SampleType, typename Dissimilarity, typename LabelType>
 void
-KnnClass<SampleType, Dissimilarity, LabelType>::Classification(LabelType& rLabel) const
+KnnClass<SampleType, Dissimilarity, LabelType>::Classification(
+                                 const DissLabelPairSet&    rDlSet,
+                                 LabelCountMap&             rLcMap,
+                                 LabelType&                 rLabel) const
 {
    // Variabili.
    DissLabelPairSetIterator   Sit;
@@ -548,19 +610,19 @@ KnnClass<SampleType, Dissimilarity, LabelType>::Classification(LabelType& rLabel
    LabelType                  Winner;
 
    // Conto numero vicini per le varie classi.
-   mLcMap.clear();
-   Sit= mDlSet.begin();
-   while (mDlSet.end() != Sit)
+   rLcMap.clear();
+   Sit= rDlSet.begin();
+   while (rDlSet.end() != Sit)
    {
-      mLcMap[ (*Sit++).second ]++;
+      rLcMap[ (*Sit++).second ]++;
    }
 
    // Cerco eventuale classe vincitrice.
-   Mit= mLcMap.begin();
+   Mit= rLcMap.begin();
    WinnerNum= Mit->second;
    Winner= (*Mit++).first;
    HaveWinner= true;
-   while (mLcMap.end() != Mit)
+   while (rLcMap.end() != Mit)
    {
       if (Mit->second > WinnerNum)
       {
@@ -589,6 +651,18 @@ KnnClass<SampleType, Dissimilarity, LabelType>::Classification(LabelType& rLabel
    }
 }  // Classification
 
+template <typename SampleType, typename Dissimilarity, typename LabelType>
+void
+KnnClass<SampleType, Dissimilarity, LabelType>::BuildCascade()
+{
+   mCascade.Clear();
+
+   for (SampleIterator Sit= mSamples.begin(); mSamples.end() != Sit; ++Sit)
+   {
+      mCascade.Insert(mDissAgent, *Sit);
+   }
+}  // BuildCascade
+
 }  // namespace spare
 
 #endif  // _KnnClass_h_
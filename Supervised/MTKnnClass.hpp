@@ -32,17 +32,22 @@
 #include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 // BOOST INCLUDES
+#include <boost/bind/bind.hpp>
 #include <boost/numeric/conversion/converter.hpp>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/list.hpp>
 #include <boost/serialization/nvp.hpp>
-#include <boost/thread/thread.hpp>
-#include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
 
 // SPARE INCLUDES
 #include <spare/BoundedParameter.hpp>
+#include <spare/Dissimilarity/BoundedDiss.hpp>
+#include <spare/Dissimilarity/DtwCascade.hpp>
+#include <spare/Dissimilarity/SquaredDiss.hpp>
+#include <spare/Executor.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
 #include <spare/SwitchParameter.hpp>
@@ -50,8 +55,8 @@
 namespace spare {  // Inclusion in namespace spare.
 
 // Data for switch parameter construction.
-static const std::string KNNC_NSVAL[]= {"Off", "On"};
-static const size_t      KNNC_NSVAL_SZ= 2;
+static const std::string MTKNNC_NSVAL[]= {"Off", "On"};
+static const size_t      MTKNNC_NSVAL_SZ= 2;
 
 /** @brief Multi-threaded K-nn classifier.
  *
@@ -60,7 +65,16 @@ static const size_t      KNNC_NSVAL_SZ= 2;
  * LabelType can be any type provided with the basic operators. The chosen dissimilarity 
  * agent must accept the SampleType as argument to the Diss(,) method.
  * Moreover, it is very important that the adopted dissimilarity must be thread-safe.
- * The number of threads is configured via a template argument.
+ * The stored samples are scanned in parallel chunks on an Executor, which can be shared with
+ * other components through the ExecutorSetup method; if none is provided, a private executor
+ * with NThreads threads (0 means the number of hardware threads) is created on first use.
+ * Each chunk keeps its own K nearest neighbors, which are then merged, so that the result does
+ * not depend on the number of threads.
+ * Within a chunk, the samples are evaluated with the bounded Diss (see BoundedDiss) against the
+ * K-th neighbour of the chunk and, with a Dtw dissimilarity, are first screened by the lower
+ * bounds of a DtwCascade, built on learning with the window set at that time. With a
+ * dissimilarity providing SquaredDiss (see HasSquaredDiss) the neighbours are searched on the
+ * squared dissimilarities.
  *
  * <b>Parameter summary</b>
  *  <table class="contents">
@@ -90,7 +104,7 @@ static const size_t      KNNC_NSVAL_SZ= 2;
  * 
  * @todo Add ClearModel method.
  */
-template <typename SampleType, typename Dissimilarity, typename LabelType, NaturalType NThreads>
+template <typename SampleType, typename Dissimilarity, typename LabelType, NaturalType NThreads= 0>
 class MTKnnClass
 {
 public:
@@ -139,13 +153,53 @@ public:
     */
    MTKnnClass()
       : mK( 1, std::numeric_limits<NaturalType>::max() ),
-        mIncremental(KNNC_NSVAL,
-                     KNNC_NSVAL + KNNC_NSVAL_SZ)
+        mIncremental(MTKNNC_NSVAL,
+                     MTKNNC_NSVAL + MTKNNC_NSVAL_SZ)
                                                    { 
                                                       mK= 5;
                                                       mIncremental= "Off"; 
                                                    }
 
+   /** Copy constructor.
+    *
+    * The direct access to the stored samples is rebuilt on the copied containers.
+    *
+    * @param[in] rOther The classifier to be copied.
+    */
+   MTKnnClass(const MTKnnClass& rOther)
+      : mK(rOther.mK),
+        mIncremental(rOther.mIncremental),
+        mDissAgent(rOther.mDissAgent),
+        mSamples(rOther.mSamples),
+        mLabels(rOther.mLabels),
+        mExecutor( boost::atomic_load(&rOther.mExecutor) )
+                                                   { BuildIndex(); }
+
+// OPERATORS
+
+   /** Assignment operator.
+    *
+    * The direct access to the stored samples is rebuilt on the copied containers.
+    *
+    * @param[in] rOther The classifier to be copied.
+    * @return A reference to the current instance.
+    */
+   MTKnnClass&          operator=(const MTKnnClass& rOther)
+                           {
+                              if (this != &rOther)
+                              {
+                                 mK= rOther.mK;
+                                 mIncremental= rOther.mIncremental;
+                                 mDissAgent= rOther.mDissAgent;
+                                 mSamples= rOther.mSamples;
+                                 mLabels= rOther.mLabels;
+                                 mExecutor= boost::atomic_load(&rOther.mExecutor);
+                                 BuildIndex();
+                              }
+
+                              return *this;
+                           }
+
 // OPERATIONS
 
    /** Learning of a single training sample.
@@ -159,6 +213,9 @@ public:
                            {
                               mSamples.push_back(rSample);
                               mLabels.push_back(rLabel);
+                              mSampleIndex.push_back(--mSamples.end());
+                              mLabelIndex.push_back(--mLabels.end());
+                              mCascade.Insert(mDissAgent, rSample);
                            }
 
    /** Learning of a batch of training samples.
@@ -258,6 +315,38 @@ public:
     */
    const Dissimilarity& DissAgent() const          { return mDissAgent; }
 
+   /** Setup of the executor used for the parallel computations.
+    *
+    * The same executor can be shared among several components, bounding the overall number
+    * of threads.
+    *
+    * @param[in] pExecutor Shared pointer to the executor.
+    */
+   void                 ExecutorSetup(const boost::shared_ptr<Executor>& pExecutor)
+                                                   { mExecutor= pExecutor; }
+
+   /** Read access to the executor used for the parallel computations.
+    *
+    * If no executor has been set up, a private one with NThreads threads is created; the
+    * creation is safe when several threads classify with the same instance.
+    *
+    * @return A shared pointer to the executor.
+    */
+   const boost::shared_ptr<Executor>&
+                        GetExecutor() const
+                           {
+                              if ( !boost::atomic_load(&mExecutor) )
+                              {
+                                 boost::shared_ptr<Executor> Empty;
+                                 boost::shared_ptr<Executor> Created( new Executor(NThreads) );
+
+                                 // Se un altro thread ha già creato l'executor, tengo il suo.
+                                 boost::atomic_compare_exchange(&mExecutor, &Empty, Created);
+                              }
+
+                              return mExecutor;
+                           }
+
    /** Read access to the stored samples.
     *
     * @return A const reference to the container of samples.
@@ -294,6 +383,9 @@ private:
    typedef typename LabelList::const_iterator
                         LabelIterator;
 
+   typedef DtwCascade<Dissimilarity>
+                        Cascade;
+
    // Valore K (numero di vicini usati per l'inferenza).
    NaturalParam         mK;
 
@@ -309,29 +401,50 @@ private:
    // Etichette immagazzinate.
    LabelList            mLabels;
 
-   // Set coppie (dissimilarit&agrave;, etichetta), per uso interno alle funzioni.
-   mutable DissLabelPairSet
-                        mDlSet;
-
-   // Conteggio etichette, per uso interno alle funzioni.
-   mutable LabelCountMap
-                        mLcMap;
-
-   //mutex
-   mutable boost::mutex* globalMutex;
-
-   //mutex
-   mutable boost::mutex* itMutex;
-
-   // Funzione trova vicini.
-   void                 FindNeighbors(const SampleType& rSample) const;
-
-   // Funzione classificazione.
-   void                 Classification(LabelType& rLabel) const;
-
-   // funzione privata dei thread
-   void ThreadFunction(const SampleType* sampleTest,
-           SampleIterator* Sit, LabelIterator* Lit, const DissLabelPairSetSizeType& K) const;
+   // Accesso diretto ai campioni immagazzinati, per la suddivisione in blocchi.
+   std::vector<SampleIterator>
+                        mSampleIndex;
+
+   // Accesso diretto alle etichette immagazzinate.
+   std::vector<LabelIterator>
+                        mLabelIndex;
+
+   // Limiti inferiori per la ricerca dei vicini (solo con Dtw), allineati a mSampleIndex.
+   Cascade              mCascade;
+
+   // Executor per il calcolo parallelo.
+   mutable boost::shared_ptr<Executor>
+                        mExecutor;
+
+   // Funzione trova vicini: coppie (dissimilarit&agrave;, etichetta) dei K vicini in rDlSet.
+   void                 FindNeighbors(
+                           const SampleType&    rSample,
+                           DissLabelPairSet&    rDlSet) const;
+
+   // Funzione classificazione: conteggio etichette dei vicini in rLcMap.
+   void                 Classification(
+                           const DissLabelPairSet& rDlSet,
+                           LabelCountMap&          rLcMap,
+                           LabelType&              rLabel) const;
+
+   // Ricerca dei K vicini tra i campioni [aFirst, aLast).
+   DissLabelPairSet     ChunkNeighbors(
+                           const SampleType*          pSample,
+                           const typename Cascade::Envelope*
+                                                      pQuery,
+                           DissLabelPairSetSizeType   aK,
+                           Executor::SizeType         aFirst,
+                           Executor::SizeType         aLast) const;
+
+   // Fusione dei vicini di due blocchi, mantenendo i K più vicini.
+   static DissLabelPairSet
+                        MergeNeighbors(
+                           DissLabelPairSetSizeType   aK,
+                           DissLabelPairSet           aA,
+                           const DissLabelPairSet&    rB);
+
+   // Ricostruzione dell'accesso diretto ai campioni.
+   void                 BuildIndex();
 
    // BOOST SERIALIZATION
    friend class boost::serialization::access;
@@ -344,6 +457,11 @@ private:
       ar & BOOST_SERIALIZATION_NVP(mDissAgent);
       ar & BOOST_SERIALIZATION_NVP(mSamples);
       ar & BOOST_SERIALIZATION_NVP(mLabels);
+
+      if (Archive::is_loading::value)
+      {
+         BuildIndex();
+      }
    } // BOOST SERIALIZATION
 
 }; // class KnnClass
@@ -378,6 +496,8 @@ MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::Learn(
       mSamples.push_back(*iSampleBegin++);
       mLabels.push_back(*iLabelBegin++);
    }
+
+   BuildIndex();
 }  // Learn
 
 template <typename SampleType, typename Dissimilarity, typename LabelType, NaturalType NThreads>
@@ -386,8 +506,12 @@ MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::Process(
                                                     const SampleType& rSample,
                                                     LabelType&        rLabel) const
 {
-   FindNeighbors(rSample);
-   Classification(rLabel);
+   // Variabili.
+   DissLabelPairSet      DlSet;
+   LabelCountMap         LcMap;
+
+   FindNeighbors(rSample, DlSet);
+   Classification(DlSet, LcMap, rLabel);
 }  // Process
 
 template <typename SampleType, typename Dissimilarity, typename LabelType, NaturalType NThreads>
@@ -397,25 +521,27 @@ MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::Process(
                                                     LabelType&        rLabel,
                                                     ExtraInfoStruct&  rExtraInfo) const
 {
+   DissLabelPairSet      DlSet;
+   LabelCountMap         LcMap;
    LabelCountMapIterator Mit;
    NaturalType           WinnerNum, SecondNum;
    LabelType             Winner;
    bool                  First;
 
-   FindNeighbors(rSample);
-   Classification(rLabel);
+   FindNeighbors(rSample, DlSet);
+   Classification(DlSet, LcMap, rLabel);
 
    // Calcolo affidabilità.
-   if (mLcMap.size() == 1)
+   if (LcMap.size() == 1)
    {
       rExtraInfo.Reliability= RealType(1.);
    }
    else
    {
-      Mit= mLcMap.begin();
+      Mit= LcMap.begin();
       WinnerNum= Mit->second;
       Winner= (*Mit++).first;
-      while (mLcMap.end() != Mit)
+      while (LcMap.end() != Mit)
       {
          if (Mit->second > WinnerNum)
          {
@@ -427,9 +553,9 @@ MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::Process(
             ++Mit;
          }
       }
-      Mit= mLcMap.begin();
+      Mit= LcMap.begin();
       First= true;
-      while (mLcMap.end() != Mit)
+      while (LcMap.end() != Mit)
       {
          if (Mit->first != Winner)
          {
@@ -452,7 +578,7 @@ MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::Process(
    }
 
    // Calcolo dissimilarità minima.
-   rExtraInfo.MinDiss= mDlSet.begin()->first;
+   rExtraInfo.MinDiss= DlSet.begin()->first;
 
 }  // Process
 
@@ -505,17 +631,16 @@ MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::Process(
 
 template <typename SampleType, typename Dissimilarity, typename LabelType, NaturalType NThreads>
 void
-MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>
-::FindNeighbors(const SampleType& rSample) const
+MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::FindNeighbors(
+                                 const SampleType&          rSample,
+                                 DissLabelPairSet&          rDlSet) const
 {
+   using boost::placeholders::_1;
+   using boost::placeholders::_2;
+
    // Variabili.
-   SampleIterator                Sit;
-   LabelIterator                 Lit;
-   RealType                      DissBuff;
    DissLabelPairSetSizeType      K_;
-   //threads
-   boost::thread_group threadGroup;
-
+   typename Cascade::Envelope    Query;
 
    // Controllo se ho qualcosa nella base-esempi.
    if ( mSamples.empty() )
@@ -523,85 +648,127 @@ MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>
       throw SpareLogicError("KnnClass, 2, No knowledge.");
    }
 
-   // Inizializzo.
-   mDlSet.clear();
-   Sit= mSamples.begin();
-   Lit= mLabels.begin();
    K_= boost::numeric::converter<DissLabelPairSetSizeType, NaturalType>::convert(mK);
+   mCascade.Prepare(mDissAgent, rSample, Query);
+
+   // Ricerca parallela per blocchi e fusione dei risultati parziali.
+   DissLabelPairSet Neighbors= GetExecutor()->ParallelReduce(
+                                    0,
+                                    mSampleIndex.size(),
+                                    0,
+                                    DissLabelPairSet(),
+                                    boost::bind(&MTKnnClass::ChunkNeighbors,
+                                                this, &rSample, &Query, K_, _1, _2),
+                                    boost::bind(&MTKnnClass::MergeNeighbors, K_, _1, _2) );
+
+   rDlSet.swap(Neighbors);
+
+   // Dalle dissimilarità comparabili alle dissimilarità.
+   if ( HasSquaredDiss<Dissimilarity>::value )
+   {
+      DissLabelPairSet           Converted;
+      DissLabelPairSetIterator   Nit;
+
+      for (Nit= rDlSet.begin(); rDlSet.end() != Nit; ++Nit)
+      {
+         Converted.insert(
+            std::make_pair(ComparableToDiss<Dissimilarity>(Nit->first), Nit->second) );
+      }
+      rDlSet.swap(Converted);
+   }
+}  // FindNeighbors
+
+template <typename SampleType, typename Dissimilarity, typename LabelType, NaturalType NThreads>
+typename MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::DissLabelPairSet
+MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::ChunkNeighbors(
+                                 const SampleType*          pSample,
+                                 const typename Cascade::Envelope*
+                                                            pQuery,
+                                 DissLabelPairSetSizeType   aK,
+                                 Executor::SizeType         aFirst,
+                                 Executor::SizeType         aLast) const
+{
+   DissLabelPairSet     DlSet;
+   RealType             DissBuff;
+   const RealType       Max= std::numeric_limits<RealType>::max();
 
-   // Primo elemento.
-   DissBuff= mDissAgent.Diss(rSample, *Sit++);
-   mDlSet.insert( std::make_pair(DissBuff, *Lit++) );
+   for (Executor::SizeType i= aFirst; i < aLast; i++)
+   {
+      if (DlSet.size() < aK)
+      {
+         DissBuff= ComparableDiss(mDissAgent, *pSample, *mSampleIndex[i], Max);
+         DlSet.insert( std::make_pair(DissBuff, *mLabelIndex[i]) );
+      }
+      else
+      {
+         // A vicinato completo serve solo sapere se il campione batte il k-esimo del blocco.
+         if ( mCascade.Prune(mDissAgent, *pQuery, i, DlSet.rbegin()->first) )
+         {
+            continue;
+         }
 
-   //init mutexes
-   globalMutex=new boost::mutex();
-   itMutex=new boost::mutex();
+         DissBuff= ComparableDiss(mDissAgent, *pSample, *mSampleIndex[i], DlSet.rbegin()->first);
 
-   for(NaturalType i=0;i<NThreads;i++)
-       threadGroup.add_thread(new boost::thread(
-                       boost::bind(&MTKnnClass::ThreadFunction, this, &rSample, &Sit, &Lit, K_)));
+         if (DlSet.rbegin()->first >= DissBuff)
+         {
+            DlSet.insert( std::make_pair(DissBuff, *mLabelIndex[i]) );
+            DlSet.erase( --DlSet.end() );
+         }
+      }
+   }
 
-   threadGroup.join_all();
+   return DlSet;
+}  // ChunkNeighbors
 
-   delete globalMutex;
-   delete itMutex;
+template <typename SampleType, typename Dissimilarity, typename LabelType, NaturalType NThreads>
+typename MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::DissLabelPairSet
+MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::MergeNeighbors(
+                                 DissLabelPairSetSizeType   aK,
+                                 DissLabelPairSet           aA,
+                                 const DissLabelPairSet&    rB)
+{
+   aA.insert( rB.begin(), rB.end() );
 
-}  // FindNeighbors
+   while (aA.size() > aK)
+   {
+      aA.erase( --aA.end() );
+   }
 
+   return aA;
+}  // MergeNeighbors
 
 template <typename SampleType, typename Dissimilarity, typename LabelType, NaturalType NThreads>
-void MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::ThreadFunction(const SampleType* sampleTest,
-        SampleIterator* Sit, LabelIterator* Lit, const DissLabelPairSetSizeType& K) const
+void
+MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::BuildIndex()
 {
-    SampleType sample2;
-    LabelType label2;
-
-    //loop
-    do
-    {
-        //synchronized access to the samples
-        itMutex->lock();
-        if(mSamples.end()==(*Sit))
-        {
-            itMutex->unlock();
-            break;
-        }
-        else
-        {
-            sample2=*(*Sit);
-            label2=*(*Lit);
-
-            (*Lit)++;
-            (*Sit)++;
-        }
-        itMutex->unlock();
-
-        //compute dissimilarity
-        RealType DissBuff= mDissAgent.Diss(*sampleTest, sample2);
-
-        //synchronized update of the computed dissimilarity value
-        globalMutex->lock();
-        if (mDlSet.size() < K)
-        {
-            mDlSet.insert( std::make_pair(DissBuff, label2) );
-        }
-        else
-        {
-            if (mDlSet.rbegin()->first >= DissBuff)
-            {
-                mDlSet.erase( --mDlSet.end() );
-                mDlSet.insert( std::make_pair(DissBuff, label2) );
-            }
-        }
-        globalMutex->unlock();
+   mSampleIndex.clear();
+   mLabelIndex.clear();
+   mSampleIndex.reserve( mSamples.size() );
+   mLabelIndex.reserve( mLabels.size() );
 
-    }while(true);
-}
+   for (SampleIterator Sit= mSamples.begin(); mSamples.end() != Sit; ++Sit)
+   {
+      mSampleIndex.push_back(Sit);
+   }
 
+   for (LabelIterator Lit= mLabels.begin(); mLabels.end() != Lit; ++Lit)
+   {
+      mLabelIndex.push_back(Lit);
+   }
+
+   mCascade.Clear();
+   for (SampleIterator Sit= mSamples.begin(); mSamples.end() != Sit; ++Sit)
+   {
+      mCascade.Insert(mDissAgent, *Sit);
+   }
+}  // BuildIndex
 
 template <typename SampleType, typename Dissimilarity, typename LabelType, NaturalType NThreads>
 void
-MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::Classification(LabelType& rLabel) const
+MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::Classification(
+                                 const DissLabelPairSet&    rDlSet,
+                                 LabelCountMap&             rLcMap,
+                                 LabelType&                 rLabel) const
 {
    // Variabili.
    DissLabelPairSetIterator   Sit;
@@ -611,19 +778,19 @@ MTKnnClass<SampleType, Dissimilarity, LabelType, NThreads>::Classification(Label
    LabelType                  Winner;
 
    // Conto numero vicini per le varie classi.
-   mLcMap.clear();
-   Sit= mDlSet.begin();
-   while (mDlSet.end() != Sit)
+   rLcMap.clear();
+   Sit= rDlSet.begin();
+   while (rDlSet.end() != Sit)
    {
-      mLcMap[ (*Sit++).second ]++;
+      rLcMap[ (*Sit++).second ]++;
    }
 
    // Cerco eventuale classe vincitrice.
-   Mit= mLcMap.begin();
+   Mit= rLcMap.begin();
    WinnerNum= Mit->second;
    Winner= (*Mit++).first;
    HaveWinner= true;
-   while (mLcMap.end() != Mit)
+   while (rLcMap.end() != Mit)
    {
       if (Mit->second > WinnerNum)
       {
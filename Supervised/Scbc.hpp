@@ -36,6 +36,7 @@
 #include <boost/serialization/vector.hpp>
 
 // SPARE INCLUDES
+#include <spare/Clustering/RepIndex/LinearScan.hpp>
 #include <spare/SpareExceptions.hpp>
 #include <spare/SpareTypes.hpp>
 
@@ -47,9 +48,12 @@ namespace spare {  // Inclusion in namespace spare.
  * The training algorithm first performs an unsupervised clustering step, then the input
  * label information is used to evaluate cluster purity and to label clusters based on the
  * prevalent class. In the test stage, patterns are classified by comparison with the stored
- * clusters.
+ * clusters. The optional RepIndex template argument is a class modeling the
+ * @a RepresentativeIndex concept (see LinearScan and PivotTable), used for the search of the
+ * closest cluster representative; it is rebuilt after each learning and after loading.
  */
-template <typename Clustering, typename LabelType>
+template <typename Clustering, typename LabelType,
+          typename RepIndex= LinearScan<typename Clustering::RepVector::value_type> >
 class Scbc
 {
 public:
@@ -174,6 +178,18 @@ public:
     */
    const Clustering&    ClustAgent() const         { return mClustAgent; }
 
+   /** Read/write access to the representative index.
+    *
+    * @return A reference to the representative index.
+    */
+   RepIndex&            Index()                    { return mIndex; }
+
+   /** Read only access to the representative index.
+    *
+    * @return A reference to the representative index.
+    */
+   const RepIndex&      Index() const              { return mIndex; }
+
    /** Read only access to the class count map vector.
     *
     * @return A reference to the class count map vector.
@@ -216,6 +232,9 @@ private:
    // Labels of the internal clustering algorithm
    ClusteringLabelsType mClusteringLabels;
 
+   // Index of the cluster representatives.
+   RepIndex             mIndex;
+
    // Cluster labelling and purity evaluation. The iterators iPartitionBegin and
    // iPartitionEnd delimit the label batch generated by the clustering process, while
    // iSupervisedLabelBegins points to the beginning of the supervised input labels.
@@ -235,6 +254,12 @@ private:
       ar & mClassCounts;
       ar & mLabels;
       ar & mPurities;
+
+      if (Archive::is_loading::value)
+      {
+         mIndex.Clear();
+         mIndex.Rebuild( mClustAgent.GetRepresentatives() );
+      }
    } // BOOST SERIALIZATION
 
 }; // class Scbc
@@ -245,10 +270,10 @@ private:
 
 //==================================== OPERATIONS ==========================================
 
-template <typename Clustering, typename LabelType>
+template <typename Clustering, typename LabelType, typename RepIndex>
 template <typename ForwardIterator1, typename ForwardIterator2>
 void
-Scbc<Clustering, LabelType>::Learn(
+Scbc<Clustering, LabelType, RepIndex>::Learn(
                                ForwardIterator1 iSampleBegin,
                                ForwardIterator1 iSampleEnd,
                                ForwardIterator2 iLabelBegin)
@@ -274,75 +299,58 @@ Scbc<Clustering, LabelType>::Learn(
                 mClusteringLabels.begin(),
                 mClusteringLabels.end(),
                 iLabelBegin);
+
+   mIndex.Clear();
+   mIndex.Rebuild( mClustAgent.GetRepresentatives() );
 }
 
-template <typename Clustering, typename LabelType>
+template <typename Clustering, typename LabelType, typename RepIndex>
 template <typename SampleType>
 void
-Scbc<Clustering, LabelType>::Process(
+Scbc<Clustering, LabelType, RepIndex>::Process(
                                  const SampleType& rSample,
                                  LabelType&        rLabel,
                                  ExtraInfoStruct&  rExtraInfo) const
 {
-   typename Clustering::RepVector::size_type i, Nearest;
-   RealType                                  NearestDiss, CurrDiss;
+   typename Clustering::RepVector::size_type Nearest;
+   RealType                                  NearestDiss;
 
    if (mClustAgent.GetRepresentatives().empty())
    {
       throw SpareLogicError("Scbc, 1, Uninitialized object.");
    }
 
-   Nearest= 0;
-   NearestDiss= mClustAgent.GetRepresentatives()[0].Diss(rSample);
-   for (i= 1; i < mClustAgent.GetRepresentatives().size(); ++i)
-   {
-      CurrDiss= mClustAgent.GetRepresentatives()[i].Diss(rSample);
-      if (CurrDiss < NearestDiss)
-      {
-         NearestDiss= CurrDiss;
-         Nearest= i;
-      }
-   }
+   Nearest= mIndex.Closest(mClustAgent.GetRepresentatives(), rSample, NearestDiss);
 
    rLabel= mLabels[Nearest];
    rExtraInfo.MinDiss= NearestDiss;
    rExtraInfo.Reliability= mPurities[Nearest];
 }
 
-template <typename Clustering, typename LabelType>
+template <typename Clustering, typename LabelType, typename RepIndex>
 template <typename SampleType>
 void
-Scbc<Clustering, LabelType>::Process(
+Scbc<Clustering, LabelType, RepIndex>::Process(
                                  const SampleType& rSample,
                                  LabelType&        rLabel) const
 {
-   typename Clustering::RepVector::size_type i, Nearest;
-   RealType                                  NearestDiss, CurrDiss;
+   typename Clustering::RepVector::size_type Nearest;
+   RealType                                  NearestDiss;
 
    if (mClustAgent.GetRepresentatives().empty())
    {
       throw SpareLogicError("Scbc, 2, Uninitialized object.");
    }
 
-   Nearest= 0;
-   NearestDiss= mClustAgent.GetRepresentatives()[0].Diss(rSample);
-   for (i= 1; i < mClustAgent.GetRepresentatives().size(); ++i)
-   {
-      CurrDiss= mClustAgent.GetRepresentatives()[i].Diss(rSample);
-      if (CurrDiss < NearestDiss)
-      {
-         NearestDiss= CurrDiss;
-         Nearest= i;
-      }
-   }
+   Nearest= mIndex.Closest(mClustAgent.GetRepresentatives(), rSample, NearestDiss);
 
    rLabel= mLabels[Nearest];
 }
 
-template <typename Clustering, typename LabelType>
+template <typename Clustering, typename LabelType, typename RepIndex>
 template <typename ForwardIterator1, typename ForwardIterator2>
 void
-Scbc<Clustering, LabelType>::Process(
+Scbc<Clustering, LabelType, RepIndex>::Process(
                                  ForwardIterator1 iSampleBegin,
                                  ForwardIterator1 iSampleEnd,
                                  ForwardIterator2 iLabelBegin) const
@@ -358,10 +366,10 @@ Scbc<Clustering, LabelType>::Process(
    }
 }  // Process
 
-template <typename Clustering, typename LabelType>
+template <typename Clustering, typename LabelType, typename RepIndex>
 template <typename ForwardIterator1, typename ForwardIterator2, typename ForwardIterator3>
 void
-Scbc<Clustering, LabelType>::Process(
+Scbc<Clustering, LabelType, RepIndex>::Process(
                                  ForwardIterator1 iSampleBegin,
                                  ForwardIterator1 iSampleEnd,
                                  ForwardIterator2 iLabelBegin,
@@ -380,10 +388,10 @@ Scbc<Clustering, LabelType>::Process(
 
 ////////////////////////////////////// PRIVATE /////////////////////////////////////////////
 
-template <typename Clustering, typename LabelType>
+template <typename Clustering, typename LabelType, typename RepIndex>
 template <typename ForwardIterator1, typename ForwardIterator2>
 void
-Scbc<Clustering, LabelType>::ClusterLabelling(
+Scbc<Clustering, LabelType, RepIndex>::ClusterLabelling(
                                           ForwardIterator1 iPartitionBegin,
                                           ForwardIterator1 iPartitionEnd,
                                           ForwardIterator2 iSupervisedLabelBegin)
@@ -0,0 +1,983 @@
+//  VectorKernels class, part of the SPARE library.
+//  Copyright (C) 2026 The SPARE contributors
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/** @brief File VectorKernels.hpp, containing the %VectorKernels class.
+ *
+ * The file contains the %VectorKernels class, a collection of SIMD kernels working on
+ * contiguous real vectors.
+ *
+ * @file VectorKernels.hpp
+ * @author The SPARE contributors
+ */
+
+#ifndef _VectorKernels_h_
+#define _VectorKernels_h_
+
+// STD INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// SPARE INCLUDES
+#include <spare/SpareTypes.hpp>
+
+namespace spare {  // Inclusion in namespace spare.
+
+/** @brief SIMD kernels on contiguous real vectors.
+ *
+ * Static kernels used by the fast paths of the vector representatives and dissimilarities.
+ * The instruction set is chosen at compile time: AVX when __AVX__ is defined (e.g. -mavx or
+ * -march=native), SSE2 when __SSE2__ is defined (always on x86-64), a portable unrolled loop
+ * otherwise. Double and float operands are supported, in any combination; the arithmetic is
+ * always carried out in RealType. The reduction kernels use independent partial sums, hence
+ * results may differ from a sequential loop by rounding; the element-wise kernels (AbsDifference,
+ * MinPlus) give the same result of the scalar expression on every element.
+ * SquaredDistanceColumns evaluates many distances at once, one per SIMD lane, keeping for each
+ * of them the partial sums of SquaredDistance: its results are the same of SquaredDistance.
+ */
+class VectorKernels
+{
+public:
+
+// PUBLIC TYPES
+
+   /** Length type.
+    */
+   typedef std::size_t  SizeType;
+
+// OPERATIONS
+
+   /** Squared euclidean distance between two vectors.
+    *
+    * @param[in] pA Pointer to the first element of the first vector.
+    * @param[in] pB Pointer to the first element of the second vector.
+    * @param[in] aSize Length of the vectors.
+    * @return The sum of the squared differences.
+    */
+   template <typename TypeA, typename TypeB>
+   static RealType      SquaredDistance(
+                           const TypeA*   pA,
+                           const TypeB*   pB,
+                           SizeType       aSize);
+
+   /** Weighted squared euclidean distance between two vectors.
+    *
+    * @param[in] pA Pointer to the first element of the first vector.
+    * @param[in] pB Pointer to the first element of the second vector.
+    * @param[in] pW Pointer to the first element of the weight vector.
+    * @param[in] aSize Length of the vectors.
+    * @return The sum of the squared differences, each multiplied by its weight.
+    */
+   template <typename TypeA, typename TypeB>
+   static RealType      WeightedSquaredDistance(
+                           const TypeA*      pA,
+                           const TypeB*      pB,
+                           const RealType*   pW,
+                           SizeType          aSize);
+
+   /** Manhattan distance between two vectors.
+    *
+    * @param[in] pA Pointer to the first element of the first vector.
+    * @param[in] pB Pointer to the first element of the second vector.
+    * @param[in] aSize Length of the vectors.
+    * @return The sum of the absolute differences.
+    */
+   template <typename TypeA, typename TypeB>
+   static RealType      AbsDistance(
+                           const TypeA*   pA,
+                           const TypeB*   pB,
+                           SizeType       aSize);
+
+   /** Running mean step: pMean[i] += (pSample[i] - pMean[i]) * aWeight.
+    *
+    * With aWeight = 1/n the step inserts the n-th sample, with aWeight = -1/n it removes a
+    * sample from a mean of n+1 samples.
+    *
+    * @param[in,out] pMean Pointer to the first element of the mean vector.
+    * @param[in] pSample Pointer to the first element of the sample.
+    * @param[in] aSize Length of the vectors.
+    * @param[in] aWeight Step weight.
+    */
+   template <typename TypeM, typename TypeS>
+   static void          MeanStep(
+                           TypeM*         pMean,
+                           const TypeS*   pSample,
+                           SizeType       aSize,
+                           RealType       aWeight);
+
+   /** Absolute differences: pOut[i] = |pA[i] - pB[i]|.
+    *
+    * @param[in] pA Pointer to the first element of the first vector.
+    * @param[in] pB Pointer to the first element of the second vector.
+    * @param[out] pOut Pointer to the first element of the output vector.
+    * @param[in] aSize Length of the vectors.
+    */
+   static void          AbsDifference(
+                           const RealType*   pA,
+                           const RealType*   pB,
+                           RealType*         pOut,
+                           SizeType          aSize);
+
+   /** Squared euclidean distances between the columns of two matrices, pairwise.
+    *
+    * The matrices are stored by row, the d-th element of the j-th column of the first matrix
+    * being pA[d*aStrideA + j]; pOut[j] is the squared distance between the j-th columns of
+    * the two matrices, with the same result of SquaredDistance on the columns.
+    *
+    * @param[in] pA Pointer to the first element of the first matrix.
+    * @param[in] aStrideA Distance between the rows of the first matrix.
+    * @param[in] pB Pointer to the first element of the second matrix.
+    * @param[in] aStrideB Distance between the rows of the second matrix.
+    * @param[in] aDim Number of rows.
+    * @param[out] pOut Pointer to the first element of the output vector.
+    * @param[in] aSize Number of columns.
+    */
+   static void          SquaredDistanceColumns(
+                           const RealType*   pA,
+                           SizeType          aStrideA,
+                           const RealType*   pB,
+                           SizeType          aStrideB,
+                           SizeType          aDim,
+                           RealType*         pOut,
+                           SizeType          aSize);
+
+   /** Min-plus step: pOut[i] = pCost[i] + min(pA[i], min(pB[i], pC[i])).
+    *
+    * @param[in] pCost Pointer to the first element of the cost vector.
+    * @param[in] pA Pointer to the first element of the first vector.
+    * @param[in] pB Pointer to the first element of the second vector.
+    * @param[in] pC Pointer to the first element of the third vector.
+    * @param[out] pOut Pointer to the first element of the output vector.
+    * @param[in] aSize Length of the vectors (at least 1).
+    * @return The minimum output element.
+    */
+   static RealType      MinPlus(
+                           const RealType*   pCost,
+                           const RealType*   pA,
+                           const RealType*   pB,
+                           const RealType*   pC,
+                           RealType*         pOut,
+                           SizeType          aSize);
+
+}; // class VectorKernels
+
+/******************************* TEMPLATE IMPLEMENTATION **********************************/
+
+//==================================== OPERATIONS ==========================================
+
+template <typename TypeA, typename TypeB>
+RealType
+VectorKernels::SquaredDistance(
+                  const TypeA*   pA,
+                  const TypeB*   pB,
+                  SizeType       aSize)
+{
+   // Variabili.
+   RealType             D0= 0, D1= 0, D2= 0, D3= 0;
+   RealType             T;
+   SizeType             i= 0;
+
+   // Quattro somme parziali indipendenti.
+   for (; i + 4 <= aSize; i+= 4)
+   {
+      T= static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]);
+      D0+= T * T;
+      T= static_cast<RealType>(pA[i + 1]) - static_cast<RealType>(pB[i + 1]);
+      D1+= T * T;
+      T= static_cast<RealType>(pA[i + 2]) - static_cast<RealType>(pB[i + 2]);
+      D2+= T * T;
+      T= static_cast<RealType>(pA[i + 3]) - static_cast<RealType>(pB[i + 3]);
+      D3+= T * T;
+   }
+
+   for (; i < aSize; i++)
+   {
+      T= static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]);
+      D0+= T * T;
+   }
+
+   return (D0 + D1) + (D2 + D3);
+}  // SquaredDistance
+
+template <typename TypeA, typename TypeB>
+RealType
+VectorKernels::WeightedSquaredDistance(
+                  const TypeA*      pA,
+                  const TypeB*      pB,
+                  const RealType*   pW,
+                  SizeType          aSize)
+{
+   // Variabili.
+   RealType             D0= 0, D1= 0, D2= 0, D3= 0;
+   RealType             T;
+   SizeType             i= 0;
+
+   // Quattro somme parziali indipendenti.
+   for (; i + 4 <= aSize; i+= 4)
+   {
+      T= static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]);
+      D0+= T * T * pW[i];
+      T= static_cast<RealType>(pA[i + 1]) - static_cast<RealType>(pB[i + 1]);
+      D1+= T * T * pW[i + 1];
+      T= static_cast<RealType>(pA[i + 2]) - static_cast<RealType>(pB[i + 2]);
+      D2+= T * T * pW[i + 2];
+      T= static_cast<RealType>(pA[i + 3]) - static_cast<RealType>(pB[i + 3]);
+      D3+= T * T * pW[i + 3];
+   }
+
+   for (; i < aSize; i++)
+   {
+      T= static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]);
+      D0+= T * T * pW[i];
+   }
+
+   return (D0 + D1) + (D2 + D3);
+}  // WeightedSquaredDistance
+
+template <typename TypeA, typename TypeB>
+RealType
+VectorKernels::AbsDistance(
+                  const TypeA*   pA,
+                  const TypeB*   pB,
+                  SizeType       aSize)
+{
+   // Variabili.
+   RealType             D0= 0, D1= 0, D2= 0, D3= 0;
+   SizeType             i= 0;
+
+   // Quattro somme parziali indipendenti.
+   for (; i + 4 <= aSize; i+= 4)
+   {
+      D0+= std::abs( static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]) );
+      D1+= std::abs( static_cast<RealType>(pA[i + 1]) - static_cast<RealType>(pB[i + 1]) );
+      D2+= std::abs( static_cast<RealType>(pA[i + 2]) - static_cast<RealType>(pB[i + 2]) );
+      D3+= std::abs( static_cast<RealType>(pA[i + 3]) - static_cast<RealType>(pB[i + 3]) );
+   }
+
+   for (; i < aSize; i++)
+   {
+      D0+= std::abs( static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]) );
+   }
+
+   return (D0 + D1) + (D2 + D3);
+}  // AbsDistance
+
+template <typename TypeM, typename TypeS>
+void
+VectorKernels::MeanStep(
+                  TypeM*         pMean,
+                  const TypeS*   pSample,
+                  SizeType       aSize,
+                  RealType       aWeight)
+{
+   for (SizeType i= 0; i < aSize; i++)
+   {
+      pMean[i]= static_cast<TypeM>(
+                   pMean[i] + ( static_cast<RealType>(pSample[i]) - pMean[i] ) * aWeight );
+   }
+}  // MeanStep
+
+inline void
+VectorKernels::AbsDifference(
+                  const RealType*   pA,
+                  const RealType*   pB,
+                  RealType*         pOut,
+                  SizeType          aSize)
+{
+   SizeType             i= 0;
+
+#if defined(__AVX__)
+   const __m256d        Sign= _mm256_set1_pd(-0.);
+
+   for (; i + 4 <= aSize; i+= 4)
+   {
+      _mm256_storeu_pd( pOut + i,
+                        _mm256_andnot_pd( Sign, _mm256_sub_pd( _mm256_loadu_pd(pA + i),
+                                                               _mm256_loadu_pd(pB + i) ) ) );
+   }
+#elif defined(__SSE2__)
+   const __m128d        Sign= _mm_set1_pd(-0.);
+
+   for (; i + 2 <= aSize; i+= 2)
+   {
+      _mm_storeu_pd( pOut + i,
+                     _mm_andnot_pd( Sign, _mm_sub_pd( _mm_loadu_pd(pA + i),
+                                                      _mm_loadu_pd(pB + i) ) ) );
+   }
+#endif
+
+   for (; i < aSize; i++)
+   {
+      pOut[i]= std::abs(pA[i] - pB[i]);
+   }
+}  // AbsDifference
+
+inline RealType
+VectorKernels::MinPlus(
+                  const RealType*   pCost,
+                  const RealType*   pA,
+                  const RealType*   pB,
+                  const RealType*   pC,
+                  RealType*         pOut,
+                  SizeType          aSize)
+{
+   // Variabili.
+   RealType             Min= pCost[0] + std::min( pA[0], std::min(pB[0], pC[0]) );
+   SizeType             i= 0;
+
+#if defined(__AVX__)
+   __m256d              V;
+   __m256d              VMin= _mm256_set1_pd(Min);
+   double               Lanes[4];
+
+   for (; i + 4 <= aSize; i+= 4)
+   {
+      V= _mm256_add_pd( _mm256_loadu_pd(pCost + i),
+                        _mm256_min_pd( _mm256_loadu_pd(pA + i),
+                                       _mm256_min_pd( _mm256_loadu_pd(pB + i),
+                                                      _mm256_loadu_pd(pC + i) ) ) );
+      _mm256_storeu_pd(pOut + i, V);
+      VMin= _mm256_min_pd(VMin, V);
+   }
+
+   _mm256_storeu_pd(Lanes, VMin);
+   Min= std::min( std::min(Lanes[0], Lanes[1]), std::min(Lanes[2], Lanes[3]) );
+#elif defined(__SSE2__)
+   __m128d              V;
+   __m128d              VMin= _mm_set1_pd(Min);
+
+   for (; i + 2 <= aSize; i+= 2)
+   {
+      V= _mm_add_pd( _mm_loadu_pd(pCost + i),
+                     _mm_min_pd( _mm_loadu_pd(pA + i),
+                                 _mm_min_pd( _mm_loadu_pd(pB + i), _mm_loadu_pd(pC + i) ) ) );
+      _mm_storeu_pd(pOut + i, V);
+      VMin= _mm_min_pd(VMin, V);
+   }
+
+   Min= std::min( _mm_cvtsd_f64(VMin), _mm_cvtsd_f64( _mm_unpackhi_pd(VMin, VMin) ) );
+#endif
+
+   for (; i < aSize; i++)
+   {
+      pOut[i]= pCost[i] + std::min( pA[i], std::min(pB[i], pC[i]) );
+      Min= std::min(Min, pOut[i]);
+   }
+
+   return Min;
+}  // MinPlus
+
+// Distanza al quadrato tra due colonne, con le somme parziali di SquaredDistance sull'insieme
+// di istruzioni in uso.
+inline RealType
+VectorKernelsSquaredDistanceColumn(
+                  const RealType*   pA,
+                  VectorKernels::SizeType aStrideA,
+                  const RealType*   pB,
+                  VectorKernels::SizeType aStrideB,
+                  VectorKernels::SizeType aDim)
+{
+   // Variabili.
+   RealType             T;
+   VectorKernels::SizeType d= 0;
+   VectorKernels::SizeType k;
+
+#if defined(__AVX__)
+   RealType             P[8]= { 0, 0, 0, 0, 0, 0, 0, 0 };
+   RealType             D;
+
+   for (; d + 8 <= aDim; d+= 8)
+   {
+      for (k= 0; k < 8; k++)
+      {
+         T= pA[(d + k)*aStrideA] - pB[(d + k)*aStrideB];
+         P[k]+= T * T;
+      }
+   }
+
+   if (d + 4 <= aDim)
+   {
+      for (k= 0; k < 4; k++)
+      {
+         T= pA[(d + k)*aStrideA] - pB[(d + k)*aStrideB];
+         P[k]+= T * T;
+      }
+      d+= 4;
+   }
+
+   D= ( (P[0] + P[4]) + (P[2] + P[6]) ) + ( (P[1] + P[5]) + (P[3] + P[7]) );
+#elif defined(__SSE2__)
+   RealType             P[4]= { 0, 0, 0, 0 };
+   RealType             D;
+
+   for (; d + 4 <= aDim; d+= 4)
+   {
+      for (k= 0; k < 4; k++)
+      {
+         T= pA[(d + k)*aStrideA] - pB[(d + k)*aStrideB];
+         P[k]+= T * T;
+      }
+   }
+
+   D= (P[0] + P[2]) + (P[1] + P[3]);
+#else
+   RealType             P[4]= { 0, 0, 0, 0 };
+   RealType&            D= P[0];
+
+   for (; d + 4 <= aDim; d+= 4)
+   {
+      for (k= 0; k < 4; k++)
+      {
+         T= pA[(d + k)*aStrideA] - pB[(d + k)*aStrideB];
+         P[k]+= T * T;
+      }
+   }
+#endif
+
+   // Componenti residue in sequenza.
+   for (; d < aDim; d++)
+   {
+      T= pA[d*aStrideA] - pB[d*aStrideB];
+      D+= T * T;
+   }
+
+#if defined(__AVX__) || defined(__SSE2__)
+   return D;
+#else
+   return (P[0] + P[1]) + (P[2] + P[3]);
+#endif
+}  // VectorKernelsSquaredDistanceColumn
+
+#if defined(__AVX__) || defined(__SSE2__)
+
+// Specializzazioni SIMD per RealType = double.
+
+#if defined(__AVX__)
+
+// Caricamento di 4 elementi convertiti in double.
+inline __m256d
+VectorKernelsLoad4(const double* p)                { return _mm256_loadu_pd(p); }
+
+inline __m256d
+VectorKernelsLoad4(const float* p)                 { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+
+// Somma orizzontale.
+inline double
+VectorKernelsSum(__m256d aV)
+{
+   __m128d              S= _mm_add_pd( _mm256_castpd256_pd128(aV),
+                                       _mm256_extractf128_pd(aV, 1) );
+
+   return _mm_cvtsd_f64( _mm_add_sd( S, _mm_unpackhi_pd(S, S) ) );
+}  // VectorKernelsSum
+
+template <typename TypeA, typename TypeB>
+inline RealType
+VectorKernelsSquaredDistance(
+                  const TypeA*   pA,
+                  const TypeB*   pB,
+                  VectorKernels::SizeType aSize)
+{
+   // Variabili.
+   __m256d              Acc0= _mm256_setzero_pd();
+   __m256d              Acc1= _mm256_setzero_pd();
+   __m256d              T0, T1;
+   RealType             D, T;
+   VectorKernels::SizeType i= 0;
+
+   for (; i + 8 <= aSize; i+= 8)
+   {
+      T0= _mm256_sub_pd( VectorKernelsLoad4(pA + i), VectorKernelsLoad4(pB + i) );
+      T1= _mm256_sub_pd( VectorKernelsLoad4(pA + i + 4), VectorKernelsLoad4(pB + i + 4) );
+      Acc0= _mm256_add_pd( Acc0, _mm256_mul_pd(T0, T0) );
+      Acc1= _mm256_add_pd( Acc1, _mm256_mul_pd(T1, T1) );
+   }
+
+   if (i + 4 <= aSize)
+   {
+      T0= _mm256_sub_pd( VectorKernelsLoad4(pA + i), VectorKernelsLoad4(pB + i) );
+      Acc0= _mm256_add_pd( Acc0, _mm256_mul_pd(T0, T0) );
+      i+= 4;
+   }
+
+   D= VectorKernelsSum( _mm256_add_pd(Acc0, Acc1) );
+
+   for (; i < aSize; i++)
+   {
+      T= static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]);
+      D+= T * T;
+   }
+
+   return D;
+}  // VectorKernelsSquaredDistance
+
+// Accumulo di (A - B)^2 in ciascun elemento, come nelle somme parziali di SquaredDistance.
+inline __m256d
+VectorKernelsSquareAdd(__m256d aAcc, const double* pA, const double* pB)
+{
+   __m256d              T= _mm256_sub_pd( _mm256_loadu_pd(pA), _mm256_loadu_pd(pB) );
+
+   return _mm256_add_pd( aAcc, _mm256_mul_pd(T, T) );
+}  // VectorKernelsSquareAdd
+
+// Distanze al quadrato tra 4 colonne consecutive, una per elemento: gli accumulatori A0-A3 e
+// A4-A7 sono le componenti di Acc0 e Acc1 in VectorKernelsSquaredDistance.
+inline __m256d
+VectorKernelsSquaredDistanceColumns(
+                  const double*  pA,
+                  VectorKernels::SizeType aStrideA,
+                  const double*  pB,
+                  VectorKernels::SizeType aStrideB,
+                  VectorKernels::SizeType aDim)
+{
+   // Variabili.
+   __m256d              A0= _mm256_setzero_pd(), A1= A0, A2= A0, A3= A0;
+   __m256d              A4= A0, A5= A0, A6= A0, A7= A0;
+   __m256d              D;
+   VectorKernels::SizeType d= 0;
+
+   for (; d + 8 <= aDim; d+= 8)
+   {
+      A0= VectorKernelsSquareAdd(A0, pA + d*aStrideA, pB + d*aStrideB);
+      A1= VectorKernelsSquareAdd(A1, pA + (d + 1)*aStrideA, pB + (d + 1)*aStrideB);
+      A2= VectorKernelsSquareAdd(A2, pA + (d + 2)*aStrideA, pB + (d + 2)*aStrideB);
+      A3= VectorKernelsSquareAdd(A3, pA + (d + 3)*aStrideA, pB + (d + 3)*aStrideB);
+      A4= VectorKernelsSquareAdd(A4, pA + (d + 4)*aStrideA, pB + (d + 4)*aStrideB);
+      A5= VectorKernelsSquareAdd(A5, pA + (d + 5)*aStrideA, pB + (d + 5)*aStrideB);
+      A6= VectorKernelsSquareAdd(A6, pA + (d + 6)*aStrideA, pB + (d + 6)*aStrideB);
+      A7= VectorKernelsSquareAdd(A7, pA + (d + 7)*aStrideA, pB + (d + 7)*aStrideB);
+   }
+
+   if (d + 4 <= aDim)
+   {
+      A0= VectorKernelsSquareAdd(A0, pA + d*aStrideA, pB + d*aStrideB);
+      A1= VectorKernelsSquareAdd(A1, pA + (d + 1)*aStrideA, pB + (d + 1)*aStrideB);
+      A2= VectorKernelsSquareAdd(A2, pA + (d + 2)*aStrideA, pB + (d + 2)*aStrideB);
+      A3= VectorKernelsSquareAdd(A3, pA + (d + 3)*aStrideA, pB + (d + 3)*aStrideB);
+      d+= 4;
+   }
+
+   // Somma di Acc0 e Acc1, poi somma orizzontale come in VectorKernelsSum.
+   D= _mm256_add_pd( _mm256_add_pd( _mm256_add_pd(A0, A4), _mm256_add_pd(A2, A6) ),
+                     _mm256_add_pd( _mm256_add_pd(A1, A5), _mm256_add_pd(A3, A7) ) );
+
+   for (; d < aDim; d++)
+   {
+      D= VectorKernelsSquareAdd(D, pA + d*aStrideA, pB + d*aStrideB);
+   }
+
+   return D;
+}  // VectorKernelsSquaredDistanceColumns
+
+template <typename TypeA, typename TypeB>
+inline RealType
+VectorKernelsWeightedSquaredDistance(
+                  const TypeA*      pA,
+                  const TypeB*      pB,
+                  const RealType*   pW,
+                  VectorKernels::SizeType aSize)
+{
+   // Variabili.
+   __m256d              Acc0= _mm256_setzero_pd();
+   __m256d              Acc1= _mm256_setzero_pd();
+   __m256d              T0, T1;
+   RealType             D, T;
+   VectorKernels::SizeType i= 0;
+
+   for (; i + 8 <= aSize; i+= 8)
+   {
+      T0= _mm256_sub_pd( VectorKernelsLoad4(pA + i), VectorKernelsLoad4(pB + i) );
+      T1= _mm256_sub_pd( VectorKernelsLoad4(pA + i + 4), VectorKernelsLoad4(pB + i + 4) );
+      Acc0= _mm256_add_pd( Acc0, _mm256_mul_pd( _mm256_mul_pd(T0, T0),
+                                                _mm256_loadu_pd(pW + i) ) );
+      Acc1= _mm256_add_pd( Acc1, _mm256_mul_pd( _mm256_mul_pd(T1, T1),
+                                                _mm256_loadu_pd(pW + i + 4) ) );
+   }
+
+   if (i + 4 <= aSize)
+   {
+      T0= _mm256_sub_pd( VectorKernelsLoad4(pA + i), VectorKernelsLoad4(pB + i) );
+      Acc0= _mm256_add_pd( Acc0, _mm256_mul_pd( _mm256_mul_pd(T0, T0),
+                                                _mm256_loadu_pd(pW + i) ) );
+      i+= 4;
+   }
+
+   D= VectorKernelsSum( _mm256_add_pd(Acc0, Acc1) );
+
+   for (; i < aSize; i++)
+   {
+      T= static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]);
+      D+= T * T * pW[i];
+   }
+
+   return D;
+}  // VectorKernelsWeightedSquaredDistance
+
+template <typename TypeA, typename TypeB>
+inline RealType
+VectorKernelsAbsDistance(
+                  const TypeA*   pA,
+                  const TypeB*   pB,
+                  VectorKernels::SizeType aSize)
+{
+   // Variabili.
+   const __m256d        Sign= _mm256_set1_pd(-0.);
+   __m256d              Acc0= _mm256_setzero_pd();
+   __m256d              Acc1= _mm256_setzero_pd();
+   RealType             D;
+   VectorKernels::SizeType i= 0;
+
+   for (; i + 8 <= aSize; i+= 8)
+   {
+      Acc0= _mm256_add_pd( Acc0, _mm256_andnot_pd( Sign,
+                           _mm256_sub_pd( VectorKernelsLoad4(pA + i),
+                                          VectorKernelsLoad4(pB + i) ) ) );
+      Acc1= _mm256_add_pd( Acc1, _mm256_andnot_pd( Sign,
+                           _mm256_sub_pd( VectorKernelsLoad4(pA + i + 4),
+                                          VectorKernelsLoad4(pB + i + 4) ) ) );
+   }
+
+   if (i + 4 <= aSize)
+   {
+      Acc0= _mm256_add_pd( Acc0, _mm256_andnot_pd( Sign,
+                           _mm256_sub_pd( VectorKernelsLoad4(pA + i),
+                                          VectorKernelsLoad4(pB + i) ) ) );
+      i+= 4;
+   }
+
+   D= VectorKernelsSum( _mm256_add_pd(Acc0, Acc1) );
+
+   for (; i < aSize; i++)
+   {
+      D+= std::abs( static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]) );
+   }
+
+   return D;
+}  // VectorKernelsAbsDistance
+
+inline void
+VectorKernelsStore4(double* p, __m256d aV)         { _mm256_storeu_pd(p, aV); }
+
+inline void
+VectorKernelsStore4(float* p, __m256d aV)          { _mm_storeu_ps( p, _mm256_cvtpd_ps(aV) ); }
+
+template <typename TypeM, typename TypeS>
+inline void
+VectorKernelsMeanStep(
+                  TypeM*         pMean,
+                  const TypeS*   pSample,
+                  VectorKernels::SizeType aSize,
+                  RealType       aWeight)
+{
+   // Variabili.
+   __m256d              W= _mm256_set1_pd(aWeight);
+   __m256d              M;
+   VectorKernels::SizeType i= 0;
+
+   for (; i + 4 <= aSize; i+= 4)
+   {
+      M= VectorKernelsLoad4(pMean + i);
+      M= _mm256_add_pd( M, _mm256_mul_pd( _mm256_sub_pd(VectorKernelsLoad4(pSample + i), M),
+                                          W ) );
+      VectorKernelsStore4(pMean + i, M);
+   }
+
+   for (; i < aSize; i++)
+   {
+      pMean[i]= static_cast<TypeM>(
+                   pMean[i] + ( static_cast<RealType>(pSample[i]) - pMean[i] ) * aWeight );
+   }
+}  // VectorKernelsMeanStep
+
+#else
+
+// Caricamento di 2 elementi convertiti in double.
+inline __m128d
+VectorKernelsLoad2(const double* p)                { return _mm_loadu_pd(p); }
+
+inline __m128d
+VectorKernelsLoad2(const float* p)
+{
+   return _mm_cvtps_pd( _mm_castsi128_ps( _mm_loadl_epi64(
+                           reinterpret_cast<const __m128i*>(p) ) ) );
+}  // VectorKernelsLoad2
+
+template <typename TypeA, typename TypeB>
+inline RealType
+VectorKernelsSquaredDistance(
+                  const TypeA*   pA,
+                  const TypeB*   pB,
+                  VectorKernels::SizeType aSize)
+{
+   // Variabili.
+   __m128d              Acc0= _mm_setzero_pd();
+   __m128d              Acc1= _mm_setzero_pd();
+   __m128d              T0, T1;
+   RealType             D, T;
+   VectorKernels::SizeType i= 0;
+
+   for (; i + 4 <= aSize; i+= 4)
+   {
+      T0= _mm_sub_pd( VectorKernelsLoad2(pA + i), VectorKernelsLoad2(pB + i) );
+      T1= _mm_sub_pd( VectorKernelsLoad2(pA + i + 2), VectorKernelsLoad2(pB + i + 2) );
+      Acc0= _mm_add_pd( Acc0, _mm_mul_pd(T0, T0) );
+      Acc1= _mm_add_pd( Acc1, _mm_mul_pd(T1, T1) );
+   }
+
+   Acc0= _mm_add_pd(Acc0, Acc1);
+   D= _mm_cvtsd_f64( _mm_add_sd( Acc0, _mm_unpackhi_pd(Acc0, Acc0) ) );
+
+   for (; i < aSize; i++)
+   {
+      T= static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]);
+      D+= T * T;
+   }
+
+   return D;
+}  // VectorKernelsSquaredDistance
+
+// Accumulo di (A - B)^2 in ciascun elemento, come nelle somme parziali di SquaredDistance.
+inline __m128d
+VectorKernelsSquareAdd(__m128d aAcc, const double* pA, const double* pB)
+{
+   __m128d              T= _mm_sub_pd( _mm_loadu_pd(pA), _mm_loadu_pd(pB) );
+
+   return _mm_add_pd( aAcc, _mm_mul_pd(T, T) );
+}  // VectorKernelsSquareAdd
+
+// Distanze al quadrato tra 2 colonne consecutive, una per elemento: gli accumulatori A0-A1 e
+// A2-A3 sono le componenti di Acc0 e Acc1 in VectorKernelsSquaredDistance.
+inline __m128d
+VectorKernelsSquaredDistanceColumns(
+                  const double*  pA,
+                  VectorKernels::SizeType aStrideA,
+                  const double*  pB,
+                  VectorKernels::SizeType aStrideB,
+                  VectorKernels::SizeType aDim)
+{
+   // Variabili.
+   __m128d              A0= _mm_setzero_pd(), A1= A0, A2= A0, A3= A0;
+   __m128d              D;
+   VectorKernels::SizeType d= 0;
+
+   for (; d + 4 <= aDim; d+= 4)
+   {
+      A0= VectorKernelsSquareAdd(A0, pA + d*aStrideA, pB + d*aStrideB);
+      A1= VectorKernelsSquareAdd(A1, pA + (d + 1)*aStrideA, pB + (d + 1)*aStrideB);
+      A2= VectorKernelsSquareAdd(A2, pA + (d + 2)*aStrideA, pB + (d + 2)*aStrideB);
+      A3= VectorKernelsSquareAdd(A3, pA + (d + 3)*aStrideA, pB + (d + 3)*aStrideB);
+   }
+
+   D= _mm_add_pd( _mm_add_pd(A0, A2), _mm_add_pd(A1, A3) );
+
+   for (; d < aDim; d++)
+   {
+      D= VectorKernelsSquareAdd(D, pA + d*aStrideA, pB + d*aStrideB);
+   }
+
+   return D;
+}  // VectorKernelsSquaredDistanceColumns
+
+template <typename TypeA, typename TypeB>
+inline RealType
+VectorKernelsWeightedSquaredDistance(
+                  const TypeA*      pA,
+                  const TypeB*      pB,
+                  const RealType*   pW,
+                  VectorKernels::SizeType aSize)
+{
+   // Variabili.
+   __m128d              Acc0= _mm_setzero_pd();
+   __m128d              Acc1= _mm_setzero_pd();
+   __m128d              T0, T1;
+   RealType             D, T;
+   VectorKernels::SizeType i= 0;
+
+   for (; i + 4 <= aSize; i+= 4)
+   {
+      T0= _mm_sub_pd( VectorKernelsLoad2(pA + i), VectorKernelsLoad2(pB + i) );
+      T1= _mm_sub_pd( VectorKernelsLoad2(pA + i + 2), VectorKernelsLoad2(pB + i + 2) );
+      Acc0= _mm_add_pd( Acc0, _mm_mul_pd( _mm_mul_pd(T0, T0), _mm_loadu_pd(pW + i) ) );
+      Acc1= _mm_add_pd( Acc1, _mm_mul_pd( _mm_mul_pd(T1, T1), _mm_loadu_pd(pW + i + 2) ) );
+   }
+
+   Acc0= _mm_add_pd(Acc0, Acc1);
+   D= _mm_cvtsd_f64( _mm_add_sd( Acc0, _mm_unpackhi_pd(Acc0, Acc0) ) );
+
+   for (; i < aSize; i++)
+   {
+      T= static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]);
+      D+= T * T * pW[i];
+   }
+
+   return D;
+}  // VectorKernelsWeightedSquaredDistance
+
+template <typename TypeA, typename TypeB>
+inline RealType
+VectorKernelsAbsDistance(
+                  const TypeA*   pA,
+                  const TypeB*   pB,
+                  VectorKernels::SizeType aSize)
+{
+   // Variabili.
+   const __m128d        Sign= _mm_set1_pd(-0.);
+   __m128d              Acc0= _mm_setzero_pd();
+   __m128d              Acc1= _mm_setzero_pd();
+   RealType             D;
+   VectorKernels::SizeType i= 0;
+
+   for (; i + 4 <= aSize; i+= 4)
+   {
+      Acc0= _mm_add_pd( Acc0, _mm_andnot_pd( Sign, _mm_sub_pd( VectorKernelsLoad2(pA + i),
+                                                               VectorKernelsLoad2(pB + i) ) ) );
+      Acc1= _mm_add_pd( Acc1, _mm_andnot_pd( Sign, _mm_sub_pd( VectorKernelsLoad2(pA + i + 2),
+                                                               VectorKernelsLoad2(pB + i + 2) ) ) );
+   }
+
+   Acc0= _mm_add_pd(Acc0, Acc1);
+   D= _mm_cvtsd_f64( _mm_add_sd( Acc0, _mm_unpackhi_pd(Acc0, Acc0) ) );
+
+   for (; i < aSize; i++)
+   {
+      D+= std::abs( static_cast<RealType>(pA[i]) - static_cast<RealType>(pB[i]) );
+   }
+
+   return D;
+}  // VectorKernelsAbsDistance
+
+inline void
+VectorKernelsStore2(double* p, __m128d aV)         { _mm_storeu_pd(p, aV); }
+
+inline void
+VectorKernelsStore2(float* p, __m128d aV)
+{
+   _mm_storel_epi64( reinterpret_cast<__m128i*>(p), _mm_castps_si128( _mm_cvtpd_ps(aV) ) );
+}  // VectorKernelsStore2
+
+template <typename TypeM, typename TypeS>
+inline void
+VectorKernelsMeanStep(
+                  TypeM*         pMean,
+                  const TypeS*   pSample,
+                  VectorKernels::SizeType aSize,
+                  RealType       aWeight)
+{
+   // Variabili.
+   __m128d              W= _mm_set1_pd(aWeight);
+   __m128d              M;
+   VectorKernels::SizeType i= 0;
+
+   for (; i + 2 <= aSize; i+= 2)
+   {
+      M= VectorKernelsLoad2(pMean + i);
+      M= _mm_add_pd( M, _mm_mul_pd( _mm_sub_pd(VectorKernelsLoad2(pSample + i), M), W ) );
+      VectorKernelsStore2(pMean + i, M);
+   }
+
+   for (; i < aSize; i++)
+   {
+      pMean[i]= static_cast<TypeM>(
+                   pMean[i] + ( static_cast<RealType>(pSample[i]) - pMean[i] ) * aWeight );
+   }
+}  // VectorKernelsMeanStep
+
+#endif
+
+// Istanze SIMD per le combinazioni di double e float.
+#define SPARE_VECTOR_KERNELS_SPECIALIZE(TypeA, TypeB)                                     \
+template <>                                                                               \
+inline RealType                                                                           \
+VectorKernels::SquaredDistance(const TypeA* pA, const TypeB* pB, SizeType aSize)          \
+{                                                                                         \
+   return VectorKernelsSquaredDistance(pA, pB, aSize);                                    \
+}                                                                                         \
+                                                                                          \
+template <>                                                                               \
+inline RealType                                                                           \
+VectorKernels::WeightedSquaredDistance(const TypeA* pA, const TypeB* pB,                  \
+                                       const RealType* pW, SizeType aSize)                \
+{                                                                                         \
+   return VectorKernelsWeightedSquaredDistance(pA, pB, pW, aSize);                        \
+}                                                                                         \
+                                                                                          \
+template <>                                                                               \
+inline RealType                                                                           \
+VectorKernels::AbsDistance(const TypeA* pA, const TypeB* pB, SizeType aSize)              \
+{                                                                                         \
+   return VectorKernelsAbsDistance(pA, pB, aSize);                                        \
+}                                                                                         \
+                                                                                          \
+template <>                                                                               \
+inline void                                                                               \
+VectorKernels::MeanStep(TypeA* pMean, const TypeB* pSample, SizeType aSize,               \
+                        RealType aWeight)                                                 \
+{                                                                                         \
+   VectorKernelsMeanStep(pMean, pSample, aSize, aWeight);                                 \
+}
+
+SPARE_VECTOR_KERNELS_SPECIALIZE(double, double)
+SPARE_VECTOR_KERNELS_SPECIALIZE(double, float)
+SPARE_VECTOR_KERNELS_SPECIALIZE(float, double)
+SPARE_VECTOR_KERNELS_SPECIALIZE(float, float)
+
+#undef SPARE_VECTOR_KERNELS_SPECIALIZE
+
+#endif
+
+inline void
+VectorKernels::SquaredDistanceColumns(
+                  const RealType*   pA,
+                  SizeType          aStrideA,
+                  const RealType*   pB,
+                  SizeType          aStrideB,
+                  SizeType          aDim,
+                  RealType*         pOut,
+                  SizeType          aSize)
+{
+   // Variabili.
+   SizeType             j= 0;
+
+   // Una colonna per elemento, con i suoi accumulatori.
+#if defined(__AVX__)
+   for (; j + 4 <= aSize; j+= 4)
+   {
+      _mm256_storeu_pd( pOut + j,
+                        VectorKernelsSquaredDistanceColumns(pA + j, aStrideA, pB + j, aStrideB, aDim) );
+   }
+#elif defined(__SSE2__)
+   for (; j + 2 <= aSize; j+= 2)
+   {
+      _mm_storeu_pd( pOut + j,
+                     VectorKernelsSquaredDistanceColumns(pA + j, aStrideA, pB + j, aStrideB, aDim) );
+   }
+#endif
+
+   for (; j < aSize; j++)
+   {
+      pOut[j]= VectorKernelsSquaredDistanceColumn(pA + j, aStrideA, pB + j, aStrideB, aDim);
+   }
+}  // SquaredDistanceColumns
+
+}  // namespace spare
+
+#endif  // _VectorKernels_h_
@@ -29,10 +29,18 @@ HEADERS += \
     Clustering/KmeansInit/Dbcrimes2Init.hpp \
     Clustering/KmeansInit/DbcrimesInit.hpp \
     Clustering/KmeansInit/FirstK.hpp \
+    Clustering/KmeansInit/KmeansParallel.hpp \
+    Clustering/KmeansInit/KmeansPlusPlus.hpp \
     Clustering/KmeansInit/ProbabilisticDiss.hpp \
     Clustering/KmeansInit/RandomK.hpp \
     Clustering/KmeansInit/SamplingSeeding.hpp \
+    Clustering/KmeansRestarts.hpp \
     Clustering/MTBsas.hpp \
+    Clustering/MiniBatchKmeans.hpp \
+    Clustering/RepIndex/DtwScan.hpp \
+    Clustering/RepIndex/LinearScan.hpp \
+    Clustering/RepIndex/PivotTable.hpp \
+    Dissimilarity/BoundedDiss.hpp \
     Dissimilarity/CBMF.hpp \
     Dissimilarity/Constant.hpp \
     Dissimilarity/Converter/Complement.hpp \
@@ -46,18 +54,24 @@ HEADERS += \
     Dissimilarity/Divergence/Renyi.hpp \
     Dissimilarity/Divergence/SymLutwak.hpp \
     Dissimilarity/Dtw.hpp \
+    Dissimilarity/DtwCascade.hpp \
+    Dissimilarity/DtwNodeTraits.hpp \
     Dissimilarity/Euclidean.hpp \
     Dissimilarity/Fuzzy/MaxIntersection.hpp \
     Dissimilarity/Fuzzy/NormDivergence.hpp \
     Dissimilarity/Fuzzy/Subsethood.hpp \
     Dissimilarity/Hamming.hpp \
     Dissimilarity/Levenshtein.hpp \
+    Dissimilarity/MetricTraits.hpp \
     Dissimilarity/Minkowski.hpp \
     Dissimilarity/ModuleDistance.hpp \
+    Dissimilarity/PairwiseDistances.hpp \
+    Dissimilarity/SquaredDiss.hpp \
     Environment/DiscreteCode.hpp \
     Evaluator/Gaussian.hpp \
     Evaluator/MultiGaussian.hpp \
     Evaluator/PiecewiseLinear.hpp \
+    Executor.hpp \
     Graph/Dissimilarity/4WBMF.hpp \
     Graph/Dissimilarity/BMF.hpp \
     Graph/Dissimilarity/HGED.hpp \
@@ -133,13 +147,16 @@ HEADERS += \
     Representation/SymbolicHistograms.hpp \
     Representation/SymbolicHistograms_original.hpp \
     Representative/Centroid.hpp \
+    Representative/CholeskyMahalanobis.hpp \
     Representative/FuzzyHyperbox.hpp \
+    Representative/FuzzyHyperboxSet.hpp \
     Representative/FuzzyMinSod.hpp \
     Representative/Mahalanobis.hpp \
     Representative/MinSod.hpp \
     Representative/PFuzzyMinSod.hpp \
     Representative/RFFuzzyMinSod.hpp \
     Representative/Rlse.hpp \
+    Representative/SodRowBlock.hpp \
     Sequence/AE_RealN.hpp \
     Sequence/AE_String.hpp \
     Sequence/Parsers/DirectParser.hpp \
@@ -182,6 +199,7 @@ HEADERS += \
     Utils/SeqReader.hpp \
     Utils/arctools/MinMaxNetwork.h \
     Utils/arctools/MinMaxTraining.h \
+    VectorKernels.hpp \
 
 # Default rules for deployment.
 unix {